@@ -0,0 +1,257 @@
+/******************************************************************************
+ * 
+ * Pre-rasterized fonts for values, time and units.
+ * 
+ * Generated by Tools/FontGen, do not edit. See Font.h for the format.
+ * 
+******************************************************************************/
+
+#include "BigFont.h"
+
+/* textsize 2 */
+static const uint8_t RUNS_2[] = {
+  192,   0,   4,   8,   4,   8,   4,   4,   2,   2,   4,   3,   3,   8,   3,   8,
+    3,   8,   3,   8,   3,   8,   3,   8,   3,   8,   3,   3,   4,   2,   2,   4,
+    4,   8,   4,   8,   4,  26,  72,  10,   2,  10,  98, 122,   4,   8,   4,   8,
+    4,   8,   4,  30,   2,   6,   5,   8,   3,   3,   4,   3,   2,   2,   5,   3,
+    2,   2,   4,   4,   2,   2,   3,   5,   2,   2,   2,   6,   2,   6,   2,   2,
+    2,   5,   3,   2,   2,   4,   4,   2,   2,   3,   5,   2,   2,   3,   4,   3,
+    3,   8,   5,   6,  28,   4,   2,   9,   3,   8,   4,   8,   4,   9,   3,  10,
+    2,  10,   2,  10,   2,  10,   2,  10,   2,  10,   2,   9,   4,   7,   6,   6,
+    6,  28,   2,   6,   5,   8,   3,   3,   4,   3,   2,   2,   6,   2,  10,   2,
+    9,   3,   4,   7,   4,   7,   4,   3,   9,   2,  10,   2,  10,   3,   9,  10,
+    2,  10,  26,   0,  10,   2,  10,   9,   3,   9,   3,   8,   3,   8,   3,   8,
+    4,   8,   5,  10,   3,  10,   2,   2,   2,   6,   2,   2,   3,   4,   3,   3,
+    8,   5,   6,  28,   6,   2,   9,   3,   8,   4,   7,   5,   6,   6,   5,   3,
+    2,   2,   4,   3,   3,   2,   4,   3,   2,   4,   3,  10,   2,  10,   7,   4,
+    9,   2,  10,   2,  10,   2,  28,   0,  10,   2,  10,   2,   3,   9,   3,   9,
+    8,   4,   9,  10,   3,  10,   2,  10,   2,  10,   2,   2,   2,   6,   2,   2,
+    3,   4,   3,   3,   8,   5,   6,  28,   4,   6,   5,   7,   4,   3,   8,   3,
+    8,   3,   9,   3,   9,   8,   4,   9,   3,   3,   4,   3,   2,   2,   6,   2,
+    2,   2,   6,   2,   2,   3,   4,   3,   3,   8,   5,   6,  28,   0,  10,   2,
+   10,   9,   3,  10,   2,  10,   2,   9,   3,   8,   3,   8,   3,   8,   3,   8,
+    3,   8,   3,   8,   3,   8,   3,   9,   2,  34,   2,   6,   5,   8,   3,   3,
+    4,   3,   2,   2,   6,   2,   2,   2,   6,   2,   2,   3,   4,   3,   3,   8,
+    4,   8,   3,   3,   4,   3,   2,   2,   6,   2,   2,   2,   6,   2,   2,   3,
+    4,   3,   3,   8,   5,   6,  28,   2,   6,   5,   8,   3,   3,   4,   3,   2,
+    2,   6,   2,   2,   2,   6,   2,   2,   3,   4,   3,   3,   9,   4,   8,   9,
+    3,   9,   3,   8,   3,   8,   3,   4,   7,   5,   6,  30,  26,   4,   8,   4,
+    8,   4,   8,   4,  32,   4,   8,   4,   8,   4,   8,   4,  54,   2,   6,   5,
+    8,   3,   3,   4,   3,   2,   2,   6,   2,   2,   2,  10,   2,  10,   2,  10,
+    2,  10,   2,  10,   2,  10,   2,   6,   2,   2,   3,   4,   3,   3,   8,   5,
+    6,  28,  48,   4,   2,   2,   4,   9,   3,  10,   2,   2,   2,   2,   2,   2,
+    2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   6,   2,
+    2,   2,   6,   2,   2,   2,   6,   2,   2,   2,   6,   2,  26,  48,   8,   4,
+    9,   3,   3,   4,   3,   2,   3,   4,   3,   2,   9,   3,   8,   4,   3,   9,
+    2,  10,   2,  10,   2,  34,   4,   4,   7,   6,   5,   3,   2,   3,   4,   2,
+    4,   2,   4,   2,   4,   2,   4,   3,   2,   3,   5,   6,   7,   4, 100,
+};
+
+static const Glyph GLYPHS_2[] = {
+  { 32,     0,    1},
+  { 37,     1,   37},
+  { 45,    38,    5},
+  { 46,    43,    9},
+  { 48,    52,   49},
+  { 49,   101,   29},
+  { 50,   130,   33},
+  { 51,   163,   33},
+  { 52,   196,   35},
+  { 53,   231,   33},
+  { 54,   264,   37},
+  { 55,   301,   29},
+  { 56,   330,   45},
+  { 57,   375,   37},
+  { 58,   412,   17},
+  { 67,   429,   37},
+  {109,   466,   43},
+  {112,   509,   25},
+  {248,   534,   25},
+};
+
+const Font BIG_FONT_2 = {
+  2, 12, 16, 19, GLYPHS_2, RUNS_2
+};
+
+/* textsize 3 */
+static const uint8_t RUNS_3[] = {
+  255,   0, 177,   0,   6,  12,   6,  12,   6,  12,   6,   6,   3,   3,   6,   5,
+    4,   3,   6,   4,   5,  12,   5,  12,   5,  12,   5,  12,   5,  12,   5,  12,
+    5,  12,   5,  12,   5,  12,   5,  12,   5,   4,   6,   3,   4,   5,   6,   3,
+    3,   6,   6,  12,   6,  12,   6,  12,   6,  57, 162,  15,   3,  15,   3,  15,
+  219, 255,   0,  18,   6,  12,   6,  12,   6,  12,   6,  12,   6,  12,   6,  63,
+    3,   9,   8,  11,   6,  13,   4,   5,   5,   5,   3,   4,   7,   4,   3,   3,
+    7,   5,   3,   3,   6,   6,   3,   3,   5,   7,   3,   3,   4,   8,   3,   3,
+    3,   9,   3,   4,   1,   5,   1,   4,   3,   9,   3,   3,   3,   8,   4,   3,
+    3,   7,   5,   3,   3,   6,   6,   3,   3,   5,   7,   3,   3,   4,   7,   4,
+    3,   5,   5,   5,   4,  13,   6,  11,   8,   9,  60,   6,   3,  14,   4,  13,
+    5,  12,   6,  12,   6,  12,   6,  13,   5,  14,   4,  15,   3,  15,   3,  15,
+    3,  15,   3,  15,   3,  15,   3,  15,   3,  15,   3,  14,   5,  12,   7,  10,
+    9,   9,   9,   9,   9,  60,   3,   9,   8,  11,   6,  13,   4,   5,   5,   5,
+    3,   4,   7,   4,   3,   3,   9,   3,  15,   3,  14,   4,  13,   5,   6,  11,
+    6,  11,   6,  11,   6,   5,  13,   4,  14,   3,  15,   3,  15,   4,  14,   5,
+   13,  15,   3,  15,   3,  15,  57,   0,  15,   3,  15,   3,  15,  13,   5,  14,
+    4,  13,   5,  12,   5,  12,   5,  12,   5,  12,   6,  12,   7,  11,   8,  14,
+    5,  14,   4,  15,   3,   3,   3,   9,   3,   3,   4,   7,   4,   3,   5,   5,
+    5,   4,  13,   6,  11,   8,   9,  60,   9,   3,  14,   4,  13,   5,  12,   6,
+   11,   7,  10,   8,   9,   9,   8,   5,   1,   4,   7,   5,   3,   3,   6,   5,
+    4,   3,   6,   4,   4,   5,   5,   5,   2,   7,   4,  15,   3,  15,   3,  15,
+   10,   7,  12,   5,  14,   3,  15,   3,  15,   3,  15,   3,  60,   0,  15,   3,
+   15,   3,  15,   3,   5,  13,   4,  14,   5,  13,  12,   6,  13,   5,  14,  14,
+    5,  14,   4,  15,   3,  15,   3,  15,   3,  15,   3,   3,   3,   9,   3,   3,
+    4,   7,   4,   3,   5,   5,   5,   4,  13,   6,  11,   8,   9,  60,   6,   9,
+    8,  10,   7,  11,   6,   5,  12,   5,  12,   5,  12,   5,  13,   4,  14,   5,
+   13,  12,   6,  13,   5,  14,   4,   5,   5,   5,   3,   4,   7,   4,   3,   3,
+    9,   3,   3,   3,   9,   3,   3,   4,   7,   4,   3,   5,   5,   5,   4,  13,
+    6,  11,   8,   9,  60,   0,  15,   3,  15,   3,  15,  13,   5,  14,   4,  15,
+    3,  15,   3,  14,   4,  13,   5,  12,   5,  12,   5,  12,   5,  12,   5,  12,
+    5,  12,   5,  12,   5,  12,   5,  12,   5,  12,   5,  13,   4,  14,   3,  69,
+    3,   9,   8,  11,   6,  13,   4,   5,   5,   5,   3,   4,   7,   4,   3,   3,
+    9,   3,   3,   3,   9,   3,   3,   4,   7,   4,   3,   5,   5,   5,   4,  13,
+    6,  11,   6,  13,   4,   5,   5,   5,   3,   4,   7,   4,   3,   3,   9,   3,
+    3,   3,   9,   3,   3,   4,   7,   4,   3,   5,   5,   5,   4,  13,   6,  11,
+    8,   9,  60,   3,   9,   8,  11,   6,  13,   4,   5,   5,   5,   3,   4,   7,
+    4,   3,   3,   9,   3,   3,   3,   9,   3,   3,   4,   7,   4,   3,   5,   5,
+    5,   4,  14,   5,  13,   6,  12,  13,   5,  14,   4,  13,   5,  12,   5,  12,
+    5,  12,   5,   6,  11,   7,  10,   8,   9,  63,  57,   6,  12,   6,  12,   6,
+   12,   6,  12,   6,  12,   6,  66,   6,  12,   6,  12,   6,  12,   6,  12,   6,
+   12,   6, 117,   3,   9,   8,  11,   6,  13,   4,   5,   5,   5,   3,   4,   7,
+    4,   3,   3,   9,   3,   3,   3,  15,   3,  15,   3,  15,   3,  15,   3,  15,
+    3,  15,   3,  15,   3,  15,   3,  15,   3,   9,   3,   3,   4,   7,   4,   3,
+    5,   5,   5,   4,  13,   6,  11,   8,   9,  60, 108,   6,   3,   3,   6,   7,
+    1,   5,   5,  14,   4,  15,   3,   4,   1,   5,   1,   4,   3,   3,   3,   3,
+    3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,
+    3,   3,   3,   3,   3,   3,   9,   3,   3,   3,   9,   3,   3,   3,   9,   3,
+    3,   3,   9,   3,   3,   3,   9,   3,   3,   3,   9,   3,  57, 108,  12,   6,
+   13,   5,  14,   4,   5,   5,   5,   3,   4,   7,   4,   3,   5,   5,   5,   3,
+   14,   4,  13,   5,  12,   6,   5,  13,   4,  14,   3,  15,   3,  15,   3,  15,
+    3,  69,   6,   6,  11,   8,   9,  10,   7,   5,   2,   5,   6,   4,   4,   4,
+    6,   3,   6,   3,   6,   3,   6,   3,   6,   4,   4,   4,   6,   5,   2,   5,
+    7,  10,   9,   8,  11,   6, 222,
+};
+
+static const Glyph GLYPHS_3[] = {
+  { 32,     0,    3},
+  { 37,     3,   55},
+  { 45,    58,    7},
+  { 46,    65,   15},
+  { 48,    80,   75},
+  { 49,   155,   43},
+  { 50,   198,   49},
+  { 51,   247,   49},
+  { 52,   296,   53},
+  { 53,   349,   49},
+  { 54,   398,   55},
+  { 55,   453,   43},
+  { 56,   496,   67},
+  { 57,   563,   55},
+  { 58,   618,   25},
+  { 67,   643,   55},
+  {109,   698,   67},
+  {112,   765,   37},
+  {248,   802,   37},
+};
+
+const Font BIG_FONT_3 = {
+  3, 18, 24, 19, GLYPHS_3, RUNS_3
+};
+
+/* textsize 4 */
+static const uint8_t RUNS_4[] = {
+  255,   0, 255,   0, 255,   0,   3,   0,   8,  16,   8,  16,   8,  16,   8,  16,
+    8,   8,   4,   4,   8,   7,   5,   4,   8,   6,   6,   4,   8,   5,   7,  16,
+    7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,
+    7,  16,   7,  16,   7,  16,   7,  16,   7,   5,   8,   4,   6,   6,   8,   4,
+    5,   7,   8,   4,   4,   8,   8,  16,   8,  16,   8,  16,   8,  16,   8, 100,
+  255,   0,  33,  20,   4,  20,   4,  20,   4,  20, 255,   0, 133, 255,   0, 229,
+    8,  16,   8,  16,   8,  16,   8,  16,   8,  16,   8,  16,   8,  16,   8, 108,
+    4,  12,  11,  14,   9,  16,   7,  18,   5,   7,   6,   7,   4,   6,   8,   6,
+    4,   5,   9,   6,   4,   4,   9,   7,   4,   4,   8,   8,   4,   4,   7,   9,
+    4,   4,   6,  10,   4,   4,   5,  11,   4,   4,   4,  12,   4,   5,   2,  13,
+    4,  13,   2,   5,   4,  12,   4,   4,   4,  11,   5,   4,   4,  10,   6,   4,
+    4,   9,   7,   4,   4,   8,   8,   4,   4,   7,   9,   4,   4,   6,   9,   5,
+    4,   6,   8,   6,   4,   7,   6,   7,   5,  18,   7,  16,   9,  14,  11,  12,
+  104,   8,   4,  19,   5,  18,   6,  17,   7,  16,   8,  16,   8,  16,   8,  16,
+    8,  17,   7,  18,   6,  19,   5,  20,   4,  20,   4,  20,   4,  20,   4,  20,
+    4,  20,   4,  20,   4,  20,   4,  20,   4,  20,   4,  19,   6,  17,   8,  15,
+   10,  13,  12,  12,  12,  12,  12,  12,  12, 104,   4,  12,  11,  14,   9,  16,
+    7,  18,   5,   7,   6,   7,   4,   6,   8,   6,   4,   5,  10,   5,   4,   4,
+   12,   4,  20,   4,  19,   5,  18,   6,  17,   7,   8,  15,   8,  15,   8,  15,
+    8,  15,   8,   7,  17,   6,  18,   5,  19,   4,  20,   4,  20,   5,  19,   6,
+   18,   7,  17,  20,   4,  20,   4,  20,   4,  20, 100,   0,  20,   4,  20,   4,
+   20,   4,  20,  17,   7,  18,   6,  18,   6,  17,   7,  16,   7,  16,   7,  16,
+    7,  16,   7,  16,   8,  16,   9,  15,  10,  14,  11,  18,   7,  18,   6,  19,
+    5,  20,   4,   4,   4,  12,   4,   4,   5,  10,   5,   4,   6,   8,   6,   4,
+    7,   6,   7,   5,  18,   7,  16,   9,  14,  11,  12, 104,  12,   4,  19,   5,
+   18,   6,  17,   7,  16,   8,  15,   9,  14,  10,  13,  11,  12,  12,  11,  13,
+   10,   7,   2,   5,   9,   7,   4,   4,   8,   7,   5,   4,   8,   6,   5,   6,
+    7,   6,   4,   8,   6,   7,   2,  10,   5,  20,   4,  20,   4,  20,   4,  20,
+   13,  10,  15,   8,  17,   6,  19,   4,  20,   4,  20,   4,  20,   4,  20,   4,
+  104,   0,  20,   4,  20,   4,  20,   4,  20,   4,   7,  17,   6,  18,   6,  18,
+    7,  17,  16,   8,  17,   7,  18,   6,  19,  18,   7,  18,   6,  19,   5,  20,
+    4,  20,   4,  20,   4,  20,   4,  20,   4,   4,   4,  12,   4,   4,   5,  10,
+    5,   4,   6,   8,   6,   4,   7,   6,   7,   5,  18,   7,  16,   9,  14,  11,
+   12, 104,   8,  12,  11,  13,  10,  14,   9,  15,   8,   7,  16,   7,  16,   7,
+   16,   7,  16,   7,  17,   6,  18,   6,  18,   7,  17,  16,   8,  17,   7,  18,
+    6,  19,   5,   7,   6,   7,   4,   6,   8,   6,   4,   5,  10,   5,   4,   4,
+   12,   4,   4,   4,  12,   4,   4,   5,  10,   5,   4,   6,   8,   6,   4,   7,
+    6,   7,   5,  18,   7,  16,   9,  14,  11,  12, 104,   0,  20,   4,  20,   4,
+   20,   4,  20,  17,   7,  18,   6,  19,   5,  20,   4,  20,   4,  19,   5,  18,
+    6,  17,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,
+    7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  16,   7,  17,   6,  18,
+    5,  19,   4, 116,   4,  12,  11,  14,   9,  16,   7,  18,   5,   7,   6,   7,
+    4,   6,   8,   6,   4,   5,  10,   5,   4,   4,  12,   4,   4,   4,  12,   4,
+    4,   5,  10,   5,   4,   6,   8,   6,   4,   7,   6,   7,   5,  18,   7,  16,
+    8,  16,   7,  18,   5,   7,   6,   7,   4,   6,   8,   6,   4,   5,  10,   5,
+    4,   4,  12,   4,   4,   4,  12,   4,   4,   5,  10,   5,   4,   6,   8,   6,
+    4,   7,   6,   7,   5,  18,   7,  16,   9,  14,  11,  12, 104,   4,  12,  11,
+   14,   9,  16,   7,  18,   5,   7,   6,   7,   4,   6,   8,   6,   4,   5,  10,
+    5,   4,   4,  12,   4,   4,   4,  12,   4,   4,   5,  10,   5,   4,   6,   8,
+    6,   4,   7,   6,   7,   5,  19,   6,  18,   7,  17,   8,  16,  17,   7,  18,
+    6,  18,   6,  17,   7,  16,   7,  16,   7,  16,   7,  16,   7,   8,  15,   9,
+   14,  10,  13,  11,  12, 108, 100,   8,  16,   8,  16,   8,  16,   8,  16,   8,
+   16,   8,  16,   8,  16,   8, 112,   8,  16,   8,  16,   8,  16,   8,  16,   8,
+   16,   8,  16,   8,  16,   8, 204,   4,  12,  11,  14,   9,  16,   7,  18,   5,
+    7,   6,   7,   4,   6,   8,   6,   4,   5,  10,   5,   4,   4,  12,   4,   4,
+    4,  20,   4,  20,   4,  20,   4,  20,   4,  20,   4,  20,   4,  20,   4,  20,
+    4,  20,   4,  20,   4,  20,   4,  20,   4,  12,   4,   4,   5,  10,   5,   4,
+    6,   8,   6,   4,   7,   6,   7,   5,  18,   7,  16,   9,  14,  11,  12, 104,
+  192,   8,   4,   4,   8,   9,   2,   6,   7,  18,   6,  19,   5,  20,   4,  20,
+    4,   5,   2,   6,   2,   5,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,
+    4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,
+    4,   4,   4,   4,   4,   4,  12,   4,   4,   4,  12,   4,   4,   4,  12,   4,
+    4,   4,  12,   4,   4,   4,  12,   4,   4,   4,  12,   4,   4,   4,  12,   4,
+    4,   4,  12,   4, 100, 192,  16,   8,  17,   7,  18,   6,  19,   5,   7,   6,
+    7,   4,   6,   8,   6,   4,   6,   8,   6,   4,   7,   6,   7,   4,  19,   5,
+   18,   6,  17,   7,  16,   8,   7,  17,   6,  18,   5,  19,   4,  20,   4,  20,
+    4,  20,   4,  20,   4, 116,   8,   8,  15,  10,  13,  12,  11,  14,   9,   7,
+    2,   7,   8,   6,   4,   6,   8,   5,   6,   5,   8,   4,   8,   4,   8,   4,
+    8,   4,   8,   5,   6,   5,   8,   6,   4,   6,   8,   7,   2,   7,   9,  14,
+   11,  12,  13,  10,  15,   8, 255,   0, 137,
+};
+
+static const Glyph GLYPHS_4[] = {
+  { 32,     0,    7},
+  { 37,     7,   73},
+  { 45,    80,   13},
+  { 46,    93,   19},
+  { 48,   112,   97},
+  { 49,   209,   57},
+  { 50,   266,   65},
+  { 51,   331,   65},
+  { 52,   396,   69},
+  { 53,   465,   65},
+  { 54,   530,   73},
+  { 55,   603,   57},
+  { 56,   660,   89},
+  { 57,   749,   73},
+  { 58,   822,   33},
+  { 67,   855,   73},
+  {109,   928,   85},
+  {112,  1013,   49},
+  {248,  1062,   51},
+};
+
+const Font BIG_FONT_4 = {
+  4, 24, 32, 19, GLYPHS_4, RUNS_4
+};
@@ -0,0 +1,21 @@
+/******************************************************************************
+ * 
+ * Pre-rasterized fonts for values, time and units.
+ * 
+ * Generated by Tools/FontGen, do not edit. See Font.h for the format.
+ * 
+******************************************************************************/
+
+#ifndef _BIG_FONT__H_
+#define _BIG_FONT__H_
+
+#include "Font.h"
+
+// font replacing textsize 2, 559 bytes of runs
+extern const Font BIG_FONT_2;
+// font replacing textsize 3, 839 bytes of runs
+extern const Font BIG_FONT_3;
+// font replacing textsize 4, 1113 bytes of runs
+extern const Font BIG_FONT_4;
+
+#endif  // _BIG_FONT__H_
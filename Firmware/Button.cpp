@@ -0,0 +1,154 @@
+/******************************************************************************
+ * 
+ * Pushbutton read by an interrupt and decoded into gestures.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Button.h"
+
+Button* volatile Button::_buttons[BUTTON_MAX];
+
+// ____________________________________________________________________________
+Button::Button()
+    : _state(IDLE), _since(0), _tail(0), _pin(0), _head(0), _pressed(false),
+      _last(0), _levels(0) {
+}
+
+// ____________________________________________________________________________
+Button::~Button() {
+  for (uint8_t i = 0; i < BUTTON_MAX; i++) {
+    if (_buttons[i] == this) _buttons[i] = NULL;
+  }
+}
+
+// ____________________________________________________________________________
+bool Button::begin(uint8_t pin) {
+  _pin = pin;
+  pinMode(pin, INPUT_PULLUP);
+  _pressed = !digitalRead(pin);
+  uint8_t i = 0;
+  while (i < BUTTON_MAX && _buttons[i] && _buttons[i] != this) i++;
+  if (i == BUTTON_MAX) return false;
+  _buttons[i] = this;
+  attachInterrupt(digitalPinToInterrupt(pin), onChange, CHANGE);
+  return true;
+}
+
+// ____________________________________________________________________________
+Gesture Button::update(void) {
+  Gesture gesture = GESTURE_NONE;
+  // edges taken by the interrupt, a gesture is completed by the last one.
+  // If the ring overflowed the oldest edges are lost
+  if ((uint8_t) (_head - _tail) > BUTTON_EDGES) _tail = _head - BUTTON_EDGES;
+  while (_tail != _head) {
+    uint8_t i = _tail % BUTTON_EDGES;
+    Gesture g = edge(_levels & (1 << i), _times[i]);
+    if (g != GESTURE_NONE) gesture = g;
+    _tail++;
+  }
+  if (_state == IDLE) return gesture;
+
+  uint32_t now = millis();
+  bool missed = false;
+  noInterrupts();
+  if (_tail == _head && now - _last >= BUTTON_DEBOUNCE
+      && _pressed != !digitalRead(_pin)) {
+    // the last edge of a bounce was ignored, take the level of the pin
+    _pressed = !_pressed;
+    _last = now;
+    missed = true;
+  }
+  interrupts();
+  if (missed) {
+    Gesture g = edge(_pressed, now);
+    if (g != GESTURE_NONE) gesture = g;
+  }
+
+  // timeouts of the states
+  if (_state == PRESSED && now - _since >= BUTTON_LONG) {
+    _state = HELD;
+    gesture = GESTURE_LONG;
+  } else if (_state == RELEASED && now - _since >= BUTTON_DOUBLE) {
+    _state = IDLE;
+    gesture = GESTURE_SHORT;
+  }
+  return gesture;
+}
+
+// ____________________________________________________________________________
+Gesture Button::edge(bool pressed, uint32_t time) {
+  Gesture gesture = GESTURE_NONE;
+  State before = _state;
+  switch (_state) {
+    case IDLE:
+      if (pressed) _state = PRESSED;
+      break;
+    case PRESSED:
+      // a release after BUTTON_LONG is decoded late, it is still long
+      if (!pressed) {
+        if (time - _since >= BUTTON_LONG) {
+          _state = IDLE;
+          gesture = GESTURE_LONG;
+        } else {
+          _state = RELEASED;
+        }
+      }
+      break;
+    case RELEASED:
+      if (pressed) {
+        if (time - _since < BUTTON_DOUBLE) {
+          _state = SECOND;
+        } else {
+          // the first press timed out before this one was decoded
+          _state = PRESSED;
+          gesture = GESTURE_SHORT;
+        }
+      }
+      break;
+    case SECOND:
+      if (!pressed) {
+        _state = IDLE;
+        gesture = GESTURE_DOUBLE;
+      }
+      break;
+    case HELD:
+      if (!pressed) _state = IDLE;
+      break;
+  }
+  if (_state != before) _since = time;
+  return gesture;
+}
+
+// ____________________________________________________________________________
+void Button::onChange(void) {
+  // the pin that changed is not known, each button checks its own
+  for (uint8_t i = 0; i < BUTTON_MAX; i++) {
+    if (_buttons[i]) _buttons[i]->take();
+  }
+}
+
+// ____________________________________________________________________________
+void Button::take(void) {
+  uint32_t now = millis();
+  bool pressed = !digitalRead(_pin);
+  // take the first edge to a new level, ignore the bounces after it
+  if (pressed == _pressed || now - _last < BUTTON_DEBOUNCE) return;
+  _pressed = pressed;
+  _last = now;
+  uint8_t i = _head % BUTTON_EDGES;
+  _times[i] = now;
+  if (pressed) {
+    _levels |= 1 << i;
+  } else {
+    _levels &= ~(1 << i);
+  }
+  _head++;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * 
+ * Pushbutton read by an interrupt and decoded into gestures.
+ * 
+ * The button connects its pin to GND, the pin is pulled up. Every change of
+ * the pin raises an interrupt, which takes the time and level of the edge
+ * into a small ring. Contacts bounce for a few ms, so the first edge to a
+ * new level is taken and further edges are ignored for BUTTON_DEBOUNCE ms.
+ * If the last edge of a bounce was ignored, update() takes the level of the
+ * pin once it is stable, which is only read while a gesture is decoded.
+ * 
+ * update() decodes the edges into gestures:
+ *  GESTURE_SHORT   press and release, no second press within BUTTON_DOUBLE
+ *  GESTURE_DOUBLE  two presses, the second within BUTTON_DOUBLE ms after
+ *                  the release of the first
+ *  GESTURE_LONG    press held for BUTTON_LONG ms, reported while held
+ * A short press is thus reported BUTTON_DOUBLE ms after its release.
+ * 
+ * Each button keeps its edges in its own members. As an interrupt has no
+ * object, begin() enters the button into a table of up to BUTTON_MAX
+ * buttons, and the interrupt of any of their pins lets each of them check
+ * its own pin. Several monitors in one program thus each have their own
+ * button, also on the same pin.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _BUTTON__H_
+#define _BUTTON__H_
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define BUTTON_EDGES    8       ///< edges kept until update(), power of 2
+#define BUTTON_MAX      8       ///< buttons taking interrupts at a time
+
+/* Gestures of the button */
+enum Gesture : uint8_t {
+  GESTURE_NONE,       ///< nothing happened
+  GESTURE_SHORT,      ///< single short press
+  GESTURE_DOUBLE,     ///< two short presses
+  GESTURE_LONG        ///< press held
+};
+
+/* Button on an interrupt pin, decoded into gestures */
+class Button {
+ public:
+  Button();
+  // leave the table of the interrupt
+  ~Button();
+
+  // set up the pin and its interrupt, false if BUTTON_MAX buttons are in
+  // use already
+  bool begin(uint8_t pin);
+  // decode the edges since the last call, return the gesture completed by
+  // them, GESTURE_NONE if there is none. Call it every loop
+  Gesture update(void);
+
+ private:
+  // states of the decoder
+  enum State : uint8_t {
+    IDLE,             ///< released, waiting for a press
+    PRESSED,          ///< first press held
+    RELEASED,         ///< first press released, waiting for a second one
+    SECOND,           ///< second press held
+    HELD              ///< long press reported, waiting for its release
+  };
+
+  // run the decoder with an edge to given level at given millis()
+  Gesture edge(bool pressed, uint32_t time);
+  // take an edge of the pin, called by the interrupt
+  void take(void);
+  // interrupt of the pins, shared by all buttons
+  static void onChange(void);
+
+  State _state;             ///< state of the decoder
+  uint32_t _since;          ///< millis() of the edge that entered the state
+  uint8_t _tail;            ///< next edge to decode
+  uint8_t _pin;             ///< pin of the button
+
+  volatile uint8_t _head;       ///< next edge to write
+  volatile bool _pressed;       ///< level of the last edge taken
+  volatile uint32_t _last;      ///< millis() of that edge
+  volatile uint32_t _times[BUTTON_EDGES];   ///< millis() of the edges
+  volatile uint8_t _levels;     ///< bit i set if edge i is a press
+
+  static Button* volatile _buttons[BUTTON_MAX]; ///< buttons begun, or NULL
+};
+
+#endif  // _BUTTON__H_
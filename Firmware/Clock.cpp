@@ -0,0 +1,149 @@
+/******************************************************************************
+ * 
+ * Software clock with millisecond resolution, disciplined by the RTC.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Clock.h"
+
+volatile uint32_t Clock::_edges = 0;
+volatile uint32_t Clock::_edgeMillis = 0;
+
+// ____________________________________________________________________________
+Clock::Clock()
+    : _rtc(NULL), _sqwPin(-1), _valid(false), _missed(false),
+      _baseTime(0), _baseMillis(0), _refTime(0), _refMillis(0),
+      _lastSync(0), _lastEdges(0), _drift(0), _offset(0), _maxOffset(0),
+      _syncs(0), _steps(0) {
+}
+
+// ____________________________________________________________________________
+void Clock::begin(RTC_DS3231& rtc, int8_t sqwPin) {
+  _rtc = &rtc;
+  _sqwPin = sqwPin;
+  // start from the second read, the edge then steps the clock onto it
+  _baseTime = _refTime = rtc.now().unixtime();
+  _baseMillis = _refMillis = _lastSync = millis();
+  sync(1000 + CLOCK_GUARD);
+  // the drift is measured from that edge, its offset is not reported
+  _refTime = _baseTime;
+  _refMillis = _baseMillis;
+  _offset = _maxOffset = 0;
+  _syncs = _steps = 0;
+  if (sqwPin >= 0) {
+    // the output is open drain
+    rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+    pinMode(sqwPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(sqwPin), onEdge, FALLING);
+  }
+}
+
+// ____________________________________________________________________________
+void Clock::update(void) {
+  if (_sqwPin >= 0) {
+    noInterrupts();
+    uint32_t edges = _edges;
+    uint32_t edge = _edgeMillis;
+    interrupts();
+    if (edges != _lastEdges) {
+      // the second starting at the edge is the one nearest to the clock
+      _lastEdges = edges;
+      discipline(edge, (at(edge) + 500) / 1000);
+    }
+  }
+  if (millis() - _lastSync < CLOCK_SYNC_INTERVAL * 1000UL) return;
+
+  if (_missed) {
+    // the clock is off by more than CLOCK_GUARD, wait for the next edge
+    _missed = false;
+    if (!sync(1000 + CLOCK_GUARD)) _lastSync = millis();  // RTC stopped
+    return;
+  }
+  uint16_t ms;
+  now(&ms);
+  if (ms >= 1000 - CLOCK_GUARD && !sync(2 * CLOCK_GUARD)) _missed = true;
+}
+
+// ____________________________________________________________________________
+DateTime Clock::now(uint16_t* ms) const {
+  int64_t time = at(millis());
+  if (ms) *ms = time % 1000;
+  return DateTime((uint32_t) (time / 1000));
+}
+
+// ____________________________________________________________________________
+void Clock::report(char* line, size_t size) {
+  snprintf(line, size,
+           "# Clock, drift %li ppm, offset %li ms, max offset %li ms, "
+           "syncs %lu, steps %u\n",
+           (long) _drift, (long) _offset, (long) _maxOffset,
+           (unsigned long) _syncs, _steps);
+  _maxOffset = 0;
+  _syncs = 0;
+  _steps = 0;
+}
+
+// ____________________________________________________________________________
+bool Clock::sync(uint16_t timeout) {
+  _valid = !_rtc->lostPower();
+  uint32_t first = _rtc->now().unixtime();
+  uint32_t start = millis();
+  do {
+    // the edge was before the start of the read that shows it
+    uint32_t edge = millis();
+    uint32_t second = _rtc->now().unixtime();
+    if (second != first) {
+      discipline(edge, second);
+      return true;
+    }
+  } while (millis() - start < timeout);
+  return false;
+}
+
+// ____________________________________________________________________________
+void Clock::discipline(uint32_t edge, uint32_t second) {
+  int64_t offset = at(edge) - second * 1000LL;
+  _syncs++;
+  _lastSync = millis();
+  if (offset <= -CLOCK_STEP || offset >= CLOCK_STEP) {
+    // the RTC was set or the clock is not yet on it
+    _steps++;
+    _refTime = second;
+    _refMillis = edge;
+  } else {
+    _offset = offset;
+    _maxOffset = max(_maxOffset, abs(_offset));
+    uint32_t span = second - _refTime;
+    if (span >= CLOCK_SYNC_INTERVAL / 2) {
+      int64_t counted = (int64_t) (edge - _refMillis) - span * 1000LL;
+      int32_t drift = counted * 1000 / (int64_t) span;
+      // larger rates are a step of the RTC by less than CLOCK_STEP
+      if (abs(drift) <= CLOCK_MAX_DRIFT) _drift = drift;
+      _refTime = second;
+      _refMillis = edge;
+    }
+  }
+  _baseTime = second;
+  _baseMillis = edge;
+}
+
+// ____________________________________________________________________________
+int64_t Clock::at(uint32_t m) const {
+  // signed, an edge taken may be before the last sync
+  int32_t elapsed = m - _baseMillis;
+  return _baseTime * 1000LL + elapsed - (int64_t) elapsed * _drift / 1000000;
+}
+
+// ____________________________________________________________________________
+void Clock::onEdge(void) {
+  _edgeMillis = millis();
+  _edges++;
+}
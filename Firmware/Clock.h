@@ -0,0 +1,99 @@
+/******************************************************************************
+ * 
+ * Software clock with millisecond resolution, disciplined by the RTC.
+ * 
+ * Reading the DS3231 takes an I2C transfer and gives whole seconds only.
+ * The clock instead counts the time from millis() since the last second
+ * edge of the RTC, so it is read without I2C traffic and gives the
+ * milliseconds of the data rows. The edges are found in two ways:
+ *  - by reading the RTC until its second changes. On start this takes up
+ *    to a second, afterwards the RTC is read every CLOCK_SYNC_INTERVAL
+ *    from CLOCK_GUARD ms before the predicted edge on, which usually
+ *    takes about CLOCK_GUARD ms
+ *  - by the 1 Hz square wave of the RTC, if its SQW pin is wired to
+ *    CLOCK_SQW_PIN. Its falling edges are the start of a second and are
+ *    taken every second by an interrupt, without any I2C traffic. If they
+ *    stop the RTC is read as above
+ * 
+ * At every edge the clock is set to the second of the RTC. The rate of
+ * millis() against the RTC, the drift, is measured over at least half of
+ * CLOCK_SYNC_INTERVAL and corrected between the edges, so the offset found
+ * at the next edge stays at a few ms. The clock may thus step back by
+ * that offset. Offsets of CLOCK_STEP or more, e.g. after the RTC was set,
+ * are counted as steps and restart the measurement of the drift.
+ * report() formats drift, offsets and steps for the data file.
+ * 
+ * Only one clock can take the square wave, as an interrupt has no object.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _CLOCK__H_
+#define _CLOCK__H_
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include "Config.h"
+
+#define CLOCK_STEP      500     ///< ms offset from which the clock is stepped
+#define CLOCK_MAX_DRIFT 1000    ///< ppm, larger rates are not taken
+
+/* Clock counting millis() from the last second edge of the RTC */
+class Clock {
+ public:
+  Clock();
+
+  // find the next second edge of given RTC, takes up to a second. With
+  // sqwPin >= 0 the square wave of the RTC on that pin is used as well
+  void begin(RTC_DS3231& rtc, int8_t sqwPin);
+  // take new edges, reads the RTC when a sync is due. Call it every loop
+  void update(void);
+  // current time, the milliseconds of the second into ms if given
+  DateTime now(uint16_t* ms = NULL) const;
+  // if the RTC kept its time, false if it lost power and is not set
+  bool valid(void) const { return _valid; }
+  // rate of millis() against the RTC in ppm, positive if millis() is fast
+  int32_t drift(void) const { return _drift; }
+  // offset found at the last edge in ms, positive if the clock was ahead
+  int32_t offset(void) const { return _offset; }
+  // format the drift and the offsets since the last report as a comment
+  // of the data file, terminated by a newline, and start a new report
+  void report(char* line, size_t size);
+
+ private:
+  // read the RTC for up to timeout ms until its second changes, false if
+  // it did not
+  bool sync(uint16_t timeout);
+  // set the clock to the RTC at its edge of given second at millis() edge
+  void discipline(uint32_t edge, uint32_t second);
+  // time in ms since 1970 at millis() m
+  int64_t at(uint32_t m) const;
+  // interrupt of the square wave
+  static void onEdge(void);
+
+  RTC_DS3231* _rtc;         ///< clock disciplining this one
+  int8_t _sqwPin;           ///< pin of the square wave, -1 if none
+  bool _valid;              ///< RTC did not lose power
+  bool _missed;             ///< last sync found no edge, wait a whole second
+  uint32_t _baseTime;       ///< unix time of the last edge
+  uint32_t _baseMillis;     ///< millis() at the last edge
+  uint32_t _refTime;        ///< unix time of the edge the drift is from
+  uint32_t _refMillis;      ///< millis() at that edge
+  uint32_t _lastSync;       ///< millis() of the last edge or sync attempt
+  uint32_t _lastEdges;      ///< number of square wave edges taken
+  int32_t _drift;           ///< rate of millis() in ppm
+  int32_t _offset;          ///< offset at the last edge in ms
+  int32_t _maxOffset;       ///< largest offset since the last report
+  uint32_t _syncs;          ///< edges since the last report
+  uint16_t _steps;          ///< steps since the last report
+
+  static volatile uint32_t _edges;      ///< falling edges of the square wave
+  static volatile uint32_t _edgeMillis; ///< millis() at the last of them
+};
+
+#endif  // _CLOCK__H_
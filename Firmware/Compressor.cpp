@@ -0,0 +1,197 @@
+/******************************************************************************
+ * 
+ * Compression of the measurements into blocks of delta encoded samples.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Compressor.h"
+
+static_assert(COMPRESSED_BLOCK == sizeof(JournalSector::payload),
+              "a block must fill exactly one page of the logger");
+
+// bits of the bit stream of a block
+#define STREAM_BITS ((COMPRESSED_BLOCK - COMPRESSED_HEADER \
+                      - COMPRESSED_TRAILER) * 8)
+
+// ____________________________________________________________________________
+Compressor::Compressor()
+    : _length(0), _taken(0), _bits(0), _bitCount(0), _count(0),
+      _finished(false), _waiting(false), _delta(0) {
+}
+
+// ____________________________________________________________________________
+void Compressor::add(const Sample& sample) {
+  if (_count == 0) {
+    start(sample);
+  } else if ((_length - COMPRESSED_HEADER) * 8 + _bitCount + bits(sample)
+             > STREAM_BITS) {
+    // block full, the sample starts the next one once this one was taken
+    finish();
+    _next = sample;
+    _waiting = true;
+  } else {
+    encode(sample);
+  }
+}
+
+// ____________________________________________________________________________
+uint16_t Compressor::take(const uint8_t** data, bool* part) {
+  if (_taken == _length && _finished) {
+    // the finished block was taken completely
+    _count = 0;
+    _length = 0;
+    _taken = 0;
+    _finished = false;
+    if (_waiting) {
+      _waiting = false;
+      start(_next);
+    }
+  }
+  *data = _block + _taken;
+  *part = _taken > 0;
+  uint16_t length = _length - _taken;
+  _taken = _length;
+  return length;
+}
+
+// ____________________________________________________________________________
+void Compressor::close(void) {
+  if (_count > 0 && !_finished) finish();
+}
+
+// ____________________________________________________________________________
+void Compressor::start(const Sample& sample) {
+  memset(_block, 0, sizeof(_block));
+  put16(0, COMPRESSED_MAGIC & 0xFFFF);
+  put16(2, COMPRESSED_MAGIC >> 16);
+  put16(4, sample.time & 0xFFFF);
+  put16(6, sample.time >> 16);
+  put16(8, sample.co2);
+  put16(10, sample.temp);
+  put16(12, sample.rh);
+  _length = COMPRESSED_HEADER;
+  _taken = 0;
+  _bits = 0;
+  _bitCount = 0;
+  _count = 1;
+  _finished = false;
+  _last = sample;
+  _delta = 0;
+}
+
+// ____________________________________________________________________________
+void Compressor::finish(void) {
+  // the rest of the last byte and of the bit stream stays 0
+  if (_bitCount) put(0, 8 - _bitCount);
+  put16(COMPRESSED_BLOCK - 4, _count);
+  put16(COMPRESSED_BLOCK - 2, crc16(_block, COMPRESSED_BLOCK - 2));
+  _length = COMPRESSED_BLOCK;
+  _finished = true;
+}
+
+// ____________________________________________________________________________
+uint8_t Compressor::bits(const Sample& sample) const {
+  int32_t dod = sample.time - _last.time - (uint32_t) _delta;
+  uint8_t n = dod == 0 ? 1
+            : (dod >= -64 && dod < 64) ? 9
+            : (dod >= -256 && dod < 256) ? 12
+            : (dod >= -2048 && dod < 2048) ? 16 : 36;
+  int16_t deltas[3] = {(int16_t) (sample.co2 - _last.co2),
+                       (int16_t) (sample.temp - _last.temp),
+                       (int16_t) (sample.rh - _last.rh)};
+  for (uint8_t i = 0; i < 3; i++) {
+    int16_t d = deltas[i];
+    n += d == 0 ? 1
+       : (d >= -8 && d < 8) ? 6
+       : (d >= -128 && d < 128) ? 11
+       : (d >= -2048 && d < 2048) ? 16 : 20;
+  }
+  return n;
+}
+
+// ____________________________________________________________________________
+void Compressor::encode(const Sample& sample) {
+  // modulo 2^32, the time may jump anywhere, e.g. when the clock is set
+  int32_t delta = sample.time - _last.time;
+  int32_t dod = (uint32_t) delta - (uint32_t) _delta;
+  if (dod == 0) {
+    put(0, 1);
+  } else if (dod >= -64 && dod < 64) {
+    put(0x2, 2);
+    put(dod, 7);
+  } else if (dod >= -256 && dod < 256) {
+    put(0x6, 3);
+    put(dod, 9);
+  } else if (dod >= -2048 && dod < 2048) {
+    put(0xE, 4);
+    put(dod, 12);
+  } else {
+    put(0xF, 4);
+    put((uint32_t) dod >> 16, 16);
+    put(dod, 16);
+  }
+  encodeValue(sample.co2 - _last.co2);
+  encodeValue(sample.temp - _last.temp);
+  encodeValue(sample.rh - _last.rh);
+
+  _delta = delta;
+  _last = sample;
+  _count++;
+}
+
+// ____________________________________________________________________________
+void Compressor::encodeValue(int16_t delta) {
+  if (delta == 0) {
+    put(0, 1);
+  } else if (delta >= -8 && delta < 8) {
+    put(0x2, 2);
+    put(delta, 4);
+  } else if (delta >= -128 && delta < 128) {
+    put(0x6, 3);
+    put(delta, 8);
+  } else if (delta >= -2048 && delta < 2048) {
+    put(0xE, 4);
+    put(delta, 12);
+  } else {
+    put(0xF, 4);
+    put(delta, 16);
+  }
+}
+
+// ____________________________________________________________________________
+void Compressor::put(uint32_t value, uint8_t count) {
+  // at most 16 bits at a time, so 7 bits left over and the new ones fit
+  _bits = (_bits << count) | (value & ((1UL << count) - 1));
+  _bitCount += count;
+  while (_bitCount >= 8) {
+    _bitCount -= 8;
+    _block[_length++] = _bits >> _bitCount;
+  }
+}
+
+// ____________________________________________________________________________
+void Compressor::put16(uint16_t offset, uint16_t value) {
+  _block[offset] = value & 0xFF;
+  _block[offset + 1] = value >> 8;
+}
+
+// ____________________________________________________________________________
+uint16_t Compressor::crc16(const uint8_t* data, uint16_t length) {
+  // bitwise like Logger::crc32(), once per block
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < length; i++) {
+    crc ^= data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
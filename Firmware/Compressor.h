@@ -0,0 +1,139 @@
+/******************************************************************************
+ * 
+ * Compression of the measurements into blocks of delta encoded samples.
+ * 
+ * CO2, temperature and humidity change slowly between two measurements, so
+ * instead of a line of text each sample is stored as the change to the one
+ * before, packed into as few bits as needed (similar to the time series
+ * compression of Facebook's Gorilla database). The values are integers
+ * with the resolution of the CSV files, so this is lossless with respect
+ * to them. A sample of slowly changing values takes about 3 bytes instead
+ * of the about 40 bytes of a line.
+ * 
+ * Samples are collected in blocks of COMPRESSED_BLOCK bytes, the size of
+ * the page of the logger. Every block starts with a full sample and can be
+ * decoded on its own, so a tool can seek to any block of a file. The bytes
+ * of a block are handed to the logger as soon as they are complete, the
+ * last samples are thus journaled like lines of text.
+ * 
+ * Block layout, all numbers little endian:
+ *  0   uint32_t  COMPRESSED_MAGIC
+ *  4   uint32_t  time of the first sample (unix time)
+ *  8   uint16_t  CO2 of the first sample in ppm
+ *  10  int16_t   temperature of the first sample in 0.01 °C
+ *  12  uint16_t  humidity of the first sample in 0.01 %
+ *  14  uint16_t  reserved, 0
+ *  16  bit stream of the following samples, most significant bit first
+ *  -4  uint16_t  number of samples, including the first one
+ *  -2  uint16_t  CRC-16/CCITT of the block up to here
+ *  A block still being filled has no trailer yet, e.g. the last block of a
+ *  file written until a reset. Its samples end with the stream of bits,
+ *  the last one or two whose bits did not fill a byte yet are lost.
+ * 
+ * Sample in the bit stream:
+ *  time        delta of delta to the sample before, the delta before the
+ *              second sample of a block is 0
+ *              0                   0
+ *              10   + 7 bits       -64 ... 63
+ *              110  + 9 bits       -256 ... 255
+ *              1110 + 12 bits      -2048 ... 2047
+ *              1111 + 32 bits      any
+ *  CO2, temperature, humidity each as delta to the sample before, modulo
+ *  2^16
+ *              0                   0
+ *              10   + 4 bits       -8 ... 7
+ *              110  + 8 bits       -128 ... 127
+ *              1110 + 12 bits      -2048 ... 2047
+ *              1111 + 16 bits      any
+ *  Numbers after the prefix are two's complement.
+ * 
+ * A block not ending with a valid trailer is read until the next block
+ * magic. After a reset a new block is started at the end of the file, so
+ * blocks are not always at multiples of COMPRESSED_BLOCK. The bytes of a
+ * block after its first ones are appended as parts, see Logger.h, so if
+ * the logger had to drop data, the rest of a block cut by it is dropped as
+ * well and the block is read like one written until a reset. Monitor then
+ * closes the block and notes the loss in the text file. Tools/DataDecode
+ * decodes the files.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _COMPRESSOR__H_
+#define _COMPRESSOR__H_
+
+#include <Arduino.h>
+#include "Logger.h"
+
+#define COMPRESSED_MAGIC    0x4B4C4243UL  ///< "CBLK" at the start of a block
+#define COMPRESSED_BLOCK    (SECTOR_SIZE - 64)  ///< bytes of a block, a page
+#define COMPRESSED_HEADER   16            ///< bytes before the bit stream
+#define COMPRESSED_TRAILER  4             ///< bytes after the bit stream
+
+/* Format of the data files */
+enum DataFormat : uint8_t {
+  FORMAT_CSV,         ///< one line of text per measurement
+  FORMAT_COMPRESSED   ///< blocks of delta encoded samples, see above
+};
+
+/* One measurement in the resolution it is stored with */
+struct Sample {
+  uint32_t time;      ///< unix time
+  uint16_t co2;       ///< CO2 in ppm
+  int16_t temp;       ///< temperature in 0.01 °C
+  uint16_t rh;        ///< relative humidity in 0.01 %
+};
+
+/* Streaming encoder of samples into blocks */
+class Compressor {
+ public:
+  Compressor();
+
+  // add a sample, the bytes completed by it are then taken with take()
+  void add(const Sample& sample);
+  // pointer to the bytes completed since the last call and their number,
+  // 0 if there are none. Part is set if they continue the bytes taken
+  // before, false for the start of a block. Call it until it returns 0
+  // after every add()
+  uint16_t take(const uint8_t** data, bool* part);
+  // finish the block with the samples added so far, e.g. at the end of a
+  // file. The next sample starts a new block
+  void close(void);
+
+ private:
+  // start a block with given sample
+  void start(const Sample& sample);
+  // write the trailer of the block
+  void finish(void);
+  // number of bits the sample takes in the bit stream
+  uint8_t bits(const Sample& sample) const;
+  // append the sample to the bit stream
+  void encode(const Sample& sample);
+  // append the delta of a value to the bit stream
+  void encodeValue(int16_t delta);
+  // append the lowest count bits of value to the bit stream
+  void put(uint32_t value, uint8_t count);
+  // put little endian number into the block
+  void put16(uint16_t offset, uint16_t value);
+  // CRC-16/CCITT of given data
+  static uint16_t crc16(const uint8_t* data, uint16_t length);
+
+  uint8_t _block[COMPRESSED_BLOCK]; ///< block being filled
+  uint16_t _length;         ///< bytes of the block completed
+  uint16_t _taken;          ///< bytes of the block taken
+  uint32_t _bits;           ///< bits not yet making a complete byte
+  uint8_t _bitCount;        ///< number of bits in _bits
+  uint16_t _count;          ///< samples in the block, 0 if not started
+  bool _finished;           ///< block has its trailer
+  bool _waiting;            ///< _next starts the next block
+  Sample _next;             ///< sample that did not fit into the block
+  Sample _last;             ///< sample added last
+  int32_t _delta;           ///< time between the last two samples
+};
+
+#endif  // _COMPRESSOR__H_
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * 
+ * Settings of the CO2 monitor.
+ * 
+ * Pin definitions, colors and constants shared by the sketch and the
+ * Monitor class. Change them here to adapt the firmware to a different
+ * circuit or deployment.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _CONFIG__H_
+#define _CONFIG__H_
+
+/* Define pin names */
+// SPI
+#define SD_CS   5   // on Adafruit 3.5" 480x320 TFT Feahterwing
+#define SD2_CS  4   // on Feather M0 uSD Adalogger
+#define TFT_CS  9
+#define TFT_DC  10  // Data/Command pin of TFT display
+#define TFT_RST -1  // RST can be set to -1 if you tie it to Arduino's reset
+// Buttons
+#define CALIB   14  // button for calibration and pages, see Button.h
+// Backlight
+#define BACKLIGHT -1  // pin wired to Lite of the TFT FeatherWing, -1 if none
+
+/* Colors used on display in 16 bit 565-RGB (5 red, 6 green, 5 blue) */
+// convert 3 8 bit component RGB color to 16 bit 565-RGB color
+#define RGB_TO_565RGB(r, g, b) (((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+// color definitions composed of: red   green blue
+#define WHITE       RGB_TO_565RGB(0xFF, 0xFF, 0xFF)
+#define GREY        RGB_TO_565RGB(0x7F, 0x7F, 0x7F)
+#define BLACK       RGB_TO_565RGB(0x00, 0x00, 0x00)
+#define RED         RGB_TO_565RGB(0xFF, 0x00, 0x00)
+#define ORANGE      RGB_TO_565RGB(0xFF, 0x7F, 0x00)
+#define YELLOW      RGB_TO_565RGB(0xB8, 0xB8, 0x00)
+#define GREEN       RGB_TO_565RGB(0x00, 0xC0, 0x00)
+#define BLUE        RGB_TO_565RGB(0x00, 0x00, 0xFF)
+// colors of IMTEK logo
+#define IMTEK_BLUE  RGB_TO_565RGB(0x18, 0x10, 0x77)
+#define IMTEK_RED   RGB_TO_565RGB(0xBA, 0x24, 0x26)
+// frequently used colors
+#define BACKGROUND_COLOR  BLACK
+#define TEXT_COLOR        WHITE
+
+/* Global constants */
+// directories , files and contents
+// handable filenames must be 8.3 format -> 13 chars incl. trailing 0
+// data files are named DIRECTORY/YYYY/MM/DD.FILE_EXTENSION
+#define DIRECTORY         "Data"
+#define FILE_EXTENSION    "csv"
+#define DEFAULT_FILE_NAME "datalogg"  ///< used while the clock is not set
+#define FILE_HEADER   	  "dateTime, co2, temp, rh, people, seq, uptime"
+#define IMTEK_LOGO_SMALL  "g100x44.bmp"
+#define IMTEK_LOGO_BIG    "w460x203.bmp"
+// use of the SD card slots, see Logger.h
+// LOG_FAILOVER: write one card, switch to the other slot on errors
+// LOG_MIRROR:   write all data to the cards in both slots
+#define LOG_MODE          LOG_FAILOVER
+#define INDEX_INTERVAL    300   ///< s between entries of the index files
+// sequence numbers of the data rows, see Sequence.h
+#define SEQUENCE_FILE     "sequence.bin"  ///< lease in the root of the card
+#define SEQUENCE_LEASE    65536 ///< rows per lease, about 36 h
+// format of the measurements, see Compressor.h
+// FORMAT_CSV:        a line of text per measurement in the .csv file
+// FORMAT_COMPRESSED: delta encoded blocks in a file of COMPRESSED_EXTENSION,
+//                    header and comments stay in the .csv file
+#define DATA_FORMAT       FORMAT_CSV
+#define COMPRESSED_EXTENSION "bin"
+// filter of the values ahead of display and statistics, see Filter.h. The
+// data files keep the raw values
+// FILTER_NONE:   use the raw values
+// FILTER_MEDIAN: median of the last FILTER_WINDOW values
+// FILTER_HAMPEL: replace values far from that median by it
+#define FILTER_MODE       FILTER_HAMPEL
+#define FILTER_WINDOW     7     ///< values the median is taken of, odd
+#define HAMPEL_SIGMAS     3     ///< standard deviations of an outlier
+#define SPIKE_CO2         30    ///< ppm, smaller deviations are kept
+#define SPIKE_TEMP        30    ///< 0.01 °C, smaller deviations are kept
+#define SPIKE_RH          150   ///< 0.01 %, smaller deviations are kept
+// button, see Button.h. A long press starts or aborts a calibration, a
+// short one shows the next page, a double press the page of the values
+#define BUTTON_DEBOUNCE   20    ///< ms bounces of the contacts are ignored
+#define BUTTON_LONG       1000  ///< ms a long press is held
+#define BUTTON_DOUBLE     300   ///< ms between the presses of a double press
+#define SENSOR_POLL       100   ///< ms between two requests of the sensor
+// a missing SD card is mounted right after a sample, see Logger.h, or if
+// there was none for MOUNT_WAIT
+#define MOUNT_WAIT        10000 ///< ms without sample to mount anyway
+// trend graph page, a point per GRAPH_STEP
+#define GRAPH_STEP        60    ///< s of measurements averaged into a point
+// start up
+#define SPLASH_TIME       3000  ///< ms the start up screen is shown at most
+#define SPLASH_ROWS       16    ///< logo rows drawn between two boot steps
+// CO2 levels, the CO2 bar changes its color at each of them
+#define CO2_LEVEL_1       400   ///< ppm, grey below, outdoor air
+#define CO2_LEVEL_2       1000  ///< ppm, green below
+#define CO2_LEVEL_3       1500  ///< ppm, yellow below
+#define CO2_LEVEL_4       2000  ///< ppm, orange below, red above
+// daily statistics, see Statistics.h
+#define SUMMARY_FILE      "summary.csv" ///< file in DIRECTORY, a line per day
+// ventilations, see Ventilation.h
+#define EVENTS_EXTENSION  "evt" ///< file of the ventilations of a day
+#define VENTILATION_DROP  200   ///< ppm fall from a peak counted as ventilation
+#define VENTILATION_RATE  30    ///< ppm/min fall that starts a ventilation
+#define VENTILATION_END_RATE 10 ///< ppm/min fall that ends it, if it stays
+#define VENTILATION_DECAY 30    ///< min, slower decays are not ventilations
+#define VENTILATION_DEBOUNCE 15 ///< samples the fall must stay slow to end
+// prediction of the time until the next of CO2_LEVEL_2 and CO2_LEVEL_4,
+// shown in the CO2 bar, see Trend.h
+#define TREND_SAMPLES     128   ///< samples followed by the fit, about 4 min
+#define TREND_MIN_SAMPLES 30    ///< samples after a gap before predicting
+#define TREND_MIN_SLOPE   3     ///< ppm/min, slower rises are not predicted
+#define PREDICTION_TIME   30    ///< min, later levels are not shown
+// per device settings, read on start from SETTINGS_FILE in the root of
+// the card, see Settings.h. The defaults are used without
+#define SETTINGS_FILE     "settings.txt"
+#define ROOM_VOLUME       0     ///< m³, without people are not estimated
+#define AIR_CHANGE_RATE   50    ///< 0.01/h, air changes with windows closed
+#define DISPLAY_FROM      0     ///< minute of the day the display turns on
+#define DISPLAY_UNTIL     0     ///< minute it turns off, DISPLAY_FROM for never
+#define DISPLAY_DAYS      0x7F  ///< days the display is on, bit 0 Sunday
+// display power outside the times above, see DisplayPower.h. With
+// BACKLIGHT -1, as on the boards so far, only the controller sleeps and
+// the backlight stays on, which saves little of the current
+#define DISPLAY_WAKE_TIME 120   ///< s the display is on after a press or alarm
+#define DISPLAY_WAKE_LEVEL CO2_LEVEL_3  ///< ppm from which CO2 wakes it
+// estimation of the people in the room, see Occupancy.h
+#define CO2_PER_PERSON    18720 ///< ppm m³/h exhaled by a sitting adult
+// software clock disciplined by the RTC, see Clock.h
+#define CLOCK_SQW_PIN     -1    ///< pin wired to SQW of the RTC, -1 if none
+#define CLOCK_SYNC_INTERVAL 600 ///< s between two reads of the RTC
+#define CLOCK_GUARD       100   ///< ms the RTC is read ahead of an edge
+// calibration
+#define BACKGROUND_CO2    417   ///< ppm value of atmospheric background CO2
+#define CALIBRATION_TIME  300   ///< seconds to wait before calibration
+#define CALIBRATION_FILE  "calib.csv" ///< in DIRECTORY, a line per calibration
+
+#endif  // _CONFIG__H_
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * 
+ * Sleep of the display and its backlight.
+ * 
+ * The display and above all its backlight draw most of the current of the
+ * device. Outside the times of the settings, e.g. at night and at weekends,
+ * the display is put to sleep while measurements are logged on:
+ *  - the backlight is turned off by the Lite pin of the TFT FeatherWing.
+ *    It must be wired to a free pin given as BACKLIGHT, without it only the
+ *    controller sleeps and the backlight stays on
+ *  - the controller turns its output off and goes to sleep. Its memory
+ *    keeps the image and can still be written, e.g. the time of the header
+ * 
+ * wake() takes the controller out of sleep with its output still off, so
+ * the image can be completed before light() shows it.
+ * 
+ * Sleep in and out must be SLEEP_DELAY ms apart, and after sleep out the
+ * controller needs that time before its output is turned on. Instead of
+ * waiting, a command that is not due yet is sent by update() of a later
+ * loop, so sleep(), wake() and light() return at once. The memory of the
+ * controller can be written meanwhile.
+ * 
+ * The commands are those of MIPI DCS, the same for the HX8357 and most
+ * other controllers of Adafruit displays. In addition to the methods listed
+ * in Graphics.h the display must provide
+ *  sendCommand(uint8_t)
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _DISPLAYPOWER__H_
+#define _DISPLAYPOWER__H_
+
+#include <Arduino.h>
+#include "Graphics.h"
+
+#define DCS_SLEEP_IN    0x10    ///< command to enter sleep
+#define DCS_SLEEP_OUT   0x11    ///< command to leave sleep
+#define DCS_DISPLAY_OFF 0x28    ///< command to turn the output off
+#define DCS_DISPLAY_ON  0x29    ///< command to turn the output on
+#define SLEEP_DELAY     120     ///< ms between sleep in and out, either way
+
+/* Class to put a display and its backlight to sleep and wake them */
+template <class Display>
+class DisplayPower : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  /* Methods */
+  // take the display and the pin of its backlight, -1 if there is none
+  DisplayPower(Display* display, int8_t backlightPin);
+
+  // set up the pin of the backlight and turn it on
+  void begin(void);
+  // turn backlight and output off and put the controller to sleep
+  void sleep(void);
+  // take the controller out of sleep, the output stays off until light()
+  void wake(void);
+  // turn output and backlight on once the controller is awake
+  void light(void);
+  // send the commands that were not due yet. Call it every loop
+  void update(void);
+  // if the display is awake, false between sleep() and wake()
+  bool awake(void) const { return _awake; }
+
+ private:
+  /* Members */
+  int8_t _pin;          ///< pin of the backlight, -1 if none
+  bool _awake;          ///< controller is to be awake
+  bool _lit;            ///< output and backlight are to be on
+  bool _asleep;         ///< sleep in was sent, not followed by sleep out
+  bool _on;             ///< output and backlight are on
+  uint32_t _since;      ///< millis() of the last sleep in or out
+};
+
+// ____________________________________________________________________________
+template <class Display>
+DisplayPower<Display>::DisplayPower(Display* display, int8_t backlightPin)
+    : Graphics<Display>(display), _pin(backlightPin), _awake(true),
+      _lit(true), _asleep(false), _on(true), _since(0) {
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void DisplayPower<Display>::begin(void) {
+  if (_pin < 0) return;
+  pinMode(_pin, OUTPUT);
+  digitalWrite(_pin, HIGH);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void DisplayPower<Display>::sleep(void) {
+  if (!_awake) return;
+  _awake = false;
+  _lit = false;
+  if (_on) {
+    if (_pin >= 0) digitalWrite(_pin, LOW);
+    _display->sendCommand(DCS_DISPLAY_OFF);
+    _on = false;
+  }
+  update();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void DisplayPower<Display>::wake(void) {
+  if (_awake) return;
+  _awake = true;
+  update();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void DisplayPower<Display>::light(void) {
+  _lit = _awake;
+  update();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void DisplayPower<Display>::update(void) {
+  if (millis() - _since < SLEEP_DELAY) return;
+  if (_awake == _asleep) {
+    // sleep in or out as the last of sleep() and wake() asked for
+    _display->sendCommand(_awake ? DCS_SLEEP_OUT : DCS_SLEEP_IN);
+    _asleep = !_awake;
+    _since = millis();
+  } else if (_lit && !_on) {
+    // the controller started its oscillator and power supplies
+    _display->sendCommand(DCS_DISPLAY_ON);
+    if (_pin >= 0) digitalWrite(_pin, HIGH);
+    _on = true;
+  }
+}
+
+#endif  // _DISPLAYPOWER__H_
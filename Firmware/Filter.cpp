@@ -0,0 +1,69 @@
+/******************************************************************************
+ * 
+ * Filter of single bad readings of the sensor.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Filter.h"
+
+// ____________________________________________________________________________
+SpikeFilter::SpikeFilter(FilterMode mode, uint8_t window,
+                         int32_t minDeviation)
+    : _mode(mode), _window(min(window, (uint8_t) FILTER_MAX_WINDOW)),
+      _minDeviation(minDeviation), _replaced(0) {
+  reset();
+}
+
+// ____________________________________________________________________________
+void SpikeFilter::reset(void) {
+  _count = 0;
+  _next = 0;
+}
+
+// ____________________________________________________________________________
+int32_t SpikeFilter::add(int32_t value) {
+  if (_mode == FILTER_NONE) return value;
+  _values[_next] = value;
+  _next = (_next + 1) % _window;
+  if (_count < _window) _count++;
+  // too few values to tell an outlier from a change
+  if (_count < 3) return value;
+
+  int32_t sorted[FILTER_MAX_WINDOW];
+  memcpy(sorted, _values, _count * sizeof(int32_t));
+  int32_t middle = median(sorted, _count);
+  if (_mode == FILTER_MEDIAN) return middle;
+
+  // the MAD times 1.4826 estimates the standard deviation
+  for (uint8_t i = 0; i < _count; i++) {
+    sorted[i] = abs(_values[i] - middle);
+  }
+  int32_t limit = median(sorted, _count) * HAMPEL_SIGMAS * 1483 / 1000;
+  if (abs(value - middle) > max(limit, _minDeviation)) {
+    _replaced++;
+    return middle;
+  }
+  return value;
+}
+
+// ____________________________________________________________________________
+int32_t SpikeFilter::median(int32_t* data, uint8_t count) {
+  // insertion sort, the window is small
+  for (uint8_t i = 1; i < count; i++) {
+    int32_t value = data[i];
+    uint8_t j = i;
+    for (; j > 0 && data[j - 1] > value; j--) {
+      data[j] = data[j - 1];
+    }
+    data[j] = value;
+  }
+  return data[count / 2];
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * 
+ * Filter of single bad readings of the sensor.
+ * 
+ * A reading glitched on the I2C bus or someone breathing onto the sensor
+ * gives a single value far off the ones around it. Shown directly it flips
+ * the color of the CO2 bar and redraws it twice, and it skews the
+ * statistics of the day. The filter sits between the sensor and the
+ * display, statistics and detectors, the data files keep the raw values.
+ * 
+ * The filter keeps the last FILTER_WINDOW values of one quantity. In mode
+ * FILTER_MEDIAN it returns their median, in mode FILTER_HAMPEL it returns
+ * the newest value, unless it is further from the median than
+ * HAMPEL_SIGMAS standard deviations, estimated by 1.4826 times the median
+ * of the absolute deviations (MAD), and than a minimum deviation given per
+ * quantity. Then it is replaced by the median. The window is small and of
+ * fixed size, so each value takes a few dozen comparisons. A step of the
+ * real value passes with a delay of half the window.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _FILTER__H_
+#define _FILTER__H_
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define FILTER_MAX_WINDOW 9   ///< largest window supported
+
+/* Kind of filter */
+enum FilterMode : uint8_t {
+  FILTER_NONE,        ///< pass the raw values
+  FILTER_MEDIAN,      ///< median of the window
+  FILTER_HAMPEL       ///< replace outliers by the median of the window
+};
+
+/* Streaming filter of one quantity */
+class SpikeFilter {
+ public:
+  // take the mode, the window (odd, at most FILTER_MAX_WINDOW) and the
+  // smallest deviation from the median taken as outlier in FILTER_HAMPEL
+  SpikeFilter(FilterMode mode, uint8_t window, int32_t minDeviation);
+
+  // forget all values
+  void reset(void);
+  // add the newest raw value, returns the filtered value
+  int32_t add(int32_t value);
+  // number of values replaced since startup
+  uint32_t replaced(void) const { return _replaced; }
+
+ private:
+  // median of the first count values of data, sorts them
+  static int32_t median(int32_t* data, uint8_t count);
+
+  FilterMode _mode;                     ///< kind of filter
+  uint8_t _window;                      ///< number of values in the window
+  int32_t _minDeviation;                ///< smallest deviation of an outlier
+  int32_t _values[FILTER_MAX_WINDOW];   ///< ring of the last values
+  uint8_t _count;                       ///< values in the ring
+  uint8_t _next;                        ///< index of the next value
+  uint32_t _replaced;                   ///< values replaced by the median
+};
+
+#endif  // _FILTER__H_
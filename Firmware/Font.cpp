@@ -0,0 +1,36 @@
+/******************************************************************************
+ * 
+ * Pre-rasterized fonts.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Font.h"
+
+// ____________________________________________________________________________
+const Glyph* findGlyph(const Font* font, uint8_t code) {
+  // binary search, glyphs are sorted by character
+  int16_t lo = 0, hi = font->count - 1;
+  while (lo <= hi) {
+    int16_t mid = (lo + hi) / 2;
+    if (font->glyphs[mid].code == code) return &font->glyphs[mid];
+    if (font->glyphs[mid].code < code) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return NULL;
+}
+
+// ____________________________________________________________________________
+bool containsGlyphs(const Font* font, const String& text) {
+  for (uint16_t i = 0; i < text.length(); i++) {
+    if (!findGlyph(font, text[i])) return false;
+  }
+  return true;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * 
+ * Pre-rasterized fonts.
+ * 
+ * Structures to describe fonts whose glyphs are rasterized at a fixed
+ * textsize on the host by Tools/FontGen, see BigFont.h for the generated
+ * fonts. A Label drawing with such a font sends each glyph with a single
+ * address window as runs of text and background color, instead of the many
+ * small rectangles of a scaled built-in font.
+ * 
+ * Format:
+ *  The pixels of a glyph cell (including spacing to the next glyph) are run
+ *  length encoded in raster order. Runs alternate between background and
+ *  foreground, starting with background, and each run takes one byte. Runs
+ *  longer than 255 pixels are split by an empty run of the other color.
+ *  All data is const and thus placed in flash on the SAMD21.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _FONT__H_
+#define _FONT__H_
+
+#include <Arduino.h>
+
+/* Single glyph of a font */
+struct Glyph {
+  uint8_t code;       ///< character of the glyph
+  uint16_t offset;    ///< index of the first run in Font::runs
+  uint16_t length;    ///< number of runs
+};
+
+/* Font of glyphs rasterized at one textsize */
+struct Font {
+  uint8_t size;           ///< textsize of the built-in font it replaces
+  uint8_t width, height;  ///< dimensions of a glyph cell in pixels
+  uint8_t count;          ///< number of glyphs
+  const Glyph* glyphs;    ///< glyphs sorted by character
+  const uint8_t* runs;    ///< runs of all glyphs
+};
+
+// find the glyph of the given character, NULL if font does not contain it
+const Glyph* findGlyph(const Font* font, uint8_t code);
+// check if the font contains glyphs for all characters of the text
+bool containsGlyphs(const Font* font, const String& text);
+
+#endif  // _FONT__H_
@@ -1,263 +1,1277 @@
-/******************************************************************************
- * 
- * Basic classes to manage text and groups of text on displays.
- * 
- * - A Graphics class to take a display instance once and hold it as static.
- * Other classes derived from this can use the _display member to print on.
- * - A class to print text on a display with additional options to change
- * and erase it.
- * - A class to print measurement values between a name and a unit, with
- * options to change value and color or erase it.
- * - A class to print a header bar containing updatable date and time
- * and a logo.
- * - A class to show information and instructions about a pending calibration
- * of a sensor.
- * 
- * Note:
- *  While class Label is pretty much generic for usage in different kinds
- *  of application, the other classes are quite specific for the task
- *  of the CO2 monitor built.
- * 
- * Circuit:
- *  - Adafruit TFT FeatherWing - 3,5" 480x320
- *      other displays might work to, provided there is a library derived
- *      from "Adafruit_GFX" to controll them. Make sure to change
- *      DISPLAY_TYPE accordingly.
- * 
- * created        14.04.2021
- * last modified  29.05.2021
- * by             Jannik Sehringer
- * for            Laboratory for Sensors,
- *                IMTEK - Department of Microsystems Engineering,
- *                University of Freiburg
- * 
-******************************************************************************/
-
-#ifndef _GRAPHICS__H_
-#define _GRAPHICS__H_
-
-#include <Adafruit_HX8357.h>
-#include <RTClib.h>
-
-// dimensions of charaters in pixels
-// characters on screen have these dimensions times the textsize
-#define CHAR_W  6
-#define CHAR_H  8
-
-/* Class of the used display (recommended: Adafruit_HX8357)
- * must have the following methods:
- *  setCursor(int16_t, int16_t)
- *  setTextSize(uint8_t)
- *  setTextColor(uint16_t)
- *  print(const String&)
- *  print(char)
- *  fillRect(int16_t, int16_t, int16_t, int16_t, uint16_t)
- *  fillRoundRect(int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t)
- *  int16_t getCursorX()
- *  int16_t getCursorY()
- *  getTextBounds(const String&, int16_t, int16_t, int16_t, int16_t, uint16_t, uint16_t)
- * This should account for all types derived from "Adafruit_GFX",
- * for use of bmpReader it must be a type derived from "Adafruit_SPITFT" */
-#define DISPLAY_TYPE   Adafruit_HX8357
-
-/* Representation of "°" in String takes two bytes and will produce two
- * characters when printed with HX3857, to avoid that replace it with the
- * ASCII char 248 if present. */
-#define CORRECT_DEGREE_CHAR(str) \
- if (str.indexOf("°") >= 0) str.replace("°", String((char) 248))
-
-// options for justification of text
-// use alignment in both directions with bitwise or operator "|"
-// BOTTOM is usefull for labels of different size to appear on same baseline
-#define LEFT    0x0   // default
-#define RIGHT   0x1
-#define TOP     0x0   // default
-#define BOTTOM  0x2
-
-/******************************************************************************    
-*******************************************************************************
-    General helper functions
-*******************************************************************************
-******************************************************************************/
-
-// convert integer to two digit string with leading zeros
-String dig2(int number);
-
-/*****************************************************************************    
-******************************************************************************
-    Graphics
-******************************************************************************
-*****************************************************************************/
-
-/* Simple class to hold a static display instance to be initialized once and
- * used by all graphic subclasses. */
-class Graphics {
- public:
-  /* Methods */
-  // takes the reference to the display instance and stores it
-  static void useDisplay(DISPLAY_TYPE* display) {_display = display;}
- protected:
-  /* Members */
-  static DISPLAY_TYPE* _display;  ///< pointer to instance of display
-};
-
-/*****************************************************************************    
-******************************************************************************
-    Label
-******************************************************************************
-*****************************************************************************/
-
-/* Graphic class of text on screen with options to replace and erase it. */
-class Label : public Graphics {
- public:
-  /* Methods */
-  // constructor with text given as String
-  // take text, position (x, y), size, color and possibly subscript position
-  Label(uint16_t x, uint16_t y, String name, uint8_t size, uint16_t color,
-        uint8_t subscript = 0, uint8_t alignment=TOP|LEFT);
-  // constructor where text is a value given as uint16_t
-  Label(uint16_t x, uint16_t y, uint16_t val, uint8_t size, uint16_t color,
-        uint8_t alignment=TOP|LEFT);
-  // constructor where text is a value given as float
-  Label(uint16_t x, uint16_t y, float val, uint8_t size, uint16_t color,
-        uint8_t alignment=TOP|LEFT);
-  // empty default constructor
-  Label(void) {}
-
-  // print the text at the with size and color at position
-  void print(void);
-  // take smallest rectangle covering the text and fill it with the given color
-  void erase(uint16_t color);
-
-  /* the following methods only change the internal value, make sure to erase
-   * the Label before and print it afterwards to make change visible */
-  // change the position of the Label
-  void changePosition(int16_t x, int16_t y, uint8_t alignment=TOP|LEFT);
-  // change the text of the Label
-  void changeName(String name, uint8_t subscript = 0);
-  void changeName(uint16_t val);
-  void changeName(float val);
-
- private:
-  /* Methods */
-  // adjust upper left corner of text according to alignment...
-  // ... on set of position
-  void correctForAlignment(void);
-  // ... on change of name
-  void correctForAlignment(String name, uint8_t subscript);
-
-  /* Members */
-  uint16_t _x, _y;      ///< upper left corner of the label
-  uint16_t _color;      ///< textcolor
-  uint8_t _size;        ///< textsize
-  String _name;         ///< actual text to be printed
-  uint8_t _subscript;   ///< index of subscripted char +1, if 0 no subscript
-  uint8_t _alignment;   ///< alignment of text
-};
-
-/*****************************************************************************    
-******************************************************************************
-    ValueBar
-******************************************************************************
-*****************************************************************************/
-
-/* Class to draw colored bars with a name, a value and an unit. */
-class ValueBar : public Graphics {
- public:
-  /* Methods */
-  ValueBar(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color,
-           uint16_t textColor, String name, String unit, uint8_t subscript = 0);
-
-  // overdraw shape width given color
-  void erase(uint16_t color) const;
-  // draw background and reprint name and unit labels
-  // call refreshValue() afterwards otherwise no value will be shown
-  void draw(void);
-  // change the background color and reprint using draw()
-  void changeColor(uint16_t color);
-  // change the value label
-  void refreshValue(uint16_t val);
-  void refreshValue(float val);
-
- private:
-  /* Methods */
-  // print the background shape
-  void drawBackground(void) const;
-  
-  /* Members */
-  int16_t _x, _y;     ///< upper left corner of bar
-  uint16_t _w, _h;    ///< width and height of the bar
-  uint16_t _color;    ///< backround color of the bar
-  Label _labels[3];   ///< 3 labels: name, value and unit
-};
-
-/*****************************************************************************    
-******************************************************************************
-    HeaderBar
-******************************************************************************
-*****************************************************************************/
-
-/* Class to draw a header bar showing a logo, time and date. */
-class HeaderBar : public Graphics {
- public:
-  /* Methods */
-  HeaderBar(int16_t h, uint16_t color, uint16_t textColor, const char* logoFile);
-  
-  // draw background and reprint date and time labels
-  void draw(void);
-  // show the given time on the display
-  void updateTime(DateTime time);
-  // show the given date on the display
-  void updateDate(DateTime date);
-  // return the height of the bar
-  int16_t height(void) const;
-  
- private:
-  /* Methods */
-  // draw the background shape including the logo
-  void drawBackground(void) const;
-  
-  /* Members */
-  int16_t _w, _h;         ///< width and height of the bar
-  uint16_t _color;        ///< backround color of the bar
-  const char* _logoFile;  ///< filename of the logo to draw
-  Label _date;            ///< label to show time
-  Label _time;            ///< label to show date
-};
-
-/* Class to print out information about a pending calibration. */
-class CalibrationWarning : public Graphics {
- public:
-  CalibrationWarning(int16_t x, int16_t y, uint16_t w, uint16_t h,
-                     uint16_t color, uint16_t textColor);
-  
-  // draw new background shape and print calibration warning
-  void print(void);
-  // overdraw shape width given color
-  void erase(uint16_t color) const;
-  // set time for calibration to be executed
-  void setCalibrationTime(DateTime time);
-  // get the time calibration is scheduled for
-  DateTime getCalibrationTime(void) const;
-  // update the countdown till calibration with new time
-  void refreshCountdown(DateTime time);
-  // update current CO2 value with new value
-  void refreshCO2(uint16_t co2);
-
- private:
-  /* Methods */
-  // indent cursor given amount of pixels in x direction
-  inline void indent(int16_t x) const;
-  
-  /* Members */
-  int16_t _x, _y;               ///< upper left corner
-  uint16_t _w, _h;              ///< width and height
-  uint16_t _color, _textColor;  ///< color of background and text
-  uint8_t _textsize;            ///< size of the text
-  Label _co2Name;               ///< subscripted name CO2
-  Label _co2Value;              ///< value of co2
-  Label _countdown;             ///< remaining time
-  DateTime _calibrationTime;    ///< time of calibration
-};
-
+/******************************************************************************
+ * 
+ * Basic classes to manage text and groups of text on displays.
+ * 
+ * - A Graphics class to hold the display instance an element is drawn on.
+ * Other classes derived from this can use the _display member to print on.
+ * - A class to print text on a display with additional options to change
+ * and erase it, optionally using a pre-rasterized font.
+ * - A class to print measurement values between a name and a unit, with
+ * options to change value, color and a small note or erase it.
+ * - A class to print a header bar containing updatable date and time
+ * and a logo.
+ * - A class to print the minutes above the CO2 levels of the day and the
+ * time since the last ventilation.
+ * - A class to draw a graph of the CO2 of the last hours.
+ * - A class to print a page of lines of text below a title.
+ * - A class to show information and instructions about a pending calibration
+ * of a sensor.
+ * 
+ * Note:
+ *  Constructors only set up the internal state of an element, nothing is
+ *  drawn until print() or draw() is called. Thus elements can be created
+ *  before the display is initialized, e.g. as members of another object.
+ *  While class Label is pretty much generic for usage in different kinds
+ *  of application, the other classes are quite specific for the task
+ *  of the CO2 monitor built.
+ * 
+ * Circuit:
+ *  - Adafruit TFT FeatherWing - 3,5" 480x320
+ *      other displays might work to, provided there is a library derived
+ *      from "Adafruit_GFX" to controll them. Pass its class as template
+ *      parameter to the graphic elements.
+ * 
+ * created        14.04.2021
+ * last modified  16.10.2026
+ * by             Jannik Sehringer
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _GRAPHICS__H_
+#define _GRAPHICS__H_
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include <SD.h>
+#include "Layout.h"   // geometry of the elements, CHAR_W and CHAR_H
+#include "BigFont.h"  // pre-rasterized fonts for values and time
+
+/* All classes take the class of the used display as template parameter
+ * Display (recommended: Adafruit_HX8357). So the display can be exchanged
+ * without changing this file, e.g. for a framebuffer or a fake display on
+ * a host computer, and all calls are resolved at compile time.
+ * The class must have the following methods:
+ *  setCursor(int16_t, int16_t)
+ *  setTextSize(uint8_t)
+ *  setTextColor(uint16_t)
+ *  print(const String&)
+ *  print(char)
+ *  fillRect(int16_t, int16_t, int16_t, int16_t, uint16_t)
+ *  fillRoundRect(int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t)
+ *  drawFastHLine(int16_t, int16_t, int16_t, uint16_t)
+ *  drawLine(int16_t, int16_t, int16_t, int16_t, uint16_t)
+ *  int16_t getCursorX()
+ *  int16_t getCursorY()
+ * for use of pre-rasterized fonts additionally
+ *  startWrite()
+ *  endWrite()
+ *  setAddrWindow(uint16_t, uint16_t, uint16_t, uint16_t)
+ *  writeColor(uint16_t, uint32_t)
+ *  writeFillRect(int16_t, int16_t, int16_t, int16_t, uint16_t)
+ * This should account for all types derived from "Adafruit_GFX",
+ * for use of bmpReader it must provide the methods of "Adafruit_SPITFT"
+ * listed in bmpDraw.h */
+
+/* Representation of "°" in String takes two bytes and will produce two
+ * characters when printed with HX3857, to avoid that replace it with the
+ * ASCII char 248 if present. */
+#define CORRECT_DEGREE_CHAR(str) \
+ if (str.indexOf("°") >= 0) str.replace("°", String((char) 248))
+
+// options for justification of text
+// use alignment in both directions with bitwise or operator "|"
+// BOTTOM is usefull for labels of different size to appear on same baseline
+// positions taken from Layout.h are already corrected for BOTTOM
+#define LEFT    0x0   // default
+#define RIGHT   0x1
+#define TOP     0x0   // default
+#define BOTTOM  0x2
+
+// used in HeaderBar, defined in bmpDraw.h
+template <class Display> class bmpReader;
+
+/******************************************************************************    
+*******************************************************************************
+    General helper functions
+*******************************************************************************
+******************************************************************************/
+
+// convert integer to two digit string with leading zeros
+String dig2(int number);
+
+// get the pre-rasterized font for the given textsize, NULL if there is none
+const Font* bigFont(uint8_t size);
+
+/*****************************************************************************    
+******************************************************************************
+    Graphics
+******************************************************************************
+*****************************************************************************/
+
+/* Simple class to hold the display instance a graphic element is drawn on.
+ * Every element keeps its own pointer, so several displays can be used side
+ * by side. */
+template <class Display>
+class Graphics {
+ public:
+  /* Methods */
+  // takes the pointer to the display instance and stores it
+  Graphics(Display* display = NULL) : _display(display), _visible(true) {}
+  // set if the element is on the screen. A hidden element only changes its
+  // state on refresh, draw() shows it later
+  void setVisible(bool visible) { _visible = visible; }
+  bool visible(void) const { return _visible; }
+ protected:
+  /* Members */
+  Display* _display;   ///< pointer to instance of display
+  bool _visible;       ///< element is on the screen
+};
+
+/*****************************************************************************    
+******************************************************************************
+    Label
+******************************************************************************
+*****************************************************************************/
+
+/* Graphic class of text on screen with options to replace and erase it. */
+template <class Display>
+class Label : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  /* Methods */
+  // constructor with text given as String
+  // take display, text, position (x, y), size, color and possibly subscript
+  // position, the text is not printed until print() is called
+  Label(Display* display, uint16_t x, uint16_t y, String name,
+        uint8_t size, uint16_t color, uint8_t subscript = 0,
+        uint8_t alignment=TOP|LEFT);
+  // constructor where text is a value given as uint16_t
+  Label(Display* display, uint16_t x, uint16_t y, uint16_t val,
+        uint8_t size, uint16_t color, uint8_t alignment=TOP|LEFT);
+  // constructor where text is a value given as float
+  Label(Display* display, uint16_t x, uint16_t y, float val,
+        uint8_t size, uint16_t color, uint8_t alignment=TOP|LEFT);
+  // empty default constructor
+  Label(void) : _font(NULL) {}
+
+  // print the text at the with size and color at position
+  // with a font set, the background of the text is drawn as well
+  void print(void);
+  // take smallest rectangle covering the text and fill it with the given color
+  void erase(uint16_t color) const;
+  // width and height of the text in pixels
+  int16_t width(void) const;
+  int16_t height(void) const;
+  // text of the Label
+  const String& text(void) const { return _name; }
+
+  /* the following methods only change the internal value, make sure to erase
+   * the Label before and print it afterwards to make change visible */
+  // change the position of the Label
+  void changePosition(int16_t x, int16_t y, uint8_t alignment=TOP|LEFT);
+  // change the text of the Label
+  void changeName(String name, uint8_t subscript = 0);
+  void changeName(uint16_t val);
+  void changeName(float val);
+  // draw text with the given pre-rasterized font on the given background
+  // color, if font is NULL, does not match the textsize or a char is missing
+  // use the built-in font
+  void changeFont(const Font* font, uint16_t background);
+  // change the background color used with a pre-rasterized font
+  void changeBackground(uint16_t background);
+
+  // replace the text on the display, with a pre-rasterized font only glyphs
+  // that changed and uncovered parts of the old text are drawn, otherwise
+  // it is the same as erase(), changeName() and print(). Without draw it is
+  // the same as changeName(), e.g. for elements not shown
+  void refresh(String name, bool draw = true);
+
+ private:
+  /* Methods */
+  // adjust anchor of text according to vertical alignment
+  void correctForAlignment(void);
+  // x position of the left edge of the text according to alignment
+  int16_t left(void) const;
+  // check if text can be drawn with the pre-rasterized font
+  bool useFont(void) const;
+  // draw glyph of given char at position (x, y), call within write transaction
+  void printGlyph(uint8_t c, int16_t x, int16_t y);
+
+  /* Members */
+  int16_t _x, _y;       ///< anchor, upper left or right corner of the label
+  uint16_t _color;      ///< textcolor
+  uint8_t _size;        ///< textsize
+  String _name;         ///< actual text to be printed
+  uint8_t _subscript;   ///< index of subscripted char +1, if 0 no subscript
+  uint8_t _alignment;   ///< alignment of text
+  const Font* _font;    ///< pre-rasterized font, NULL for built-in font
+  uint16_t _background; ///< background color of pre-rasterized font
+};
+
+/*****************************************************************************    
+******************************************************************************
+    ValueBar
+******************************************************************************
+*****************************************************************************/
+
+/* Class to draw colored bars with a name, a value and an unit. */
+template <class Display>
+class ValueBar : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+  using Graphics<Display>::_visible;
+
+ public:
+  /* Methods */
+  ValueBar(Display* display, const Layout::ValueBarLayout& layout,
+           uint16_t color, uint16_t textColor, String name, String unit,
+           uint8_t subscript = 0);
+
+  // overdraw shape width given color
+  void erase(uint16_t color) const;
+  // draw background and reprint all labels
+  void draw(void);
+  // change the background color and reprint using draw()
+  void changeColor(uint16_t color);
+  // change the value label
+  void refreshValue(uint16_t val);
+  void refreshValue(float val);
+  // replace the note below the name, empty to remove it
+  void refreshNote(String note);
+  // position and dimensions of the bar
+  const Layout::Rect& rect(void) const { return _rect; }
+
+ private:
+  /* Methods */
+  // print the background shape
+  void drawBackground(void) const;
+  
+  /* Members */
+  Layout::Rect _rect;         ///< position and dimensions of the bar
+  uint16_t _color;            ///< backround color of the bar
+  Label<Display> _labels[3];  ///< 3 labels: name, value and unit
+  Label<Display> _note;       ///< small note below the name
+};
+
+/*****************************************************************************    
+******************************************************************************
+    HeaderBar
+******************************************************************************
+*****************************************************************************/
+
+/* Class to draw a header bar showing a logo, time and date. */
+template <class Display>
+class HeaderBar : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  /* Methods */
+  HeaderBar(Display* display, SDClass& sd,
+            const Layout::HeaderBarLayout& layout, uint16_t color,
+            uint16_t textColor, const char* logoFile);
+  
+  // draw background and reprint date and time labels
+  void draw(void);
+  // show the given time on the display
+  void updateTime(DateTime time);
+  // show the given date on the display
+  void updateDate(DateTime date);
+  // return the height of the bar
+  int16_t height(void) const;
+  
+ private:
+  /* Methods */
+  // draw the background shape including the logo
+  void drawBackground(void) const;
+  
+  /* Members */
+  Layout::Rect _rect;     ///< position and dimensions of the bar
+  Layout::Point _logo;    ///< upper left corner of the logo
+  uint16_t _color;        ///< backround color of the bar
+  SDClass& _sd;           ///< SD card the logo is read from
+  const char* _logoFile;  ///< filename of the logo to draw
+  Label<Display> _date;   ///< label to show time
+  Label<Display> _time;   ///< label to show date
+};
+
+/*****************************************************************************    
+******************************************************************************
+    ExposureBar
+******************************************************************************
+*****************************************************************************/
+
+/* Class to draw a bar with the minutes spent above three CO2 levels, each
+ * behind a swatch of the color of the level, and the time since the last
+ * ventilation. Only changed digits are drawn on refresh(). */
+template <class Display>
+class ExposureBar : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+  using Graphics<Display>::_visible;
+
+ public:
+  /* Methods */
+  // takes the colors of the three levels in ascending order
+  ExposureBar(Display* display, const Layout::ExposureBarLayout& layout,
+              uint16_t color, uint16_t textColor,
+              const uint16_t levelColors[3]);
+
+  // overdraw shape width given color
+  void erase(uint16_t color) const;
+  // draw background, swatches and reprint all labels
+  void draw(void);
+  // show the minutes above each level and the minutes since the last
+  // ventilation, "-:--" if it is negative
+  void refresh(const uint16_t minutes[3], int32_t sinceVentilation);
+  // position and dimensions of the bar
+  const Layout::Rect& rect(void) const { return _rect; }
+
+ private:
+  /* Members */
+  Layout::Rect _rect;             ///< position and dimensions of the bar
+  Layout::Rect _swatch[3];        ///< swatches of the levels
+  uint16_t _color;                ///< backround color of the bar
+  uint16_t _levelColors[3];       ///< colors of the levels
+  Label<Display> _minutes[3];     ///< minutes above each level
+  Label<Display> _unit;           ///< unit of the minutes
+  Label<Display> _caption;        ///< caption of the time since ventilation
+  Label<Display> _ventilation;    ///< time since ventilation as h:mm
+};
+
+/*****************************************************************************    
+******************************************************************************
+    TrendGraph
+******************************************************************************
+*****************************************************************************/
+
+/* Class to draw the CO2 of the last hours as a curve, with lines at the CO2
+ * levels in their colors. The values are collected into points of their
+ * mean, the last Layout::GRAPH_POINTS points are kept. The curve is
+ * erased by drawing it again in the color of the background, so a new
+ * point costs a few hundred pixels instead of the whole plot. */
+template <class Display>
+class TrendGraph : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+  using Graphics<Display>::_visible;
+
+ public:
+  /* Methods */
+  // takes the CO2 at the bottom of the plot, the three levels drawn and
+  // their colors in ascending order and the seconds each point stands for
+  TrendGraph(Display* display, const Layout::GraphLayout& layout,
+             uint16_t color, uint16_t textColor, uint16_t bottom,
+             const uint16_t levels[3], const uint16_t levelColors[3],
+             uint16_t step);
+
+  // overdraw shape width given color
+  void erase(uint16_t color) const;
+  // draw background, title and the curve
+  void draw(void);
+  // draw title and curve on the background already there
+  void drawContent(void);
+  // erase title and curve by drawing them in the color of the background
+  void clear(void);
+  // add a value to the point collected
+  void add(uint16_t co2);
+  // finish the point collected with the mean of the values added and move
+  // the curve. Without values the point is left out
+  void close(void);
+
+ private:
+  /* Methods */
+  // draw scale, level lines and curve, all in the color of the background
+  // to erase them
+  void paint(bool erase);
+  // y position of a CO2 value in the plot, clipped to it
+  int16_t y(uint16_t co2) const;
+
+  /* Members */
+  Layout::Rect _rect;             ///< position and dimensions of the panel
+  Layout::Rect _plot;             ///< area of the curve
+  int16_t _scale;                 ///< right edge of the scale
+  uint16_t _color, _textColor;    ///< color of background and text
+  uint16_t _levels[3];            ///< CO2 levels with a line
+  uint16_t _levelColors[3];       ///< colors of their lines
+  Label<Display> _title;          ///< title with the time shown
+  Label<Display> _axis[2];        ///< captions of the ends of the time axis
+  uint16_t _points[Layout::GRAPH_POINTS]; ///< ring of the points in ppm
+  uint16_t _head;                 ///< index of the next point
+  uint16_t _count;                ///< number of points
+  uint32_t _sum;                  ///< sum of the values of the next point
+  uint16_t _values;               ///< number of values added to it
+  uint16_t _bottom, _top;         ///< ppm at the edges of the plot
+};
+
+/*****************************************************************************    
+******************************************************************************
+    TextPanel
+******************************************************************************
+*****************************************************************************/
+
+/* Class to print a title and Layout::PANEL_LINES lines of text below it on a
+ * colored panel. Lines are redrawn only if their text changed. */
+template <class Display>
+class TextPanel : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+  using Graphics<Display>::_visible;
+
+ public:
+  /* Methods */
+  TextPanel(Display* display, const Layout::TextPanelLayout& layout,
+            uint16_t color, uint16_t textColor, String title,
+            uint8_t subscript = 0);
+
+  // overdraw shape width given color
+  void erase(uint16_t color) const;
+  // draw background, title and all lines
+  void draw(void);
+  // draw title and lines on the background already there
+  void drawContent(void);
+  // erase title and lines, the background stays
+  void clear(void);
+  // draw this panel where the given one of the same layout and color is
+  // shown, only the title and lines that differ are drawn
+  void drawOver(const TextPanel& shown);
+  // replace the line with given index, drawn if the text changed
+  void refreshLine(uint8_t line, String text);
+
+ private:
+  /* Members */
+  Layout::Rect _rect;                       ///< position and dimensions
+  uint16_t _color;                          ///< backround color
+  Label<Display> _title;                    ///< title above the lines
+  Label<Display> _lines[Layout::PANEL_LINES]; ///< lines of text
+};
+
+/* Class to print out information about a pending calibration. */
+template <class Display>
+class CalibrationWarning : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  CalibrationWarning(Display* display, const Layout::Rect& rect,
+                     uint16_t color, uint16_t textColor);
+  
+  // draw new background shape and print calibration warning
+  void print(void);
+  // overdraw shape width given color
+  void erase(uint16_t color) const;
+  // set time for calibration to be executed
+  void setCalibrationTime(DateTime time);
+  // get the time calibration is scheduled for
+  DateTime getCalibrationTime(void) const;
+  // update the countdown till calibration with new time
+  void refreshCountdown(DateTime time);
+  // update current CO2 value with new value
+  void refreshCO2(uint16_t co2);
+
+ private:
+  /* Methods */
+  // indent cursor given amount of pixels in x direction
+  inline void indent(int16_t x) const;
+  
+  /* Members */
+  Layout::Rect _rect;           ///< position and dimensions
+  uint16_t _color, _textColor;  ///< color of background and text
+  uint8_t _textsize;            ///< size of the text
+  Label<Display> _co2Name;      ///< subscripted name CO2
+  Label<Display> _co2Value;     ///< value of co2
+  Label<Display> _countdown;    ///< remaining time
+  DateTime _calibrationTime;    ///< time of calibration
+};
+
+#include "bmpDraw.h"    // used in HeaderBar
+
+/******************************************************************************    
+*******************************************************************************
+    Label
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+Label<Display>::Label(Display* display, uint16_t x, uint16_t y, String name,
+             uint8_t size, uint16_t color, uint8_t subscript, uint8_t alignment)
+    // init all members with the given values
+    : Graphics<Display>(display), _x(x), _y(y), _name(name),
+      _subscript(subscript), _size(size), _color(color), _alignment(alignment),
+      _font(NULL), _background(0) {
+  correctForAlignment();        // set position according to alignment
+  CORRECT_DEGREE_CHAR(_name);   // replace "°" with (char) 248
+}
+
+// ____________________________________________________________________________
+template <class Display>
+Label<Display>::Label(Display* display, uint16_t x, uint16_t y, uint16_t val,
+             uint8_t size, uint16_t color, uint8_t alignment)
+  // convert value in String with decimal representation, if 0 use " " instead
+  : Label(display, x, y, (val > 0 ? String(val, DEC) : " "), size, color, 0, alignment) {
+}
+
+// ____________________________________________________________________________
+template <class Display>
+Label<Display>::Label(Display* display, uint16_t x, uint16_t y, float val,
+             uint8_t size, uint16_t color, uint8_t alignment)
+  // convert value in String with two decimal places, if 0 use " " instead
+  : Label(display, x, y, (val > 0 ? String(val, 2) : " "), size, color, 0, alignment) {
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::print(void) {
+  if (useFont()) {
+    // send the glyphs of all chars in one transaction
+    _display->startWrite();
+    for (uint16_t i = 0; i < _name.length(); i++) {
+      printGlyph(_name[i], left() + i * _font->width, _y);
+    }
+    _display->endWrite();
+    return;
+  }
+  _display->setCursor(left(), _y);  // set position, color and size
+  _display->setTextSize(_size);     // of the text to be printed according
+  _display->setTextColor(_color);   // to members given in constructor
+  if (_subscript) {
+    // if a letter is subscripted, print text until subscripted char
+    _display->print(_name.substring(0, _subscript - 1));
+    int16_t x = _display->getCursorX();       // get cursor position
+    int16_t y = _display->getCursorY();
+    uint16_t h = 8 * _size;                   // text is (6x8)*textsize pixels
+    _display->setCursor(x, y + h/2);          // move cursor half text height down
+    _display->setTextSize(_size - 1);         // reduce text size by 1
+    _display->print(_name[_subscript - 1]);   // print subscripted char
+    x = _display->getCursorX();               // get new x cursor position
+    _display->setCursor(x, y);                // move cursor to initial height
+    _display->setTextSize(_size);             // set original text size
+    _display->print(_name.substring(_subscript));   // print rest of string
+  } else {
+    // if no letter is subscripted just print the text
+    _display->print(_name);
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::erase(uint16_t color) const {
+  // fill the rectangle covering all text with the given color
+  _display->fillRect(left(), _y, width(), height(), color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+int16_t Label<Display>::width(void) const {
+  // number of chars times size times char width is string width in pixels
+  int16_t w = _name.length() * _size * CHAR_W;
+  if (_subscript) {
+    w -= CHAR_W;  // subscripted char is one size and thus one char width smaller
+  }
+  return w;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+int16_t Label<Display>::height(void) const {
+  if (_subscript) {
+    // subscripted char starts at half of the text height and is one size less
+    return _size * CHAR_H / 2 + (_size - 1) * CHAR_H;
+  }
+  return _size * CHAR_H;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changePosition(int16_t x, int16_t y, uint8_t alignment) {
+  _x = x;
+  _y = y;
+  _alignment = alignment;
+  correctForAlignment();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changeName(String name, uint8_t subscript) {
+  CORRECT_DEGREE_CHAR(name);  // replace "°" with (char) 248
+  _name = name;             // set new name
+  _subscript = subscript;   // set new subscript
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changeName(uint16_t val) {
+  // convert to string and call changeName()
+  changeName(String(val, DEC));
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changeName(float val) {
+  // convert to string and call changeName()
+  changeName(String(val, 2));
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changeFont(const Font* font, uint16_t background) {
+  _font = font;
+  _background = background;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::changeBackground(uint16_t background) {
+  _background = background;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::refresh(String name, bool draw) {
+  if (!draw) {
+    changeName(name);
+    return;
+  }
+  CORRECT_DEGREE_CHAR(name);  // replace "°" with (char) 248
+  if (!useFont() || !containsGlyphs(_font, name)) {
+    // no pre-rasterized font, redraw the whole text
+    erase(_background);
+    changeName(name);
+    print();
+    return;
+  }
+  // remember where the old text was
+  String old = _name;
+  int16_t oldLeft = left();
+  int16_t oldRight = oldLeft + width();
+  _name = name;
+  int16_t newLeft = left();
+  int16_t newRight = newLeft + width();
+
+  _display->startWrite();
+  // clear parts of the old text not covered by the new one
+  if (oldLeft < newLeft) {
+    _display->writeFillRect(oldLeft, _y, newLeft - oldLeft, height(),
+                            _background);
+  }
+  if (oldRight > newRight) {
+    _display->writeFillRect(newRight, _y, oldRight - newRight, height(),
+                            _background);
+  }
+  // draw only the glyphs that differ from the char at the same position
+  for (uint16_t i = 0; i < _name.length(); i++) {
+    int16_t x = newLeft + i * _font->width;
+    int16_t j = (x - oldLeft) / _font->width;   // index in old text
+    bool same = x >= oldLeft && (x - oldLeft) % _font->width == 0
+                && j < (int16_t) old.length() && old[j] == _name[i];
+    if (!same) {
+      printGlyph(_name[i], x, _y);
+    }
+  }
+  _display->endWrite();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+bool Label<Display>::useFont(void) const {
+  // glyphs are sent with an address window, which must be on screen
+  return _font && _font->size == _size && !_subscript
+         && left() >= 0 && _y >= 0
+         && left() + width() <= _display->width()
+         && _y + height() <= _display->height()
+         && containsGlyphs(_font, _name);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::printGlyph(uint8_t c, int16_t x, int16_t y) {
+  const Glyph* glyph = findGlyph(_font, c);
+  const uint8_t* runs = _font->runs + glyph->offset;
+  bool foreground = false;    // runs start with background
+  _display->setAddrWindow(x, y, _font->width, _font->height);
+  for (uint16_t i = 0; i < glyph->length; i++) {
+    if (runs[i]) {
+      _display->writeColor(foreground ? _color : _background, runs[i]);
+    }
+    foreground = !foreground;
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Label<Display>::correctForAlignment(void) {
+  if ((_alignment & BOTTOM) == BOTTOM) {
+    // size times char height is string height in pixels
+    _y -= _size * CHAR_H;
+  }
+  // nothing to do for alignment TOP, as that is default of the display
+  // alignment RIGHT depends on the text and is resolved on print by left()
+}
+
+// ____________________________________________________________________________
+template <class Display>
+int16_t Label<Display>::left(void) const {
+  if ((_alignment & RIGHT) == RIGHT) {
+    return _x - width();
+  }
+  return _x;
+}
+
+/******************************************************************************
+*******************************************************************************    
+    ValueBar
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+ValueBar<Display>::ValueBar(Display* display,
+                            const Layout::ValueBarLayout& layout,
+                            uint16_t color, uint16_t textColor,
+                            String name, String unit, uint8_t subscript)
+    // init all members with the given values
+    : Graphics<Display>(display), _rect(layout.bar), _color(color) {
+  // init all labels at the positions given by the layout,
+  // with given name and unit in given textcolor, value empty
+  _labels[0] = Label<Display>(display, layout.name.x, layout.name.y, name,
+                              layout.size-1, textColor, subscript);
+  _labels[1] = Label<Display>(display, layout.value.x, layout.value.y, " ",
+                              layout.size, textColor, 0, RIGHT);
+  _labels[2] = Label<Display>(display, layout.unit.x, layout.unit.y, unit,
+                              layout.size-1, textColor);
+  _note = Label<Display>(display, layout.note.x, layout.note.y, "",
+                         Layout::NOTE_SIZE, textColor);
+  _note.changeBackground(_color);   // erased with the color on refresh
+  // value and unit are drawn with pre-rasterized fonts if available
+  _labels[1].changeFont(bigFont(layout.size), _color);
+  _labels[2].changeFont(bigFont(layout.size-1), _color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::drawBackground(void) const {
+  // draw the background shape
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, _color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::erase(uint16_t color) const {
+  // overdraw the background shape with given color
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::draw(void) {
+  drawBackground();     // draw the background shape
+  _labels[0].print();   // print name,
+  _labels[1].print();   // value
+  _labels[2].print();   // and unit
+  _note.print();        // below the name
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::changeColor(uint16_t color) {
+  if (color != _color) {  // if color is diffrent from current color
+    _color = color;       // set new color
+    for (uint8_t i = 0; i < 3; i++) {
+      _labels[i].changeBackground(color);
+    }
+    _note.changeBackground(color);
+    if (_visible) draw(); // redraw with new color
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::refreshValue(uint16_t val) {
+  _labels[1].refresh(String(val, DEC), _visible);  // draw changes
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::refreshValue(float val) {
+  _labels[1].refresh(String(val, 2), _visible);    // draw changes
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ValueBar<Display>::refreshNote(String note) {
+  _note.refresh(note, _visible);  // built-in font, erases the old note
+}
+
+/******************************************************************************
+*******************************************************************************    
+    HeaderBar
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+HeaderBar<Display>::HeaderBar(Display* display, SDClass& sd,
+                              const Layout::HeaderBarLayout& layout,
+                              uint16_t color, uint16_t textColor,
+                              const char* logoFile)
+    // init all members with the given values
+    : Graphics<Display>(display), _rect(layout.bar), _logo(layout.logo),
+      _color(color), _sd(sd), _logoFile(logoFile) {
+  // init labels at the positions given by the layout
+  _date = Label<Display>(display, layout.date.x, layout.date.y, (uint16_t) 0,
+                         layout.size-1, textColor, RIGHT);
+  _time = Label<Display>(display, layout.time.x, layout.time.y, (uint16_t) 0,
+                         layout.size, textColor);
+  // time and date are drawn with pre-rasterized fonts if available
+  _date.changeFont(bigFont(layout.size-1), _color);
+  _time.changeFont(bigFont(layout.size), _color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void HeaderBar<Display>::draw(void) {
+  drawBackground();
+  _time.print();
+  _date.print();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void HeaderBar<Display>::updateTime(DateTime time) {
+  _time.refresh(dig2(time.hour()) + ':' + dig2(time.minute()));
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void HeaderBar<Display>::updateDate(DateTime date) {
+  _date.refresh(dig2(date.day()) + '.'
+                + dig2(date.month()) + '.'
+                + date.year());
+}
+
+// ____________________________________________________________________________
+template <class Display>
+int16_t HeaderBar<Display>::height(void) const {
+  return _rect.h;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void HeaderBar<Display>::drawBackground(void) const {
+  _display->fillRect(_rect.x, _rect.y, _rect.w, _rect.h, _color);
+  bmpReader<Display>(_display, _sd).draw(_logoFile, _logo.x, _logo.y);
+}
+
+/******************************************************************************
+*******************************************************************************    
+    ExposureBar
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+ExposureBar<Display>::ExposureBar(Display* display,
+                                  const Layout::ExposureBarLayout& layout,
+                                  uint16_t color, uint16_t textColor,
+                                  const uint16_t levelColors[3])
+    // init all members with the given values
+    : Graphics<Display>(display), _rect(layout.bar), _color(color) {
+  // init all labels at the positions given by the layout, values empty
+  for (uint8_t i = 0; i < 3; i++) {
+    _swatch[i] = layout.swatch[i];
+    _levelColors[i] = levelColors[i];
+    _minutes[i] = Label<Display>(display, layout.minutes[i].x,
+                                 layout.minutes[i].y, " ", layout.size,
+                                 textColor, 0, RIGHT);
+    _minutes[i].changeFont(bigFont(layout.size), _color);
+  }
+  _unit = Label<Display>(display, layout.unit.x, layout.unit.y, "min",
+                         layout.size, textColor);
+  _caption = Label<Display>(display, layout.caption.x, layout.caption.y,
+                            "vent.", layout.size, textColor);
+  _ventilation = Label<Display>(display, layout.ventilation.x,
+                                layout.ventilation.y, " ", layout.size,
+                                textColor, 0, RIGHT);
+  _ventilation.changeFont(bigFont(layout.size), _color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ExposureBar<Display>::erase(uint16_t color) const {
+  // overdraw the background shape with given color
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ExposureBar<Display>::draw(void) {
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, _color);
+  for (uint8_t i = 0; i < 3; i++) {
+    _display->fillRoundRect(_swatch[i].x, _swatch[i].y, _swatch[i].w,
+                            _swatch[i].h, Layout::RADIUS / 2,
+                            _levelColors[i]);
+    _minutes[i].print();
+  }
+  _unit.print();
+  _caption.print();
+  _ventilation.print();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void ExposureBar<Display>::refresh(const uint16_t minutes[3],
+                                   int32_t sinceVentilation) {
+  for (uint8_t i = 0; i < 3; i++) {
+    _minutes[i].refresh(String(minutes[i], DEC), _visible);
+  }
+  if (sinceVentilation < 0) {
+    _ventilation.refresh("-:--", _visible);
+  } else {
+    // at most 99:59, as the label is sized for 5 chars
+    if (sinceVentilation > 99 * 60 + 59) sinceVentilation = 99 * 60 + 59;
+    _ventilation.refresh(String(sinceVentilation / 60, DEC) + ':'
+                         + dig2(sinceVentilation % 60), _visible);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************    
+    TrendGraph
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+TrendGraph<Display>::TrendGraph(Display* display,
+                                const Layout::GraphLayout& layout,
+                                uint16_t color, uint16_t textColor,
+                                uint16_t bottom, const uint16_t levels[3],
+                                const uint16_t levelColors[3], uint16_t step)
+    // init all members with the given values
+    : Graphics<Display>(display), _rect(layout.panel), _plot(layout.plot),
+      _scale(layout.scale), _color(color), _textColor(textColor),
+      _head(0), _count(0), _sum(0), _values(0), _bottom(bottom),
+      _top(levels[2]) {
+  for (uint8_t i = 0; i < 3; i++) {
+    _levels[i] = levels[i];
+    _levelColors[i] = levelColors[i];
+  }
+  // whole hours shown, e.g. "CO2 of the last 3 h"
+  uint16_t hours = (uint32_t) Layout::GRAPH_POINTS * step / 3600;
+  _title = Label<Display>(display, layout.title.x, layout.title.y,
+                          "CO2 of the last " + String(hours, DEC) + " h",
+                          layout.size, textColor, 3);
+  int16_t below = _plot.y + _plot.h + 4;
+  _axis[0] = Label<Display>(display, _plot.x, below,
+                            "-" + String(hours, DEC) + " h", 1, textColor);
+  _axis[1] = Label<Display>(display, _plot.x + _plot.w, below, "now", 1,
+                            textColor, 0, RIGHT);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::erase(uint16_t color) const {
+  // overdraw the background shape with given color
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::draw(void) {
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, _color);
+  drawContent();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::drawContent(void) {
+  _title.print();
+  _axis[0].print();
+  _axis[1].print();
+  paint(false);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::clear(void) {
+  _title.erase(_color);
+  _axis[0].erase(_color);
+  _axis[1].erase(_color);
+  paint(true);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::add(uint16_t co2) {
+  _sum += co2;
+  _values++;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::close(void) {
+  if (_values == 0) return;
+  if (_visible) paint(true);    // erase the curve as it is before the point
+  _points[_head] = (_sum + _values / 2) / _values;
+  _head = (_head + 1) % Layout::GRAPH_POINTS;
+  if (_count < Layout::GRAPH_POINTS) _count++;
+  _sum = 0;
+  _values = 0;
+  // the plot reaches above the highest point in steps of 500 ppm
+  uint16_t highest = _levels[2];
+  for (uint16_t i = 0; i < _count; i++) {
+    highest = max(highest, _points[i]);
+  }
+  _top = (highest + 499) / 500 * 500;
+  if (_visible) paint(false);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TrendGraph<Display>::paint(bool erase) {
+  // scale with the levels, the plot with their lines. Text is drawn
+  // without background, so drawing it again in _color erases it
+  _display->setTextSize(1);
+  _display->setTextColor(erase ? _color : _textColor);
+  for (uint8_t i = 0; i < 3; i++) {
+    int16_t level = y(_levels[i]);
+    _display->drawFastHLine(_plot.x, level, _plot.w,
+                            erase ? _color : _levelColors[i]);
+    String text(_levels[i], DEC);
+    _display->setCursor(_scale - Layout::textWidth(text.length(), 1),
+                        level - CHAR_H / 2);
+    _display->print(text);
+  }
+  if (_top > _levels[2]) {
+    String text(_top, DEC);
+    _display->setCursor(_scale - Layout::textWidth(text.length(), 1),
+                        _plot.y - CHAR_H / 2);
+    _display->print(text);
+  }
+
+  // curve from the oldest point on the left to the newest on the right
+  uint16_t first = (_head + Layout::GRAPH_POINTS - _count)
+                   % Layout::GRAPH_POINTS;
+  int16_t x = _plot.x + _plot.w - _count * Layout::GRAPH_DX;
+  int16_t last = -1;
+  for (uint16_t i = 0; i < _count; i++) {
+    int16_t next = y(_points[(first + i) % Layout::GRAPH_POINTS]);
+    if (last >= 0) {
+      _display->drawLine(x - Layout::GRAPH_DX, last, x, next,
+                         erase ? _color : _textColor);
+    }
+    last = next;
+    x += Layout::GRAPH_DX;
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+int16_t TrendGraph<Display>::y(uint16_t co2) const {
+  co2 = constrain(co2, _bottom, _top);
+  return _plot.y + _plot.h - 1
+         - (int32_t) (co2 - _bottom) * (_plot.h - 1) / (_top - _bottom);
+}
+
+/******************************************************************************
+*******************************************************************************    
+    TextPanel
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+TextPanel<Display>::TextPanel(Display* display,
+                              const Layout::TextPanelLayout& layout,
+                              uint16_t color, uint16_t textColor,
+                              String title, uint8_t subscript)
+    // init all members with the given values
+    : Graphics<Display>(display), _rect(layout.panel), _color(color) {
+  _title = Label<Display>(display, layout.title.x, layout.title.y, title,
+                          layout.size, textColor, subscript);
+  for (uint8_t i = 0; i < Layout::PANEL_LINES; i++) {
+    _lines[i] = Label<Display>(display, layout.text.x,
+                               layout.text.y + i * layout.pitch, "",
+                               layout.size, textColor);
+    _lines[i].changeBackground(_color);   // erased with the color on refresh
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::erase(uint16_t color) const {
+  // overdraw the background shape with given color
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::draw(void) {
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, _color);
+  drawContent();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::drawContent(void) {
+  _title.print();
+  for (uint8_t i = 0; i < Layout::PANEL_LINES; i++) {
+    _lines[i].print();
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::clear(void) {
+  _title.erase(_color);
+  for (uint8_t i = 0; i < Layout::PANEL_LINES; i++) {
+    _lines[i].erase(_color);
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::drawOver(const TextPanel& shown) {
+  // a line of the same text is left as it is
+  if (shown._title.text() != _title.text()) {
+    shown._title.erase(_color);
+    _title.print();
+  }
+  for (uint8_t i = 0; i < Layout::PANEL_LINES; i++) {
+    if (shown._lines[i].text() != _lines[i].text()) {
+      shown._lines[i].erase(_color);
+      _lines[i].print();
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void TextPanel<Display>::refreshLine(uint8_t line, String text) {
+  CORRECT_DEGREE_CHAR(text);  // compared with the corrected text
+  if (line >= Layout::PANEL_LINES || text == _lines[line].text()) return;
+  _lines[line].refresh(text, _visible);
+}
+
+/******************************************************************************
+*******************************************************************************    
+    CalibrationWarning
+*******************************************************************************
+******************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+CalibrationWarning<Display>::CalibrationWarning(
+  Display* display, const Layout::Rect& rect, uint16_t color, uint16_t textColor
+) : Graphics<Display>(display), _rect(rect), _color(color),
+    _textColor(textColor), _textsize(2) {
+  // labels are positioned on print(), init with correct length
+  _co2Name = Label<Display>(display, 0, 0, "CO2", _textsize, textColor, 3);
+  _co2Value = Label<Display>(display, 0, 0, "    ", _textsize, textColor);
+  _countdown = Label<Display>(display, 0, 0, "     ", _textsize, textColor);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::print(void) {
+  // draw background and caption in higher size in the upper center
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, _color);
+  _display->setTextColor(_textColor);
+  _display->setTextSize(_textsize+1);
+  _display->setCursor(
+    _rect.x + Layout::center(_rect.w, Layout::textWidth(12, _textsize+1)),
+    _rect.y + 10
+  );
+  _display->println("Calibration!");
+  _display->setTextSize(_textsize);
+  _display->println();
+
+  int16_t x0 = _rect.x + 10;  // get starting x position of each line
+  
+  // print instructions on same indent level
+  indent(x0);   _display->println("Place device outdoors now!");
+  indent(x0);   _display->println("When timer is up, last measured");
+  indent(x0);   _display->println("value is set to 417 ppm.");
+  indent(x0);   _display->println("Thus sensor must have acclimated");
+  indent(x0);   _display->println("to ambient air.");
+                _display->println();
+  indent(x0);   _display->println("To abort calibration hold the");
+  indent(x0);   _display->println("button on the backside again.");
+                _display->println();
+
+  // set position of remaining time label
+  indent(x0);   _display->print("Remaining time: ");
+  _countdown.changePosition(_display->getCursorX(), _display->getCursorY());
+  _countdown.print();                   // must be init with final size (5 chars)
+  int16_t x = _display->getCursorX();   // remember x-pos after countdown
+  _display->println();
+
+  // set position of CO2 label
+  indent(x0);   _display->print("Current ");
+  _co2Name.changePosition(_display->getCursorX(), _display->getCursorY());
+  _co2Name.print();
+  _display->print(": ");
+  // use x pos right of countdown to place CO2 label and unit
+  _co2Value.changePosition(x, _display->getCursorY(), RIGHT);
+  indent(x);    _display->print(" ppm ");
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::erase(uint16_t color) const {
+  _display->fillRoundRect(_rect.x, _rect.y, _rect.w, _rect.h,
+                          Layout::RADIUS, color);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::setCalibrationTime(DateTime time) {
+  _calibrationTime = time;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+DateTime CalibrationWarning<Display>::getCalibrationTime(void) const {
+  return _calibrationTime;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::refreshCountdown(DateTime time) {
+  TimeSpan remaining = _calibrationTime - time;
+  _countdown.erase(_color);
+  _countdown.changeName(dig2(remaining.minutes()) + ':'
+                        + dig2(remaining.seconds()));
+  _countdown.print();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::refreshCO2(uint16_t val) {
+  _co2Value.erase(_color);
+  _co2Value.changeName(val);
+  _co2Value.print();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void CalibrationWarning<Display>::indent(int16_t x) const {
+  _display->setCursor(x, _display->getCursorY());
+}
+
 #endif  // _GRAPHICS__H_
\ No newline at end of file
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * 
+ * Geometry of all graphic elements on the screen.
+ * 
+ * A declarative description of the screen layout. All rectangles of the
+ * widgets and the anchor points of their texts are derived from the panel
+ * resolution and rotation by constexpr functions, so they are evaluated at
+ * compile time and end up as constants in flash. To use a panel of another
+ * size or orientation change PANEL_WIDTH, PANEL_HEIGHT and PANEL_ROTATION
+ * and recompile.
+ * 
+ * Text anchors are given as upper left corner of the text, except for
+ * labels aligned RIGHT, where x is the right edge of the text. Alignment
+ * at the bottom is already resolved here.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _LAYOUT__H_
+#define _LAYOUT__H_
+
+#include <Arduino.h>
+
+// dimensions of charaters in pixels
+// characters on screen have these dimensions times the textsize
+#define CHAR_W  6
+#define CHAR_H  8
+
+/* Panel, resolution as given by the display driver in rotation 0 */
+#define PANEL_WIDTH     320   ///< native width of the HX8357
+#define PANEL_HEIGHT    480   ///< native height of the HX8357
+#define PANEL_ROTATION  1     ///< rotation passed to setRotation()
+
+namespace Layout {
+
+/* Types */
+// rectangle on the screen
+struct Rect {
+  int16_t x, y;   ///< upper left corner
+  int16_t w, h;   ///< width and height
+};
+
+// single point on the screen, e.g. anchor of a text
+struct Point {
+  int16_t x, y;
+};
+
+// geometry of a ValueBar
+struct ValueBarLayout {
+  Rect bar;         ///< background shape
+  Point name;       ///< upper left corner of the name
+  Point value;      ///< upper right corner of the value
+  Point unit;       ///< upper left corner of the unit
+  Point note;       ///< upper left corner of the note below the name
+  uint8_t size;     ///< textsize of the value, name and unit are one smaller
+};
+
+// geometry of the HeaderBar
+struct HeaderBarLayout {
+  Rect bar;         ///< background shape
+  Point logo;       ///< upper left corner of the logo
+  Point time;       ///< upper left corner of the time
+  Point date;       ///< upper right corner of the date
+  uint8_t size;     ///< textsize of the time, date is one smaller
+};
+
+// geometry of the ExposureBar
+struct ExposureBarLayout {
+  Rect bar;           ///< background shape
+  Rect swatch[3];     ///< color samples of the CO2 levels
+  Point minutes[3];   ///< upper right corner of the minutes above the levels
+  Point unit;         ///< upper left corner of the unit of the minutes
+  Point caption;      ///< upper left corner of the caption of the time
+  Point ventilation;  ///< upper right corner of the time since ventilation
+  uint8_t size;       ///< textsize of all labels
+};
+
+// geometry of a TextPanel
+struct TextPanelLayout {
+  Rect panel;       ///< background shape
+  Point title;      ///< upper left corner of the title
+  Point text;       ///< upper left corner of the first line
+  int16_t pitch;    ///< distance of the lines
+  uint8_t size;     ///< textsize of title and lines
+};
+
+// geometry of a TrendGraph
+struct GraphLayout {
+  Rect panel;       ///< background shape
+  Point title;      ///< upper left corner of the title
+  Rect plot;        ///< area of the curve
+  int16_t scale;    ///< right edge of the labels of the scale
+  uint8_t size;     ///< textsize of the title, the scale is size 1
+};
+
+/* Helper functions */
+// width in pixels of a text of given length and size
+constexpr int16_t textWidth(uint8_t chars, uint8_t size) {
+  return chars * size * CHAR_W;
+}
+
+// height in pixels of a text of given size
+constexpr int16_t textHeight(uint8_t size) {
+  return size * CHAR_H;
+}
+
+// offset that centers an element of given size in the given space
+constexpr int16_t center(int16_t space, int16_t size) {
+  return (space - size) / 2;
+}
+
+/* Screen */
+// rotations 1 and 3 are landscape, width and height of the panel swap
+constexpr int16_t SCREEN_W = (PANEL_ROTATION & 1) ? PANEL_HEIGHT : PANEL_WIDTH;
+constexpr int16_t SCREEN_H = (PANEL_ROTATION & 1) ? PANEL_WIDTH : PANEL_HEIGHT;
+
+constexpr int16_t MARGIN  = 20;   ///< distance of the bars to the sides
+constexpr int16_t SPACING = 9;    ///< vertical distance between the bars
+constexpr int16_t RADIUS  = 10;   ///< radius of rounded corners
+
+/* Startup screen */
+constexpr uint8_t TITLE_SIZE  = 4;    ///< textsize of the title
+constexpr uint8_t TITLE_CHARS = 10;   ///< "CO2FreiMon", '2' is subscripted
+constexpr int16_t LOGO_BIG_W  = 460;  ///< dimensions of the big logo
+constexpr int16_t LOGO_BIG_H  = 203;
+
+constexpr Point TITLE = {
+  center(SCREEN_W, textWidth(TITLE_CHARS, TITLE_SIZE) - CHAR_W), 20
+};
+constexpr Point LOGO_BIG = {
+  10, center(SCREEN_H, LOGO_BIG_H - textHeight(TITLE_SIZE) - 20)
+};
+
+/* Header bar */
+constexpr int16_t HEADER_H   = 46;
+constexpr uint8_t HEADER_SIZE = 3;
+
+// labels share a common baseline in the vertical center of the bar
+constexpr int16_t headerBaseline(void) {
+  return (HEADER_H + textHeight(HEADER_SIZE)) / 2;
+}
+
+constexpr HeaderBarLayout HEADER = {
+  {0, 0, SCREEN_W, HEADER_H},
+  {1, 1},
+  // time "hh:mm" centered
+  {center(SCREEN_W, textWidth(5, HEADER_SIZE)),
+   headerBaseline() - textHeight(HEADER_SIZE)},
+  // date right aligned
+  {SCREEN_W - 5, headerBaseline() - textHeight(HEADER_SIZE - 1)},
+  HEADER_SIZE
+};
+
+/* Value bars, stacked below the header */
+constexpr uint8_t VALUE_BARS = 3;
+constexpr uint8_t VALUE_SIZE = 4;
+constexpr uint8_t NOTE_SIZE  = 1;     ///< textsize of the notes in the bars
+constexpr int16_t BARS_TOP = HEADER_H + 7;
+constexpr int16_t EXPOSURE_H = 28;    ///< height of the exposure bar below
+constexpr int16_t BAR_H =
+  (SCREEN_H - BARS_TOP - EXPOSURE_H - (VALUE_BARS + 1) * SPACING)
+  / VALUE_BARS;
+
+// rectangle of the value bar with given index, counted from the top
+constexpr Rect valueBarRect(uint8_t i) {
+  return Rect{MARGIN, (int16_t) (BARS_TOP + i * (BAR_H + SPACING)),
+              SCREEN_W - 2*MARGIN, BAR_H};
+}
+
+// labels of a bar share a common baseline in the vertical center of the bar
+constexpr int16_t valueBarBaseline(Rect r) {
+  return r.y + (r.h + textHeight(VALUE_SIZE)) / 2;
+}
+
+// layout of a bar and its labels: name on the left, value right aligned
+// with room for 5 digits in the center and the unit on the right. A note
+// of up to 20 chars fits below the name, left of the value
+constexpr ValueBarLayout valueBar(Rect r) {
+  return ValueBarLayout{
+    r,
+    {(int16_t) (r.x + 15),
+     (int16_t) (valueBarBaseline(r) - textHeight(VALUE_SIZE - 1))},
+    {(int16_t) (r.x + (r.w + textWidth(5, VALUE_SIZE)) / 2),
+     (int16_t) (valueBarBaseline(r) - textHeight(VALUE_SIZE))},
+    {(int16_t) (r.x + r.w - textWidth(3, VALUE_SIZE - 1) - 10),
+     (int16_t) (valueBarBaseline(r) - textHeight(VALUE_SIZE - 1))},
+    {(int16_t) (r.x + 15), (int16_t) (valueBarBaseline(r) + 6)},
+    VALUE_SIZE
+  };
+}
+
+constexpr ValueBarLayout CO2_BAR  = valueBar(valueBarRect(0));
+constexpr ValueBarLayout TEMP_BAR = valueBar(valueBarRect(1));
+constexpr ValueBarLayout RH_BAR   = valueBar(valueBarRect(2));
+
+/* Exposure bar, below the value bars */
+constexpr uint8_t EXPOSURE_SIZE = 2;
+constexpr int16_t EXPOSURE_PAD  = 10;   ///< distance of the labels to the ends
+constexpr int16_t SWATCH = textHeight(EXPOSURE_SIZE);   ///< size of swatches
+// swatch, 4 digits and a space for each of the three levels
+constexpr int16_t EXPOSURE_FIELD =
+  SWATCH + 4 + textWidth(5, EXPOSURE_SIZE);
+
+// upper edge of the labels, centered vertically in the bar
+constexpr int16_t exposureTop(Rect r) {
+  return r.y + center(r.h, textHeight(EXPOSURE_SIZE));
+}
+
+// left edge of the field of the level with given index
+constexpr int16_t exposureField(Rect r, uint8_t i) {
+  return r.x + EXPOSURE_PAD + i * EXPOSURE_FIELD;
+}
+
+// layout of the exposure bar: minutes above each level behind a swatch of
+// its color and "min" on the left, the time since the last ventilation
+// "h:mm" right aligned with its caption in front
+constexpr ExposureBarLayout exposureBar(Rect r) {
+  return ExposureBarLayout{
+    r,
+    {{exposureField(r, 0), exposureTop(r), SWATCH, SWATCH},
+     {exposureField(r, 1), exposureTop(r), SWATCH, SWATCH},
+     {exposureField(r, 2), exposureTop(r), SWATCH, SWATCH}},
+    {{(int16_t) (exposureField(r, 1) - textWidth(1, EXPOSURE_SIZE)),
+      exposureTop(r)},
+     {(int16_t) (exposureField(r, 2) - textWidth(1, EXPOSURE_SIZE)),
+      exposureTop(r)},
+     {(int16_t) (exposureField(r, 3) - textWidth(1, EXPOSURE_SIZE)),
+      exposureTop(r)}},
+    {exposureField(r, 3), exposureTop(r)},
+    {(int16_t) (r.x + r.w - EXPOSURE_PAD - textWidth(11, EXPOSURE_SIZE)),
+     exposureTop(r)},
+    {(int16_t) (r.x + r.w - EXPOSURE_PAD), exposureTop(r)},
+    EXPOSURE_SIZE
+  };
+}
+
+constexpr ExposureBarLayout EXPOSURE = exposureBar(Rect{
+  MARGIN, (int16_t) (BARS_TOP + VALUE_BARS * (BAR_H + SPACING)),
+  SCREEN_W - 2*MARGIN, EXPOSURE_H
+});
+
+/* Pages shown instead of the value and exposure bars, see Monitor */
+constexpr Rect PAGE = {
+  MARGIN, BARS_TOP, SCREEN_W - 2*MARGIN, SCREEN_H - BARS_TOP - SPACING
+};
+constexpr uint8_t PANEL_SIZE  = 2;    ///< textsize of the pages
+constexpr int16_t PANEL_PAD   = 10;   ///< distance of the text to the edges
+constexpr int16_t PANEL_TOP   = 38;   ///< distance of the text to the top
+constexpr int16_t PANEL_PITCH = 22;   ///< distance of the lines of text
+constexpr uint8_t PANEL_LINES =
+  (PAGE.h - PANEL_TOP - PANEL_PAD) / PANEL_PITCH;
+
+// page of lines of text below a title
+constexpr TextPanelLayout TEXT_PAGE = {
+  PAGE,
+  {PAGE.x + PANEL_PAD, PAGE.y + PANEL_PAD},
+  {PAGE.x + PANEL_PAD, PAGE.y + PANEL_TOP},
+  PANEL_PITCH,
+  PANEL_SIZE
+};
+
+// page of the graph of CO2, the scale left of the curve, room for the
+// captions of the time axis below
+constexpr int16_t GRAPH_DX = 2;       ///< pixels between two points
+constexpr int16_t GRAPH_LEFT = PAGE.x + PANEL_PAD + textWidth(4, 1) + 4;
+constexpr Rect GRAPH_PLOT = {
+  GRAPH_LEFT, PAGE.y + PANEL_TOP,
+  PAGE.x + PAGE.w - PANEL_PAD - GRAPH_LEFT,
+  PAGE.h - PANEL_TOP - PANEL_PAD - textHeight(1) - 4
+};
+constexpr int16_t GRAPH_POINTS = GRAPH_PLOT.w / GRAPH_DX;
+
+constexpr GraphLayout GRAPH_PAGE = {
+  PAGE,
+  {PAGE.x + PANEL_PAD, PAGE.y + PANEL_PAD},
+  GRAPH_PLOT,
+  GRAPH_LEFT - 4,
+  PANEL_SIZE
+};
+
+/* Calibration warning, covering all value bars */
+constexpr Rect CALIBRATION = {
+  MARGIN, HEADER_H + 10, SCREEN_W - 2*MARGIN, SCREEN_H - HEADER_H - 20
+};
+
+}   // namespace Layout
+
+#endif  // _LAYOUT__H_
@@ -0,0 +1,621 @@
+/******************************************************************************
+ * 
+ * Crash-consistent logging of measurement data to files on the SD card.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Logger.h"
+
+static_assert(sizeof(JournalSector) == SECTOR_SIZE,
+              "journal sector must fill exactly one sector");
+
+#define RECORD_TEXT 0x0000   ///< ring record holds text
+#define RECORD_FILE 0x8000   ///< ring record holds a file name
+#define RECORD_MARK 0x4000   ///< ring record holds the time of an index entry
+#define RECORD_DATA 0xC000   ///< ring record holds binary data
+#define RECORD_PART 0xE000   ///< ring record continues the data before
+#define RECORD_TYPE 0xE000   ///< bits of the record type
+
+// ____________________________________________________________________________
+Logger::Logger(SDClass& sd, uint8_t csPin, uint8_t csPin2, LogMode mode)
+    : _sd(sd), _mode(mode), _active(0), _mounted(NO_CARD), _migrate(NULL),
+      _head(0), _used(0) {
+  memset(_cards, 0, sizeof(_cards));
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    _cards[slot].usable = true;   // try to mount at once
+  }
+  _cards[0].pin = csPin;
+  _cards[1].pin = csPin2;
+  _directory[0] = '\0';
+  _ringFile[0] = '\0';
+}
+
+// ____________________________________________________________________________
+bool Logger::begin(void) {
+  // if SD card on display shield is not found try the other slot
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    bool mount = true;
+    if (select(slot, mount)) {
+      _active = slot;
+      return true;
+    }
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+bool Logger::append(const String& filename, const char* text,
+                    uint32_t indexTime) {
+  return add(filename, RECORD_TEXT, text, strlen(text), indexTime);
+}
+
+// ____________________________________________________________________________
+bool Logger::append(const String& filename, const void* data, uint16_t length,
+                    bool part) {
+  return add(filename, part ? RECORD_PART : RECORD_DATA, data, length, 0);
+}
+
+// ____________________________________________________________________________
+bool Logger::add(const String& filename, uint16_t type, const void* data,
+                 uint16_t length, uint32_t indexTime) {
+  if (length > PAGE_SIZE || filename.length() >= sizeof(_ringFile)) {
+    return false;
+  }
+  // the name of the file is only stored when it changes
+  if (filename != _ringFile) {
+    strcpy(_ringFile, filename.c_str());
+    push(RECORD_FILE, _ringFile, filename.length() + 1);
+  }
+  if (indexTime) push(RECORD_MARK, &indexTime, sizeof(indexTime));
+  push(type, data, length);
+  return true;
+}
+
+// ____________________________________________________________________________
+void Logger::appendStatistics(const String& filename) {
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    if (_cards[slot].pin == NO_PIN) continue;
+    const CardStats& stats = _cards[slot].stats;
+    char text[96];
+    snprintf(text, sizeof(text),
+             "# SD slot %u: %lu writes, mean %lu us, max %lu us, %lu errors\n",
+             slot + 1, (unsigned long) stats.writes,
+             (unsigned long) (stats.writes ? stats.totalMicros / stats.writes
+                                           : 0),
+             (unsigned long) stats.maxMicros, (unsigned long) stats.errors);
+    append(filename, text);
+  }
+}
+
+// ____________________________________________________________________________
+void Logger::update(bool mount) {
+  uint8_t other = 1 - _active;
+  if (!select(_active, mount)) {
+    // the other slot takes over at once if it has a card
+    if (!select(other, mount)) return;
+    if (_mode == LOG_FAILOVER) takeOver(_active, other);
+    _active = other;
+    other = 1 - _active;
+  }
+
+  if (!drain(_active)) {
+    fail(_active);
+    return;
+  }
+  release();
+
+  // move old files in the time left, while the card has nothing to write
+  if (_cards[_active].consumed == _used) migrateStep(_active);
+
+  // mirror mode: the other card is written as soon as it has a full page
+  // waiting and stays mounted until this one has a full page waiting
+  if (_mode == LOG_MIRROR && _cards[other].pin != NO_PIN
+      && _used - _cards[other].consumed >= PAGE_SIZE) {
+    _active = other;
+  }
+}
+
+// ____________________________________________________________________________
+void Logger::migrate(const char* directory) {
+  _migrate = directory;
+}
+
+// ____________________________________________________________________________
+bool Logger::select(uint8_t slot, bool& mount) {
+  LogCard& card = _cards[slot];
+  if (card.pin == NO_PIN) return false;
+  if (_mounted == slot) return true;
+  if (!card.usable) {
+    // the interval doubles with each failure, fail() counted at least one
+    uint8_t shift = min(card.failures - 1, 8);
+    uint32_t interval = min((uint32_t) REMOUNT_INTERVAL << shift,
+                            (uint32_t) REMOUNT_MAX);
+    if (!mount || millis() - card.mountTime < interval) return false;
+    mount = false;
+  }
+
+  // the SD library can only mount one card at a time
+  _journal.close();
+  _migrateDir.close();
+  _mounted = NO_CARD;
+  _directory[0] = '\0';
+  _sd.end();
+  card.mountTime = millis();
+  if (!_sd.begin(card.pin) || !openJournal(slot)) {
+    _journal.close();
+    fail(slot);
+    return false;
+  }
+  card.usable = true;
+  card.failures = 0;
+  _mounted = slot;
+  return true;
+}
+
+// ____________________________________________________________________________
+void Logger::fail(uint8_t slot) {
+  LogCard& card = _cards[slot];
+  card.usable = false;
+  card.recovered = false;
+  card.migrated = false;          // the card may have been replaced
+  card.migrateFile[0] = '\0';
+  card.mountTime = millis();
+  if (card.failures < UINT8_MAX) card.failures++;
+  card.stats.errors++;
+  if (_mounted == slot) {
+    _journal.close();
+    _migrateDir.close();
+    _mounted = NO_CARD;
+  }
+}
+
+// ____________________________________________________________________________
+void Logger::takeOver(uint8_t from, uint8_t to) {
+  LogCard& failed = _cards[from];
+  LogCard& card = _cards[to];
+  card.consumed = failed.consumed;
+  card.lost = failed.lost;
+  card.lostData = failed.lostData;
+  card.broken = failed.broken;
+  card.indexTime = failed.indexTime;
+  strcpy(card.headFile, failed.headFile);
+  // the text of the page may not have reached the failed card
+  card.page.length = 0;
+  card.page.file[0] = '\0';
+  if (failed.page.length) {
+    startPage(card, failed.page.file);
+    memcpy(card.page.payload, failed.page.payload, failed.page.length);
+    card.page.length = failed.page.length;
+    writeJournal(card);
+  }
+}
+
+// ____________________________________________________________________________
+bool Logger::tracking(uint8_t slot) const {
+  return _cards[slot].pin != NO_PIN && (_mode == LOG_MIRROR || slot == _active);
+}
+
+// ____________________________________________________________________________
+bool Logger::drain(uint8_t slot) {
+  LogCard& card = _cards[slot];
+  JournalSector& page = card.page;
+
+  // move records into the page until it is full, the page is written to
+  // the journal once and to its file at most once
+  bool added = false;
+  while (card.consumed < _used) {
+    uint16_t type = header(card.consumed) & RECORD_TYPE;
+    uint16_t length = header(card.consumed) & ~RECORD_TYPE;
+    if (type == RECORD_FILE) {
+      copy(card.consumed, card.headFile);
+      card.consumed += length + 2;
+      continue;
+    }
+    if (type == RECORD_MARK) {
+      copy(card.consumed, &card.indexTime);
+      card.consumed += length + 2;
+      continue;
+    }
+    if (type == RECORD_PART && card.broken) {
+      // the start of the data was dropped, the rest can't be read either
+      card.lostData += length;
+      card.consumed += length + 2;
+      continue;
+    }
+    if (type == RECORD_DATA) card.broken = false;
+    if (strcmp(card.headFile, page.file) != 0) {
+      // text of another file, finish the page of the last one first
+      if (added) break;
+      if (page.length && !apply(card, page)) return false;
+      startPage(card, card.headFile);
+    }
+
+    // note lines dropped before this one, only in text
+    char note[32] = "";
+    if (card.lost && type == RECORD_TEXT) {
+      snprintf(note, sizeof(note), "# %u lines lost\n", card.lost);
+    }
+    uint16_t noteLength = strlen(note);
+    if (length + noteLength > PAGE_SIZE) noteLength = 0;
+    if (page.length + noteLength + length > PAGE_SIZE) {
+      // page full, journal what was added first, then write it to its file
+      // and start the next one
+      if (added) break;
+      if (!apply(card, page)) return false;
+      page.offset += page.length;
+      page.length = 0;
+    }
+    if (card.indexTime) {
+      // position of the text is known now
+      if (!writeIndex(card, page.offset + page.length + noteLength)) {
+        return false;
+      }
+      card.indexTime = 0;
+    }
+    memcpy(page.payload + page.length, note, noteLength);
+    copy(card.consumed, page.payload + page.length + noteLength);
+    page.length += noteLength + length;
+    card.consumed += length + 2;
+    if (noteLength) card.lost = 0;
+    added = true;
+  }
+  return !added || writeJournal(card);
+}
+
+// ____________________________________________________________________________
+void Logger::release(void) {
+  uint16_t done = _used;
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    if (tracking(slot)) done = min(done, _cards[slot].consumed);
+  }
+  _head = (_head + done) % RING_SIZE;
+  _used -= done;
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    LogCard& card = _cards[slot];
+    card.consumed = card.consumed > done ? card.consumed - done : 0;
+  }
+}
+
+// ____________________________________________________________________________
+bool Logger::openJournal(uint8_t slot) {
+  LogCard& card = _cards[slot];
+  _journal = _sd.open(JOURNAL_FILE, O_READ | O_WRITE | O_CREAT);
+  if (!_journal) return false;
+  if (card.recovered) return true;
+
+  if (_journal.size() < JOURNAL_SECTORS * SECTOR_SIZE) {
+    // new journal, allocate all sectors once so later writes never change
+    // the size of the file
+    JournalSector empty;
+    memset(&empty, 0, sizeof(empty));
+    _journal.seek(0);
+    for (uint8_t i = 0; i < JOURNAL_SECTORS; i++) {
+      if (_journal.write((uint8_t*) &empty, SECTOR_SIZE) != SECTOR_SIZE) {
+        return false;
+      }
+    }
+    _journal.flush();
+  } else {
+    // find newest valid sector, sequence numbers may wrap around
+    JournalSector sector, newest;
+    bool found = false;
+    for (uint8_t i = 0; i < JOURNAL_SECTORS; i++) {
+      _journal.seek((uint32_t) i * SECTOR_SIZE);
+      if (_journal.read(&sector, SECTOR_SIZE) != SECTOR_SIZE) break;
+      if (valid(sector)
+          && (!found || (int32_t) (sector.seq - newest.seq) > 0)) {
+        memcpy(&newest, &sector, sizeof(sector));
+        found = true;
+      }
+    }
+    // write its page again, all older pages were completely written before
+    // the page was started. Numbering continues after it
+    if (found) {
+      apply(card, newest);
+      if ((int32_t) (newest.seq - card.page.seq) > 0) {
+        card.page.seq = newest.seq;
+      }
+    }
+  }
+  card.recovered = true;
+
+  // the page may hold text not journaled on this card, e.g. after the card
+  // was removed
+  return card.page.length == 0 || writeJournal(card);
+}
+
+// ____________________________________________________________________________
+void Logger::startPage(LogCard& card, const char* filename) {
+  File file = _sd.open(filename);
+  card.page.offset = file ? file.size() : 0;
+  file.close();
+  strcpy(card.page.file, filename);
+  card.page.length = 0;
+}
+
+// ____________________________________________________________________________
+bool Logger::writeJournal(LogCard& card) {
+  JournalSector& page = card.page;
+  page.magic = JOURNAL_MAGIC;
+  page.seq++;
+  page.crc = 0;
+  page.crc = crc32(&page, sizeof(page));
+
+  uint32_t start = micros();
+  _journal.seek((uint32_t) (page.seq % JOURNAL_SECTORS) * SECTOR_SIZE);
+  bool good = _journal.write((uint8_t*) &page, SECTOR_SIZE) == SECTOR_SIZE;
+  _journal.flush();
+  count(card, start);
+  return good;
+}
+
+// ____________________________________________________________________________
+File Logger::open(const char* filename, uint8_t mode) {
+  // create the directory, e.g. on a new card or for a new month, unless it
+  // is the one of the last file written
+  const char* slash = strrchr(filename, '/');
+  size_t length = slash ? slash - filename : 0;
+  if ((mode & O_WRITE) && length > 0 && length < sizeof(_directory)
+      && (strncmp(_directory, filename, length) != 0
+          || _directory[length] != '\0')) {
+    memcpy(_directory, filename, length);
+    _directory[length] = '\0';
+    if (!_sd.mkdir(_directory)) {
+      _directory[0] = '\0';
+      return File();
+    }
+  }
+  return _sd.open(filename, mode);
+}
+
+// ____________________________________________________________________________
+bool Logger::apply(LogCard& card, const JournalSector& sector) {
+  uint32_t start = micros();
+  File file = open(sector.file, O_READ | O_WRITE | O_CREAT);
+  if (!file) return false;
+  // if data before the page got lost, append the page to what is left
+  file.seek(min(sector.offset, file.size()));
+  bool good = file.write((const uint8_t*) sector.payload, sector.length)
+              == sector.length;
+  file.close();
+  count(card, start);
+  return good;
+}
+
+// ____________________________________________________________________________
+bool Logger::writeIndex(LogCard& card, uint32_t offset) {
+  // same name as the file with other extension
+  String filename = card.page.file;
+  int16_t dot = filename.lastIndexOf('.');
+  if (dot > filename.lastIndexOf('/')) filename = filename.substring(0, dot);
+  filename += "." INDEX_EXTENSION;
+
+  uint32_t entry[2] = {card.indexTime, offset};   // little endian on SAMD21
+  uint32_t start = micros();
+  File file = open(filename.c_str(), FILE_WRITE);
+  if (!file) return false;
+  bool good = file.write((const uint8_t*) entry, sizeof(entry))
+              == sizeof(entry);
+  file.close();
+  count(card, start);
+  return good;
+}
+
+// ____________________________________________________________________________
+void Logger::migrateStep(uint8_t slot) {
+  LogCard& card = _cards[slot];
+  if (!_migrate || card.migrated) return;
+  String directory = String(_migrate) + '/';
+
+  if (!card.migrateFile[0]) {
+    // look for the next file named YY-MM-DD.ext after the one found last,
+    // the directory is read to its end once per mount
+    if (!_migrateDir) _migrateDir = _sd.open(_migrate);
+    if (!_migrateDir) {
+      card.migrated = true;
+      return;
+    }
+    while (!card.migrateFile[0]) {
+      File entry = _migrateDir.openNextFile();
+      if (!entry) {
+        card.migrated = true;
+        _migrateDir.close();
+        return;
+      }
+      const char* name = entry.name();
+      bool old = !entry.isDirectory() && strlen(name) == 12
+                 && name[2] == '-' && name[5] == '-' && name[8] == '.';
+      for (uint8_t i = 0; i < 8 && old; i++) {
+        if (i % 3 != 2 && !isdigit(name[i])) old = false;
+      }
+      if (old && !busy((directory + name).c_str())) {
+        strcpy(card.migrateFile, name);
+      }
+      entry.close();
+    }
+    // without a free name the file stays where it is
+    if (!migrateTarget(card, directory + card.migrateFile)) {
+      card.migrateFile[0] = '\0';
+    }
+    return;
+  }
+
+  // copy some sectors, reopening the files every time is cheaper than
+  // keeping them open across the other writes and remounts
+  String source = directory + card.migrateFile;
+  File from = _sd.open(source.c_str());
+  File to = open(card.migrateTarget, O_READ | O_WRITE | O_CREAT);
+  bool good = from && to && from.seek(card.migrateOffset)
+              && to.seek(card.migrateOffset);
+  uint8_t buffer[SECTOR_SIZE];
+  for (uint8_t i = 0; good && i < MIGRATE_SECTORS; i++) {
+    int length = from.read(buffer, sizeof(buffer));
+    if (length <= 0) break;
+    good = to.write(buffer, length) == (size_t) length;
+    card.migrateOffset += length;
+  }
+  bool done = good && card.migrateOffset >= from.size();
+  from.close();
+  to.close();
+
+  if (!good) {
+    // try again when the card was mounted again
+    card.migrated = true;
+  } else if (done) {
+    _sd.remove(source.c_str());
+    card.migrateFile[0] = '\0';
+  }
+}
+
+// ____________________________________________________________________________
+bool Logger::migrateTarget(LogCard& card, const String& source) {
+  // YY-MM-DD.EXT to 20YY/MM/DD.ext, 8.3 names are upper case
+  const char* name = card.migrateFile;
+  char extension[4];
+  for (uint8_t i = 0; i < sizeof(extension); i++) {
+    extension[i] = tolower(name[9 + i]);
+  }
+
+  File from = _sd.open(source.c_str());
+  if (!from) return false;
+  bool found = false;
+  for (uint8_t n = 0; n < 10 && !found; n++) {
+    char suffix[4] = "";
+    if (n) snprintf(suffix, sizeof(suffix), "-%u", n);
+    snprintf(card.migrateTarget, sizeof(card.migrateTarget),
+             "%s/20%.2s/%.2s/%.2s%s.%s", _migrate, name, name + 3, name + 6,
+             suffix, extension);
+    if (busy(card.migrateTarget)) continue;
+    File to = _sd.open(card.migrateTarget);
+    if (!to) {
+      card.migrateOffset = 0;
+      found = true;
+      break;
+    }
+
+    // a copy started before a reset holds the start of the file, continue
+    // with its last sector, which may have been written partly
+    uint32_t size = to.size();
+    uint16_t compare = min(size, (uint32_t) SECTOR_SIZE);
+    found = size <= from.size() && from.seek(0);
+    uint8_t a[64], b[64];
+    for (uint16_t i = 0; found && i < compare; i += sizeof(a)) {
+      uint16_t length = min(compare - i, (int) sizeof(a));
+      found = from.read(a, length) == length && to.read(b, length) == length
+              && memcmp(a, b, length) == 0;
+    }
+    to.close();
+    card.migrateOffset = size - size % SECTOR_SIZE;
+  }
+  from.close();
+  return found;
+}
+
+// ____________________________________________________________________________
+bool Logger::busy(const char* filename) const {
+  const char* dot = strrchr(filename, '.');
+  size_t length = dot ? dot - filename : strlen(filename);
+  const char* names[] = {_cards[0].page.file, _cards[0].headFile,
+                         _cards[1].page.file, _cards[1].headFile, _ringFile};
+  for (uint8_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    if (strncasecmp(names[i], filename, length) == 0
+        && (names[i][length] == '.' || names[i][length] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+void Logger::count(LogCard& card, uint32_t start) {
+  uint32_t time = micros() - start;
+  card.stats.writes++;
+  card.stats.totalMicros += time;
+  card.stats.maxMicros = max(card.stats.maxMicros, time);
+}
+
+// ____________________________________________________________________________
+bool Logger::valid(JournalSector& sector) {
+  if (sector.magic != JOURNAL_MAGIC) return false;
+  if (sector.length > PAGE_SIZE) return false;
+  if (memchr(sector.file, '\0', sizeof(sector.file)) == NULL) return false;
+  uint32_t crc = sector.crc;
+  sector.crc = 0;
+  bool good = crc32(&sector, sizeof(sector)) == crc;
+  sector.crc = crc;
+  return good;
+}
+
+// ____________________________________________________________________________
+uint32_t Logger::crc32(const void* data, size_t length) {
+  // bitwise, saves the 1 kB of a table and is fast enough for one sector
+  const uint8_t* bytes = (const uint8_t*) data;
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+// ____________________________________________________________________________
+void Logger::push(uint16_t type, const void* data, uint16_t length) {
+  if (length + 2 > RING_SIZE) return;
+  // drop oldest records until there is space, the cards that did not get
+  // them yet keep track of their file and count the lines
+  while (RING_SIZE - _used < length + 2) {
+    uint16_t oldest = header(0) & RECORD_TYPE;
+    uint16_t size = (header(0) & ~RECORD_TYPE) + 2;
+    for (uint8_t slot = 0; slot < 2; slot++) {
+      if (!tracking(slot)) continue;
+      LogCard& card = _cards[slot];
+      if (card.consumed >= size) {
+        card.consumed -= size;
+      } else if (oldest == RECORD_FILE) {
+        copy(0, card.headFile);
+      } else if (oldest == RECORD_TEXT) {
+        card.lost++;
+      } else if (oldest != RECORD_MARK) {
+        // binary data gets no note, the parts following it are dropped too
+        card.lostData += size - 2;
+        card.broken = true;
+      }
+    }
+    _head = (_head + size) % RING_SIZE;
+    _used -= size;
+  }
+
+  uint16_t record = length | type;
+  uint16_t tail = (_head + _used) % RING_SIZE;
+  _ring[tail] = record & 0xFF;
+  _ring[(tail + 1) % RING_SIZE] = record >> 8;
+  for (uint16_t i = 0; i < length; i++) {
+    _ring[(tail + 2 + i) % RING_SIZE] = ((const uint8_t*) data)[i];
+  }
+  _used += length + 2;
+}
+
+// ____________________________________________________________________________
+uint16_t Logger::header(uint16_t offset) const {
+  uint16_t i = (_head + offset) % RING_SIZE;
+  return _ring[i] | (_ring[(i + 1) % RING_SIZE] << 8);
+}
+
+// ____________________________________________________________________________
+void Logger::copy(uint16_t offset, void* data) const {
+  uint16_t length = header(offset) & ~RECORD_TYPE;
+  uint16_t i = (_head + offset + 2) % RING_SIZE;
+  for (uint16_t n = 0; n < length; n++) {
+    ((uint8_t*) data)[n] = _ring[(i + n) % RING_SIZE];
+  }
+}
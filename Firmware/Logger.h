@@ -0,0 +1,274 @@
+/******************************************************************************
+ * 
+ * Crash-consistent logging of measurement data to files on SD cards.
+ * 
+ * Text appended to a file is first put into a ring buffer in RAM, append()
+ * never accesses a card. update(), called continiously, moves the text
+ * into a page of one sector, also in RAM. Whenever text was added the whole
+ * page is written to a write-ahead journal, together with a sequence
+ * number, the name of the file, the position of the page in that file and
+ * a CRC. Only when the page is full or another file is written, the page is
+ * appended to its file. So the FAT of the card is updated once per sector
+ * instead of once per line, and one call of update() writes at most two
+ * sectors.
+ * 
+ * If a reset or the watchdog interrupts writing a file, the newest valid
+ * sector of the journal is found when the card is mounted and its page is
+ * written again at its position in the file. This repairs a truncated last
+ * page and adds the lines not yet written to the file. The stock SD library
+ * can not truncate files, so a torn page is overwritten instead. Recovery
+ * reads only the JOURNAL_SECTORS sectors of the journal, no matter how
+ * large the card or the files are.
+ * 
+ * If there is no card or writing to it fails, the text stays in the ring
+ * buffer and the card is mounted again after REMOUNT_INTERVAL, so a card
+ * can be removed and inserted again without a reset. Mounting a missing
+ * card blocks for the 2 s timeout of the SD library, so the interval
+ * doubles with each failed attempt up to REMOUNT_MAX, at most one card is
+ * tried per update() and the caller of update() tells when a stall does
+ * no harm, e.g. right after a sample. The text collected in
+ * the meantime is written in batches of one page per update(). If the ring
+ * buffer runs full, the oldest lines are dropped and a comment with their
+ * number is written instead. Binary data gets no comment, which would make
+ * the file unreadable. Its bytes dropped are counted by lostData() and a
+ * part continuing dropped data, e.g. the rest of a block of samples, is
+ * dropped as well, so a file never holds data with a piece cut out.
+ * 
+ * Two card slots:
+ *  LOG_FAILOVER  one card is written, if it fails the other slot takes over
+ *                at once with the text not yet written to the first one.
+ *  LOG_MIRROR    both cards get all text from the same ring buffer, each
+ *                card has its own page and position in the ring. The SD
+ *                library can only mount one card at a time, so the card
+ *                that is written every update() is switched whenever the
+ *                other one has a full page waiting.
+ *  Time spent writing and errors are counted for each card.
+ * 
+ * Index file:
+ *  Text can be appended together with a time, e.g. every few minutes. Then
+ *  an entry of the time and the position of the text in its file is added
+ *  to an index file of the same name with extension INDEX_EXTENSION. Each
+ *  entry holds two little endian uint32_t: the time (unix time) and the
+ *  byte offset. Tools/DataIndex binary searches it to read a time range
+ *  without scanning the whole file. The index is not journaled, an entry
+ *  may appear twice or, after lost data, point to a wrong position.
+ * 
+ * Directories:
+ *  The directory of a file is created when the file is written first, e.g.
+ *  for a new month. The directory known to exist is cached for the mounted
+ *  card, so mkdir() walks the path only once per directory and mount. The
+ *  stock SD library can not open files relative to an open directory, every
+ *  open walks the path from the root. This is cheap as long as each
+ *  directory on the path holds few entries, see below.
+ * 
+ * Migration:
+ *  Data files used to be named YY-MM-DD.ext directly in one directory, which
+ *  after some years holds more than a thousand entries and makes every open
+ *  scan them. After migrate() was called with that directory, its files are
+ *  moved to YYYY/MM/DD.ext below it, MIGRATE_SECTORS sectors per update()
+ *  whenever the card has nothing else to write. The SD library can not
+ *  rename, so a file is copied and removed afterwards. After a reset the
+ *  copy is resumed if the target holds the start of the file, if the target
+ *  is another file or is being written, DD-1.ext, DD-2.ext, ... is used.
+ *  The directory stays open while the card is mounted and is read on from
+ *  the file found last, so each entry is read once per mount instead of
+ *  all entries before a file for every file.
+ * 
+ * Journal file:
+ *  JOURNAL_SECTORS sectors written round robin, sector seq % JOURNAL_SECTORS
+ *  holds the write with sequence number seq, see JournalSector for the
+ *  layout. A sector is valid if magic and CRC-32 match.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _LOGGER__H_
+#define _LOGGER__H_
+
+#include <Arduino.h>
+#include <SD.h>
+
+#define SECTOR_SIZE       512           ///< bytes of a sector on the SD card
+#define PAGE_SIZE         (SECTOR_SIZE - 64)  ///< bytes of text in a sector
+#define JOURNAL_FILE      "journal.bin" ///< name of the journal in the root
+#define JOURNAL_SECTORS   8             ///< sectors of the journal
+#define JOURNAL_MAGIC     0x4C4E524AUL  ///< "JRNL" at the start of a sector
+// about 6 minutes of data at one line every 2 s
+#define RING_SIZE         12288         ///< bytes buffered without a card
+// mounting a missing card blocks for the 2 s timeout of the SD library,
+// the interval doubles after each failed attempt, the ring must outlast it
+#define REMOUNT_INTERVAL  30000         ///< ms before the first new attempt
+#define REMOUNT_MAX       60000         ///< ms between attempts at most
+#define NO_PIN            0xFF          ///< no second chip select pin
+#define NO_CARD           0xFF          ///< no card mounted
+#define INDEX_EXTENSION   "idx"         ///< extension of index files
+#define MIGRATE_SECTORS   4             ///< sectors copied per update()
+
+/* How the two card slots are used */
+enum LogMode : uint8_t {
+  LOG_FAILOVER,   ///< write one card, switch to the other on errors
+  LOG_MIRROR      ///< write all data to both cards
+};
+
+/* One sector of the journal, holds the page of a file */
+struct JournalSector {
+  uint32_t magic;         ///< JOURNAL_MAGIC
+  uint32_t seq;           ///< sequence number of the write
+  uint32_t crc;           ///< CRC-32 of the sector with crc = 0
+  uint32_t offset;        ///< position of the payload in the file
+  uint16_t length;        ///< bytes of payload
+  uint16_t reserved;
+  char file[44];          ///< name of the file, 0 terminated
+  char payload[PAGE_SIZE];  ///< text appended to the file
+};
+
+/* Write statistics of one card since start */
+struct CardStats {
+  uint32_t writes;        ///< sectors written
+  uint32_t errors;        ///< failed mounts and writes
+  uint64_t totalMicros;   ///< time spent writing sectors in µs
+  uint32_t maxMicros;     ///< longest write of a sector in µs
+};
+
+/* State of one card slot */
+struct LogCard {
+  uint8_t pin;            ///< chip select pin, NO_PIN if slot is not used
+  bool usable;            ///< mounted without error since
+  bool recovered;         ///< journal was checked since the card was mounted
+  uint32_t mountTime;     ///< millis() of the last attempt to mount
+  uint8_t failures;       ///< failed mounts and writes in a row
+  uint16_t consumed;      ///< bytes of the ring already moved into the page
+  uint16_t lost;          ///< lines dropped before the card got them
+  uint32_t lostData;      ///< bytes of binary data dropped since start
+  bool broken;            ///< binary data continued by parts was dropped
+  uint32_t indexTime;     ///< time of the index entry for the next text
+  bool migrated;          ///< no files left to migrate on the card
+  char migrateFile[13];   ///< 8.3 name of the file migrated, "" if none
+  char migrateTarget[44]; ///< file it is copied to
+  uint32_t migrateOffset; ///< bytes copied
+  char headFile[44];      ///< file of the next text in the ring
+  JournalSector page;     ///< page of the file written at the moment
+  CardStats stats;        ///< write statistics
+};
+
+/* Journaled logger writing text to files on one or two SD cards */
+class Logger {
+ public:
+  // take the SD library and the chip select pins of the card slots, use
+  // NO_PIN for a single slot
+  Logger(SDClass& sd, uint8_t csPin, uint8_t csPin2 = NO_PIN,
+         LogMode mode = LOG_FAILOVER);
+
+  // mount a card, open its journal and repair the file written last,
+  // return false if there is no card
+  bool begin(void);
+  // append text to the file of given name, the text is buffered and
+  // written by update(), return false if it is too long. If a time is
+  // given, an index entry for the text is written, see above
+  bool append(const String& filename, const char* text,
+              uint32_t indexTime = 0);
+  // append binary data of at most one page to the file of given name, part
+  // if it continues the data appended before. Return false if too long
+  bool append(const String& filename, const void* data, uint16_t length,
+              bool part);
+  // append a comment line with the statistics of each card to the file
+  void appendStatistics(const String& filename);
+  // write buffered text to the cards. A missing card is mounted again
+  // only if mount is set, the SD library then blocks for 2 s
+  void update(bool mount = true);
+  // move the data files of the old flat layout in given directory into
+  // year and month directories, see above
+  void migrate(const char* directory);
+
+  // check if a card is mounted
+  bool mounted(void) const { return _mounted != NO_CARD; }
+  // number of bytes waiting in the ring buffer
+  uint16_t pending(void) const { return _used; }
+  // bytes of binary data dropped since start, of the card that lost most
+  uint32_t lostData(void) const {
+    return max(_cards[0].lostData, _cards[1].lostData);
+  }
+  // write statistics of the card in given slot (0 or 1)
+  const CardStats& stats(uint8_t slot) const { return _cards[slot].stats; }
+
+ private:
+  // mount the card in given slot if it is not mounted yet and check its
+  // journal. A failed card is only tried if mount is set and its interval
+  // has passed, mount is then cleared so one update() tries one card
+  bool select(uint8_t slot, bool& mount);
+  // forget the card in given slot after an error, its text stays buffered
+  void fail(uint8_t slot);
+  // let the card in slot to continue where the card in slot from stopped
+  void takeOver(uint8_t from, uint8_t to);
+  // check if the card in given slot gets the text of the ring
+  bool tracking(uint8_t slot) const;
+  // move the next page of text of the ring to the mounted card
+  bool drain(uint8_t slot);
+  // free the ring up to the text all cards have got
+  void release(void);
+  // open or create the journal of the mounted card, repair the file written
+  // last if not done since the card was mounted
+  bool openJournal(uint8_t slot);
+  // continue the page at the end of the file of given name
+  void startPage(LogCard& card, const char* filename);
+  // write the page of a card into the next sector of its journal
+  bool writeJournal(LogCard& card);
+  // open a file of the mounted card, for writing its directory is created
+  // if it is not known to exist
+  File open(const char* filename, uint8_t mode);
+  // write the payload of a sector to its position in its file
+  bool apply(LogCard& card, const JournalSector& sector);
+  // add an entry to the index of the file of the page of a card
+  bool writeIndex(LogCard& card, uint32_t offset);
+  // copy the next sectors of the file migrated on the card in given slot,
+  // or look for the next one
+  void migrateStep(uint8_t slot);
+  // choose the target of the file migrated on a card, false if there is
+  // no free name
+  bool migrateTarget(LogCard& card, const String& source);
+  // check if a file with the name of given file up to its extension is
+  // written by a card or buffered in the ring
+  bool busy(const char* filename) const;
+  // add the time since start to the statistics of a card
+  static void count(LogCard& card, uint32_t start);
+  // check magic, length and CRC of a sector
+  static bool valid(JournalSector& sector);
+  // CRC-32 (IEEE 802.3) of given data
+  static uint32_t crc32(const void* data, size_t length);
+
+  // records in the ring buffer: a 16 bit header with the length and type,
+  // RECORD_FILE holds the name of the file the following text belongs to,
+  // RECORD_MARK the time of an index entry for the following text,
+  // RECORD_DATA and RECORD_PART binary data and its continuation
+  // put the file name, index time and data of an append() into the ring
+  bool add(const String& filename, uint16_t type, const void* data,
+           uint16_t length, uint32_t indexTime);
+  // put a record into the ring, dropping the oldest ones if it is full
+  void push(uint16_t type, const void* data, uint16_t length);
+  // header of the record at given offset from the oldest one
+  uint16_t header(uint16_t offset) const;
+  // copy data of the record at given offset
+  void copy(uint16_t offset, void* data) const;
+
+  SDClass& _sd;             ///< SD library the cards are mounted with
+  LogMode _mode;            ///< how the slots are used
+  LogCard _cards[2];        ///< state of the slots
+  uint8_t _active;          ///< slot written every update()
+  uint8_t _mounted;         ///< slot mounted at the moment or NO_CARD
+  File _journal;            ///< journal of the mounted card, kept open
+  char _directory[32];      ///< directory known to exist on the mounted card
+  const char* _migrate;     ///< directory to migrate, NULL if none
+  File _migrateDir;         ///< that directory on the mounted card, kept open
+
+  uint8_t _ring[RING_SIZE]; ///< ring buffer of records
+  uint16_t _head;           ///< index of the oldest record
+  uint16_t _used;           ///< bytes used in the ring
+  char _ringFile[44];       ///< file of the newest record in the ring
+};
+
+#endif  // _LOGGER__H_
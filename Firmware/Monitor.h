@@ -0,0 +1,766 @@
+/******************************************************************************
+ * 
+ * Core of the CO2 monitor.
+ * 
+ * A class holding everything one monitor consists of: the handles of its
+ * sensor, clock, SD card and display, the graphic elements on the screen and
+ * the state that has to survive between two loop iterations. The Arduino
+ * functions setup() and loop() only forward to begin() and update().
+ * 
+ * No state is kept in globals or function-local statics, and the I2C bus
+ * and the watchdog are handles like the others. Several monitors can thus
+ * run in one program, each one with its own set of peripherals, within
+ * two limits: interrupts need a table of their objects, so only
+ * BUTTON_MAX monitors get their button, see Button.h, and only one clock
+ * can take the square wave of its RTC, see Clock.h.
+ * The class of the display is given as template parameter Display, see
+ * Graphics.h for the methods it must provide.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _MONITOR__H_
+#define _MONITOR__H_
+
+#include <SPI.h>
+#include <SD.h>
+#include <Wire.h>                             // I2C
+#include <RTClib.h>                           // Real time clock
+#include <SparkFun_SCD30_Arduino_Library.h>   // CO2 Sensor
+#include <Adafruit_SleepyDog.h>               // Watchdog timer
+#include <Adafruit_GFX.h>                     // Graphics
+#include "Config.h"                           // pins, colors and constants
+#include "Layout.h"                           // positions of graphic elements
+#include "Graphics.h"                         // draw graphic elements
+#include "bmpDraw.h"                          // draw bitmap files
+#include "Logger.h"                           // journaled data files
+#include "Compressor.h"                       // compressed data files
+#include "Statistics.h"                       // daily statistics
+#include "Trend.h"                            // prediction of CO2 levels
+#include "Ventilation.h"                      // detection of ventilations
+#include "Filter.h"                           // filter of bad readings
+#include "Settings.h"                         // settings file of the device
+#include "Occupancy.h"                        // estimation of people
+#include "Sequence.h"                         // row numbers and reset cause
+#include "Clock.h"                            // ms clock disciplined by RTC
+#include "Button.h"                           // gestures of the button
+#include "Pages.h"                            // pages below the header
+#include "DisplayPower.h"                     // sleep of the display
+
+// colors of the CO2 bar in each CO2 band, see co2Band()
+const uint16_t CO2_COLORS[CO2_BANDS] = {
+  GREY, GREEN, YELLOW, ORANGE, IMTEK_RED
+};
+// levels with a line in the trend graph, in the colors above them
+const uint16_t GRAPH_LEVELS[3] = {CO2_LEVEL_2, CO2_LEVEL_3, CO2_LEVEL_4};
+
+/* Class of one CO2 monitor with its peripherals, screen and state. */
+template <class Display>
+class Monitor {
+ public:
+  /* Methods */
+  // take the peripherals the monitor works with, nothing is initialized
+  // or drawn until begin() is called
+  Monitor(Display& tft, SCD30& scd30, RTC_DS3231& rtc, SDClass& sd,
+          TwoWire& wire, WatchdogType& watchdog);
+
+  // initialize peripherals and show the startup screen
+  void begin(void);
+  // code to be run continiously
+  void update(void);
+
+ private:
+  /* Methods */
+  // create filename consisting of the date, including directories
+  String getFilename(const char* extension);
+  // append the compressed samples completed to the compressed data file,
+  // note in the text file if the logger lost some
+  void appendBlocks(void);
+  // append the statistics of the day to the summary file and reset them
+  void appendSummary(void);
+  // show the minutes above the CO2 levels and since the last ventilation
+  void refreshExposure(void);
+  // predict when the next CO2 level is reached, show and log changes
+  void updatePrediction(uint16_t co2);
+  // write the boot record to the data file
+  void appendBoot(void);
+  // read the time of the last calibration from the calibration file
+  void readCalibration(void);
+  // update the lines of the statistics and diagnostics pages
+  void refreshStatistics(void);
+  void refreshDiagnostics(void);
+  // start a calibration in CALIBRATION_TIME or abort the one pending
+  void toggleCalibration(void);
+  // put the display to sleep or wake it as the settings and events ask
+  void updatePower(void);
+
+  /* Members */
+  // peripherals
+  Display& _tft;            ///< display
+  SCD30& _scd30;            ///< CO2 sensor
+  RTC_DS3231& _rtc;         ///< real time clock
+  SDClass& _sd;             ///< SD card for data and images
+  TwoWire& _wire;           ///< I2C bus of sensor and RTC
+  WatchdogType& _watchdog;  ///< resets the MCU if a loop hangs
+
+  Clock _clock;             ///< time of the RTC without reading it, Clock.h
+  Button _button;           ///< gestures of the button on CALIB
+
+  Settings _settings;       ///< settings of the device, see Settings.h
+  Logger _logger;           ///< writes the data files
+  Sequence _sequence;       ///< numbers of the data rows
+  uint8_t _resetCause;      ///< RCAUSE of the last reset
+  bool _bootLogged;         ///< if the boot record was written
+  String _datafile;         ///< filename of the datafile
+  String _blockfile;        ///< filename of the compressed datafile
+  String _eventfile;        ///< filename of the ventilations of the day
+  Compressor _compressor;   ///< encodes the samples of the compressed file
+  uint32_t _lostData;       ///< bytes of compressed data lost, noted so far
+  // filters of single bad readings of CO2, temperature and humidity
+  SpikeFilter _co2Filter, _tempFilter, _rhFilter;
+  DailyStatistics _statistics;  ///< statistics of the day so far
+  VentilationDetector _ventilation; ///< finds ventilations in the CO2
+  uint32_t _nextIndexTime;  ///< unix time of the next line to be indexed
+  Trend _trend;             ///< fit of the recent CO2 values
+  OccupancyEstimator _occupancy;  ///< people in the room from the fit
+  uint16_t _predictionLevel;  ///< CO2 level predicted, 0 if none
+  int16_t _prediction;      ///< minutes until it is reached, -1 if none
+
+  // store last second, minute and day to trigger action on change
+  uint8_t _lastDay, _lastMinute, _lastSecond;
+  uint32_t _lastPoll;       ///< millis() the sensor was asked last
+  uint32_t _lastSample;     ///< millis() of the last sample
+
+  uint32_t _wakeMillis;     ///< millis() of the last press or CO2 alarm
+
+  bool _calibrationPending; ///< store calibration status
+  uint32_t _lastCalibration;  ///< unix time of the last calibration, 0 if none
+
+  // graphical elements on the screen
+  HeaderBar<Display> _hbar;
+  ValueBar<Display> _vbarCO2;
+  ValueBar<Display> _vbarTemp;
+  ValueBar<Display> _vbarRH;
+  ExposureBar<Display> _exposure;
+  TrendGraph<Display> _graph;
+  TextPanel<Display> _statisticsPanel;
+  TextPanel<Display> _diagnosticsPanel;
+  // Though not visible most of the time warning must be in scope of update
+  CalibrationWarning<Display> _calibWarning;
+  // switches between the pages of the elements above, which are updated
+  // while not shown
+  PageManager<Display> _pages;
+  DisplayPower<Display> _power;   ///< sleep of display and backlight
+};
+
+// ____________________________________________________________________________
+template <class Display>
+Monitor<Display>::Monitor(Display& tft, SCD30& scd30, RTC_DS3231& rtc,
+                          SDClass& sd, TwoWire& wire,
+                          WatchdogType& watchdog)
+    : _tft(tft), _scd30(scd30), _rtc(rtc), _sd(sd), _wire(wire),
+      _watchdog(watchdog),
+      _logger(sd, SD_CS, SD2_CS, LOG_MODE),
+      _resetCause(0), _bootLogged(false), _lostData(0),
+      _co2Filter(FILTER_MODE, FILTER_WINDOW, SPIKE_CO2),
+      _tempFilter(FILTER_MODE, FILTER_WINDOW, SPIKE_TEMP),
+      _rhFilter(FILTER_MODE, FILTER_WINDOW, SPIKE_RH),
+      // init with values that do not occur naturally to trigger action
+      // on startup
+      _nextIndexTime(0), _predictionLevel(0), _prediction(-1),
+      _lastDay(0), _lastMinute(60), _lastSecond(60), _lastPoll(0),
+      _lastSample(0), _wakeMillis(0), _calibrationPending(false),
+      _lastCalibration(0),
+      // all positions are taken from the layout, see Layout.h
+      _hbar(&tft, sd, Layout::HEADER, GREY, TEXT_COLOR, IMTEK_LOGO_SMALL),
+      _vbarCO2(&tft, Layout::CO2_BAR, IMTEK_BLUE, TEXT_COLOR, "CO2", "ppm", 3),
+      _vbarTemp(&tft, Layout::TEMP_BAR, IMTEK_BLUE, TEXT_COLOR, "Temp", "°C"),
+      _vbarRH(&tft, Layout::RH_BAR, IMTEK_BLUE, TEXT_COLOR, "RH", "%"),
+      // minutes above the yellow, orange and red levels
+      _exposure(&tft, Layout::EXPOSURE, GREY, TEXT_COLOR, CO2_COLORS + 2),
+      // pages shown instead of the bars
+      _graph(&tft, Layout::GRAPH_PAGE, IMTEK_BLUE, TEXT_COLOR, CO2_LEVEL_1,
+             GRAPH_LEVELS, CO2_COLORS + 2, GRAPH_STEP),
+      _statisticsPanel(&tft, Layout::TEXT_PAGE, IMTEK_BLUE, TEXT_COLOR,
+                       "Today"),
+      _diagnosticsPanel(&tft, Layout::TEXT_PAGE, IMTEK_BLUE, TEXT_COLOR,
+                        "Diagnostics"),
+      _calibWarning(&tft, Layout::CALIBRATION, IMTEK_RED, TEXT_COLOR),
+      _pages(&tft, BACKGROUND_COLOR, _vbarCO2, _vbarTemp, _vbarRH, _exposure,
+             _graph, _statisticsPanel, _diagnosticsPanel),
+      _power(&tft, BACKLIGHT) {
+}
+
+/*****************************************************************************
+    begin - initializations
+*****************************************************************************/
+template <class Display>
+void Monitor<Display>::begin(void) {
+  uint32_t start = millis();   // to measure how long the splash is shown
+
+  /* Activate peripherals */
+  _wire.begin();
+  _tft.begin();
+  _power.begin();
+  _scd30.begin(_wire);
+  _rtc.begin(&_wire);
+  // cause of the reset for the boot record
+  _resetCause = _watchdog.resetCause();
+
+  // Watchdog, enabled first as the following steps are watched by it
+  _watchdog.enable(8000);  // set watchdog interval 8 s
+  
+  /* initialize peripherals */
+  // TFT display
+  _tft.cp437(true);
+  _tft.setRotation(PANEL_ROTATION);
+  // during start up clear screen to white and print headline at once, the
+  // logo follows once the card is mounted
+  _tft.fillScreen(WHITE);
+  Label<Display> startup(&_tft, Layout::TITLE.x, Layout::TITLE.y, "CO2FreiMon",
+                         Layout::TITLE_SIZE, IMTEK_BLUE, 3);
+  startup.print();
+
+  // from now on the time is read from the clock, reads the RTC until the
+  // start of its next second
+  _clock.begin(_rtc, CLOCK_SQW_PIN);
+  _watchdog.reset();
+  // mount SD card on display shield or Adalogger and repair the data file
+  // written last. Without card the device works on and mounts it later
+  _logger.begin();
+  _watchdog.reset();
+  // row numbers for the boot record
+  _sequence.begin(_sd, SEQUENCE_FILE);
+  // settings of the device, the defaults of Config.h without card
+  _settings.read(_sd, SETTINGS_FILE);
+  _occupancy.begin(_settings.volume, _settings.airChange);
+  readCalibration();
+  // data files used to be in one directory, move them to the year and month
+  // directories in the background
+  _logger.migrate(DIRECTORY);
+
+  // the logo is drawn progressively, some rows after every step below
+  bmpReader<Display> logo(&_tft, _sd);
+  logo.begin(IMTEK_LOGO_BIG, Layout::LOGO_BIG.x, Layout::LOGO_BIG.y);
+  logo.drawRows(SPLASH_ROWS);
+
+  // CO2 sensor
+  _scd30.setAutoSelfCalibration(false);   // deactivate auto calibration
+  logo.drawRows(SPLASH_ROWS);
+  _scd30.setAltitudeCompensation(278);    // Freiburg is 278 m above sea level
+  logo.drawRows(SPLASH_ROWS);
+  _scd30.setTemperatureOffset(0);         // no temperature offset
+  logo.drawRows(SPLASH_ROWS);
+
+
+  /* Button, read by an interrupt */
+  _button.begin(CALIB);
+
+  // draw the rest of the logo, then show it until the first measurement
+  // is available, but not longer than SPLASH_TIME. The measurement is
+  // read and logged by the first call of update()
+  while (logo.drawRows(SPLASH_ROWS)) {
+    _watchdog.reset();
+  }
+  while (millis() - start < SPLASH_TIME && !_scd30.dataAvailable()) {
+    _watchdog.reset();
+  }
+  _tft.fillScreen(BACKGROUND_COLOR);
+
+  // draw the graphical elements of the measurement screen
+  _hbar.draw();
+  _pages.show(PAGE_VALUES);
+}
+
+/*****************************************************************************    
+    update - code to be run continiously
+*****************************************************************************/
+template <class Display>
+void Monitor<Display>::update(void) {
+  _watchdog.reset();   // keep watchdog happy
+  _clock.update();    // reads the RTC only every CLOCK_SYNC_INTERVAL
+
+  DateTime newTime = _clock.now();  // get time of this loops execution
+
+  // if time has changed update it on display
+  if (newTime.minute() != _lastMinute) {
+    _lastMinute = newTime.minute();
+    _hbar.updateTime(newTime);
+
+    // when date has changed update it on display and start a new data file
+    if (newTime.day() != _lastDay) {
+      _lastDay = newTime.day();
+      _hbar.updateDate(newTime);
+
+      // close the day with its summary and the write statistics of the
+      // SD cards and the clock
+      appendSummary();
+      if (_datafile.length()) {
+        _logger.appendStatistics(_datafile);
+        char text[96];
+        _clock.report(text, sizeof(text));
+        _logger.append(_datafile, text);
+      }
+      _compressor.close();
+      appendBlocks();
+
+      // get new file name. As this is also called on startup
+      // only write file header if file did not exist yet. With compressed
+      // data files the text file only holds the header and comments
+      _datafile = getFilename(FILE_EXTENSION);
+      _blockfile = getFilename(COMPRESSED_EXTENSION);
+      _eventfile = getFilename(EVENTS_EXTENSION);
+      if (!_sd.exists(_datafile)) {
+        _logger.append(_datafile, FILE_HEADER "\r\n");
+      }
+      if (!_sd.exists(_eventfile)) {
+        _logger.append(_eventfile, EVENTS_HEADER "\r\n");
+      }
+      // the first data file after a start gets the boot record
+      if (!_bootLogged) {
+        appendBoot();
+        _bootLogged = true;
+      }
+    }   // day changed
+
+    // a point of the trend graph every GRAPH_STEP
+    if ((newTime.hour() * 60L + newTime.minute()) * 60 % GRAPH_STEP == 0) {
+      _graph.close();
+    }
+    // counted in the RAM of the statistics, the pages are updated whether
+    // they are shown or not, only changed digits and lines are drawn
+    refreshExposure();
+    refreshStatistics();
+  }   // minute changed
+
+  if (newTime.second() != _lastSecond) {
+    _lastSecond = newTime.second();
+    // uptime and clock of the diagnostics page
+    refreshDiagnostics();
+    // sleep or wake on the schedule of the settings
+    updatePower();
+
+    // if calibration status is pending and second has changed refresh
+    // countdown until calibration
+    if (_calibrationPending) {
+      _calibWarning.refreshCountdown(newTime);
+
+      // if calibration status is pending and calibration time is reached
+      // calibrate the CO2 sensor, log it in output file and refresh
+      // the display to show the page again
+      if (newTime >= _calibWarning.getCalibrationTime()) {
+        _scd30.setForcedRecalibrationFactor(BACKGROUND_CO2);
+        _calibrationPending = false;
+
+        char text[80];
+        snprintf(
+          text, sizeof(text),
+          "# Calibration\n"
+          "# Setting last CO2 value to background value of %d ppm.\n",
+          BACKGROUND_CO2
+        );
+        _logger.append(_datafile, text);
+        // the time of the calibration for the diagnostics page
+        snprintf(text, sizeof(text), "%i/%02i/%02i %02i:%02i:%02i, %d\n",
+                 newTime.year(), newTime.month(), newTime.day(),
+                 newTime.hour(), newTime.minute(), newTime.second(),
+                 BACKGROUND_CO2);
+        _logger.append(DIRECTORY "/" CALIBRATION_FILE, text);
+        _lastCalibration = newTime.unixtime();
+
+        // the warning is within the pages, they clear it when drawn again
+        _pages.show(_pages.page());
+      }
+    }   // calibration pending
+  }   // second changed
+
+  // if sensor has measured new values, it is asked every SENSOR_POLL ms as
+  // each request is an I2C transfer
+  bool poll = millis() - _lastPoll >= SENSOR_POLL;
+  if (poll) _lastPoll = millis();
+  bool sampled = false;
+  if (poll && _scd30.dataAvailable()) {
+    sampled = true;
+    _lastSample = millis();
+    // get measurement data
+    uint16_t co2  = _scd30.getCO2();
+    float    temp = _scd30.getTemperature();
+    float    rh   = _scd30.getHumidity();
+
+    // raw sample in the resolution of the text files for the data files
+    uint16_t ms;
+    DateTime now = _clock.now(&ms);
+    Sample raw;
+    raw.time = _clock.valid() ? now.unixtime() : 0;
+    raw.co2  = co2;
+    raw.temp = lroundf(temp * 100);
+    raw.rh   = lroundf(rh * 100);
+    // filtered sample for display, statistics and detectors
+    Sample sample = raw;
+    sample.co2  = _co2Filter.add(raw.co2);
+    sample.temp = _tempFilter.add(raw.temp);
+    sample.rh   = _rhFilter.add(raw.rh);
+
+    _statistics.add(sample, millis());
+    if (_ventilation.add(sample, millis())) {
+      _statistics.addVentilation();
+      char line[80];
+      _ventilation.format(line, sizeof(line));
+      _logger.append(_eventfile, line);
+    }
+    _trend.add(sample.co2, millis());
+    _graph.add(sample.co2);
+
+    if (DATA_FORMAT == FORMAT_COMPRESSED) {
+      _compressor.add(raw);
+      appendBlocks();
+    } else {
+      // format a line and append it to the data file
+      char line[96];
+      uint8_t length = 0;
+      uint32_t indexTime = 0;
+      // if RTC is running write date and time to file, to the ms
+      if (_clock.valid()) {
+        length = snprintf(
+          line, sizeof(line), "%i/%02i/%02i %02i:%02i:%02i.%03u",
+          now.year(), now.month(), now.day(),
+          now.hour(), now.minute(), now.second(), ms
+        );
+        // the first line of every INDEX_INTERVAL gets an index entry
+        if (now.unixtime() >= _nextIndexTime) {
+          indexTime = now.unixtime();
+          _nextIndexTime = (indexTime / INDEX_INTERVAL + 1) * INDEX_INTERVAL;
+        }
+      }
+      // measurement data and people, empty if not estimated
+      length += snprintf(line + length, sizeof(line) - length,
+                         ", %i, %.2f, %.2f, ", co2, temp, rh);
+      int16_t people = _occupancy.estimate(_trend);
+      if (people >= 0) {
+        length += snprintf(line + length, sizeof(line) - length, "%i.%i",
+                           people / 10, people % 10);
+      }
+      // row number and ms since start, to find gaps and resets
+      snprintf(line + length, sizeof(line) - length, ", %lu, %lu\n",
+               (unsigned long) _sequence.next(), (unsigned long) millis());
+      _logger.append(_datafile, line, indexTime);
+    }
+
+    // update filtered values of the value bars, drawn if their page is
+    // shown. Change color according to warning level
+    _vbarCO2.changeColor(CO2_COLORS[co2Band(sample.co2)]);
+    _vbarCO2.refreshValue(sample.co2);
+    _vbarTemp.refreshValue(sample.temp / 100.0f);
+    _vbarRH.refreshValue(sample.rh / 100.0f);
+    updatePrediction(sample.co2);
+    // and in calibration warning if calibration is pending
+    if (_calibrationPending) _calibWarning.refreshCO2(sample.co2);
+    // high CO2 wakes the display and keeps it on, it is woken on the next
+    // second
+    if (sample.co2 >= DISPLAY_WAKE_LEVEL) _wakeMillis = millis();
+  }   // data available
+
+  // write buffered data to the SD card, at most two sectors per loop. A
+  // missing card is mounted right after a sample, so the 2 s the SD
+  // library may block delay no sample, presses are taken by the interrupt
+  _logger.update(sampled || millis() - _lastSample >= MOUNT_WAIT);
+  // send the sleep commands to the display that were not due yet
+  _power.update();
+
+  // a long press starts or aborts the calibration, the others switch the
+  // pages while there is none. Each press keeps the display on, the one
+  // waking it does nothing else
+  Gesture gesture = _button.update();
+  if (gesture != GESTURE_NONE) {
+    _wakeMillis = millis();
+    if (!_power.awake()) {
+      updatePower();
+      gesture = GESTURE_NONE;
+    }
+  }
+  switch (gesture) {
+    case GESTURE_LONG:
+      toggleCalibration();
+      break;
+    case GESTURE_SHORT:
+      if (!_calibrationPending) {
+        _pages.show((Page) ((_pages.page() + 1) % PAGES));
+      }
+      break;
+    case GESTURE_DOUBLE:
+      if (!_calibrationPending) _pages.show(PAGE_VALUES);
+      break;
+    default:
+      break;
+  }
+
+  // sleep until the next interrupt, the button or at the latest the tick
+  // of millis() in a ms
+  __WFI();
+}
+
+/*****************************************************************************    
+    Methods - helper functions
+*****************************************************************************/
+
+// ____________________________________________________________________________
+template <class Display>
+String Monitor<Display>::getFilename(const char* extension) {
+  if (!_clock.valid()) {
+    return String(DIRECTORY "/" DEFAULT_FILE_NAME ".") + extension;
+  }
+  // one directory per year and month keeps the directories small, so
+  // opening a file takes the same time after years of logging
+  DateTime currentTime = _clock.now();
+  char filename[24];
+  snprintf(filename, sizeof(filename), DIRECTORY "/%04u/%02u/%02u.%s",
+           currentTime.year(), currentTime.month(), currentTime.day(),
+           extension);
+  return filename;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::appendSummary(void) {
+  if (_statistics.samples() == 0) return;
+  String filename = DIRECTORY "/" SUMMARY_FILE;
+  if (!_sd.exists(filename)) {
+    _logger.append(filename, SUMMARY_HEADER "\r\n");
+  }
+  char line[160];
+  _statistics.format(line, sizeof(line));
+  _logger.append(filename, line);
+  _statistics.reset();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::appendBlocks(void) {
+  const uint8_t* data;
+  uint16_t length;
+  bool part;
+  while ((length = _compressor.take(&data, &part)) > 0) {
+    _logger.append(_blockfile, data, length, part);
+  }
+  // without a card for long the logger drops data. Once a card is back the
+  // next samples start a new block, as the rest of one cut by the loss is
+  // dropped as well. Noted once, not for every block lost meanwhile
+  if (_logger.lostData() != _lostData && _logger.mounted()) {
+    char text[64];
+    snprintf(text, sizeof(text), "# %lu bytes of compressed data lost\n",
+             (unsigned long) (_logger.lostData() - _lostData));
+    _lostData = _logger.lostData();
+    _logger.append(_datafile, text);
+    _compressor.close();
+    while ((length = _compressor.take(&data, &part)) > 0) {
+      _logger.append(_blockfile, data, length, part);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::refreshExposure(void) {
+  uint16_t minutes[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    minutes[i] = _statistics.minutesFrom(i + 2);
+  }
+  _exposure.refresh(minutes, _ventilation.minutesSinceVentilation(millis()));
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::updatePrediction(uint16_t co2) {
+  // the next level the room should not reach
+  uint16_t level = co2 < CO2_LEVEL_2 ? CO2_LEVEL_2
+                 : co2 < CO2_LEVEL_4 ? CO2_LEVEL_4 : 0;
+  int16_t minutes = -1;
+  int32_t seconds = level ? _trend.secondsTo(level) : -1;
+  if (seconds >= 0 && seconds <= PREDICTION_TIME * 60L) {
+    minutes = (seconds + 59) / 60;
+  } else {
+    level = 0;
+  }
+  if (minutes == _prediction && level == _predictionLevel) return;
+
+  // log each new prediction with the level it is made for
+  if (level && level != _predictionLevel) {
+    char text[48];
+    snprintf(text, sizeof(text), "# Prediction: %u ppm in ~%i min\n",
+             level, minutes);
+    _logger.append(_datafile, text);
+  }
+  _prediction = minutes;
+  _predictionLevel = level;
+  _vbarCO2.refreshNote(
+    level ? "ventilate in ~" + String(minutes, DEC) + " min" : ""
+  );
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::appendBoot(void) {
+  // number of the first row and ms since start, a gap of the sequence
+  // numbers before it is the rest of the lease
+  char text[112];
+  snprintf(text, sizeof(text),
+           "# Boot, seq %lu, uptime %lu, reset cause 0x%02x %s%s\n",
+           (unsigned long) _sequence.peek(), (unsigned long) millis(),
+           _resetCause, resetCauseName(_resetCause),
+           _sequence.persistent() ? "" : ", sequence not persisted");
+  _logger.append(_datafile, text);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::readCalibration(void) {
+  // only the last line is needed, it is shorter than 64 bytes
+  File file = _sd.open(DIRECTORY "/" CALIBRATION_FILE, FILE_READ);
+  if (!file) return;
+  uint32_t size = file.size();
+  file.seek(size > 64 ? size - 64 : 0);
+  char text[65];
+  text[file.read(text, 64)] = '\0';
+  file.close();
+  // start of the last line, the file ends with a newline
+  char* line = text;
+  for (char* c = text; *c != '\0'; c++) {
+    if (*c == '\n' && c[1] != '\0') line = c + 1;
+  }
+  int year, month, day, hour, minute, second;
+  if (sscanf(line, "%d/%d/%d %d:%d:%d", &year, &month, &day, &hour, &minute,
+             &second) == 6) {
+    _lastCalibration =
+      DateTime(year, month, day, hour, minute, second).unixtime();
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::refreshStatistics(void) {
+  TextPanel<Display>& panel = _statisticsPanel;
+  uint32_t n = _statistics.samples();
+  if (n == 0) {
+    panel.refreshLine(0, "No measurements yet");
+    return;
+  }
+  const Range& co2 = _statistics.co2();
+  const Range& temp = _statistics.temp();
+  const Range& rh = _statistics.rh();
+  char line[48];
+  panel.refreshLine(0, "            min    max   mean");
+  snprintf(line, sizeof(line), "CO2 ppm   %5li  %5li  %5li", (long) co2.min,
+           (long) co2.max, (long) ((co2.sum + (int32_t) n / 2) / n));
+  panel.refreshLine(1, line);
+  snprintf(line, sizeof(line), "Temp °C   %5.1f  %5.1f  %5.1f",
+           temp.min / 100.0, temp.max / 100.0, temp.sum / 100.0 / n);
+  panel.refreshLine(2, line);
+  snprintf(line, sizeof(line), "RH %%      %5.1f  %5.1f  %5.1f",
+           rh.min / 100.0, rh.max / 100.0, rh.sum / 100.0 / n);
+  panel.refreshLine(3, line);
+  for (uint8_t i = 0; i < 3; i++) {
+    snprintf(line, sizeof(line), "%s %4u ppm  %4u min",
+             i ? "          " : "Time above", GRAPH_LEVELS[i],
+             _statistics.minutesFrom(i + 2));
+    panel.refreshLine(5 + i, line);
+  }
+  snprintf(line, sizeof(line), "Ventilations %u, samples %lu",
+           _statistics.ventilations(), (unsigned long) n);
+  panel.refreshLine(8, line);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::refreshDiagnostics(void) {
+  TextPanel<Display>& panel = _diagnosticsPanel;
+  char line[52];   // fits the longest, Filtered with 10 digit counts
+  uint32_t uptime = millis() / 1000;
+  snprintf(line, sizeof(line), "Uptime    %lud %02u:%02u:%02u",
+           (unsigned long) uptime / 86400, (unsigned) (uptime / 3600 % 24),
+           (unsigned) (uptime / 60 % 60), (unsigned) (uptime % 60));
+  panel.refreshLine(0, line);
+  snprintf(line, sizeof(line), "Reset     %s", resetCauseName(_resetCause));
+  panel.refreshLine(1, line);
+  snprintf(line, sizeof(line), "Next row  %lu%s",
+           (unsigned long) _sequence.peek(),
+           _sequence.persistent() ? "" : " (not leased)");
+  panel.refreshLine(2, line);
+  snprintf(line, sizeof(line), "Clock     %s, %li ppm, %li ms",
+           _clock.valid() ? "set" : "not set", (long) _clock.drift(),
+           (long) _clock.offset());
+  panel.refreshLine(3, line);
+  if (_lastCalibration) {
+    DateTime time(_lastCalibration);
+    snprintf(line, sizeof(line), "Calibrated %i/%02i/%02i", time.year(),
+             time.month(), time.day());
+    panel.refreshLine(4, line);
+  } else {
+    panel.refreshLine(4, "Calibrated never");
+  }
+  CardStats card = _logger.stats(0);
+  const CardStats& card2 = _logger.stats(1);
+  card.writes += card2.writes;
+  card.errors += card2.errors;
+  snprintf(line, sizeof(line), "Card      %s, %u B waiting",
+           _logger.mounted() ? "mounted" : "missing", _logger.pending());
+  panel.refreshLine(5, line);
+  snprintf(line, sizeof(line), "          %lu writes, %lu errors",
+           (unsigned long) card.writes, (unsigned long) card.errors);
+  panel.refreshLine(6, line);
+  snprintf(line, sizeof(line), "Filtered  %lu, %lu, %lu values",
+           (unsigned long) _co2Filter.replaced(),
+           (unsigned long) _tempFilter.replaced(),
+           (unsigned long) _rhFilter.replaced());
+  panel.refreshLine(7, line);
+  snprintf(line, sizeof(line), "Room      %u m3, %u.%02u /h",
+           _settings.volume, _settings.airChange / 100,
+           _settings.airChange % 100);
+  panel.refreshLine(8, line);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::toggleCalibration(void) {
+  if (_calibrationPending) {
+    _calibrationPending = false;
+    _logger.append(_datafile, "# Calibration aborted\n");
+    // the warning is within the pages, they clear it when drawn again
+    _pages.show(_pages.page());
+    return;
+  }
+  _calibrationPending = true;
+
+  // clear the pages and print calibration information
+  _pages.hide();
+  _calibWarning.setCalibrationTime(_clock.now() + TimeSpan(CALIBRATION_TIME));
+  _calibWarning.print();
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void Monitor<Display>::updatePower(void) {
+  // on within the times of the settings, for DISPLAY_WAKE_TIME after the
+  // start, the last press or CO2 alarm and during a calibration. Without a
+  // set clock the times are unknown, so it stays on
+  bool on = !_clock.valid() || _settings.displayScheduled(_clock.now())
+            || millis() - _wakeMillis < DISPLAY_WAKE_TIME * 1000UL
+            || _calibrationPending;
+  if (on == _power.awake()) return;
+  if (on) {
+    // the header was drawn on during sleep, the pages were kept up to date
+    // hidden and are drawn once before the display is lit
+    _power.wake();
+    _pages.show(_pages.page());
+    _power.light();
+  } else {
+    _power.sleep();
+    _pages.hide();
+  }
+}
+
+#endif  // _MONITOR__H_
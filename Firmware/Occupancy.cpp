@@ -0,0 +1,38 @@
+/******************************************************************************
+ * 
+ * Estimation of the number of people in a room from its CO2.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Occupancy.h"
+
+// ____________________________________________________________________________
+OccupancyEstimator::OccupancyEstimator() : _volume(0), _airChange(0) {
+}
+
+// ____________________________________________________________________________
+void OccupancyEstimator::begin(uint16_t volume, uint16_t airChange) {
+  _volume = volume;
+  _airChange = airChange;
+}
+
+// ____________________________________________________________________________
+int16_t OccupancyEstimator::estimate(const Trend& trend) const {
+  int64_t slope, level;
+  if (!_volume || !trend.fit(&slope, &level)) return -1;
+  // V (dC/dt + n (C - C_outdoor)) in m³ ppm/h * 100 with 16 fractional
+  // bits, slope is in ppm/s and n in 0.01/h
+  int64_t excess = level - ((int64_t) BACKGROUND_CO2 << 16);
+  int64_t rate = slope * 3600 * 100 + (int64_t) _airChange * excess;
+  // divided by G, in tenths of a person
+  int64_t people = _volume * rate / ((int64_t) CO2_PER_PERSON * 10 << 16);
+  return constrain(people, 0, 32767);
+}
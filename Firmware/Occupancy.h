@@ -0,0 +1,52 @@
+/******************************************************************************
+ * 
+ * Estimation of the number of people in a room from its CO2.
+ * 
+ * Single-zone mass balance of the CO2 in a room of volume V with an
+ * outdoor air change rate n, each person exhaling G:
+ * 
+ *  V dC/dt = people * G - n V (C - C_outdoor)
+ * 
+ * solved for the people. C and dC/dt are the level and slope of the linear
+ * fit of the recent CO2 in Trend, which is updated with each sample in
+ * constant time. The estimate is integer arithmetic in 64 bit, in tenths of
+ * a person. C_outdoor is BACKGROUND_CO2 and G is CO2_PER_PERSON, the rate of
+ * an adult sitting. V and n come from the settings file, see Settings.h.
+ * Tools/AirChange fits n from the decays of CO2 of a room.
+ * 
+ * The estimate follows a change of the people with the delay of the fit,
+ * a few minutes. It is only as good as V and n, and n varies with the
+ * weather and open doors.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _OCCUPANCY__H_
+#define _OCCUPANCY__H_
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Trend.h"
+
+/* Estimator of the people in a room */
+class OccupancyEstimator {
+ public:
+  OccupancyEstimator();
+
+  // set the room volume in m³ and the air changes per hour in 0.01/h,
+  // without volume there is no estimate
+  void begin(uint16_t volume, uint16_t airChange);
+  // people in tenths of a person with the CO2 of given fit, -1 if unknown
+  int16_t estimate(const Trend& trend) const;
+
+ private:
+  uint16_t _volume;       ///< room volume in m³
+  uint16_t _airChange;    ///< air changes per hour in 0.01/h
+};
+
+#endif  // _OCCUPANCY__H_
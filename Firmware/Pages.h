@@ -0,0 +1,230 @@
+/******************************************************************************
+ * 
+ * Pages shown below the header bar and switching between them.
+ * 
+ * The area below the header shows one of several pages: the value bars
+ * with the exposure bar, the graph of the CO2 or a panel of text. The
+ * elements of all pages are kept with their state all the time. Those of
+ * pages not shown are hidden (see Graphics::setVisible()), their refresh
+ * methods only change the state. A page switched to is then drawn from the
+ * state, it does not have to wait for new values.
+ * 
+ * A switch only draws what differs between the pages, the header bar is
+ * never touched:
+ *  - bars and panel: the gaps of the new page, e.g. the rounded corners
+ *    and the spacing between the bars, are cleared and the new page is
+ *    drawn, its shapes cover the old page
+ *  - panel and panel: the panels share their background, only the content
+ *    of the old one is erased. The graph erases itself by drawing its
+ *    curve in the color of the background, two text panels only redraw the
+ *    lines that differ
+ * The panels must thus have the same position, size and color. After
+ * hide(), e.g. for the calibration warning, the next show() clears the
+ * whole area once.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _PAGES__H_
+#define _PAGES__H_
+
+#include <Arduino.h>
+#include "Layout.h"
+#include "Graphics.h"
+
+/* Pages below the header, a short press of the button shows the next one */
+enum Page : uint8_t {
+  PAGE_VALUES,        ///< value bars and exposure bar
+  PAGE_TREND,         ///< graph of the CO2 of the last hours
+  PAGE_STATISTICS,    ///< statistics of the day so far
+  PAGE_DIAGNOSTICS,   ///< state of clock, card, filters and settings
+  PAGES               ///< number of pages
+};
+
+/* Class to switch between the pages, each given by its elements. */
+template <class Display>
+class PageManager : public Graphics<Display> {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  /* Methods */
+  // take the elements of the pages and the color of the background around
+  // them, nothing is drawn until show() is called
+  PageManager(Display* display, uint16_t background, ValueBar<Display>& co2,
+              ValueBar<Display>& temp, ValueBar<Display>& rh,
+              ExposureBar<Display>& exposure, TrendGraph<Display>& graph,
+              TextPanel<Display>& statistics,
+              TextPanel<Display>& diagnostics);
+
+  // show given page instead of the one shown
+  void show(Page page);
+  // clear the area of the pages and hide all of them, e.g. to draw another
+  // element there. show() draws them again
+  void hide(void);
+  // the page shown or to be shown after hide()
+  Page page(void) const { return _page; }
+
+ private:
+  /* Methods */
+  // show or hide the elements of given page
+  void setVisible(Page page, bool visible);
+  // clear the parts of the area not covered by the shapes of given page
+  void clearGaps(Page page) const;
+  // draw given page with its background
+  void draw(Page page);
+  // text panel of given page, which must be one of them
+  TextPanel<Display>& panel(Page page);
+
+  /* Members */
+  uint16_t _background;             ///< color around the pages
+  Page _page;                       ///< page shown
+  bool _shown;                      ///< if it is shown or the area is clear
+  ValueBar<Display>* _bars[3];      ///< value bars of PAGE_VALUES
+  ExposureBar<Display>& _exposure;  ///< exposure bar of PAGE_VALUES
+  TrendGraph<Display>& _graph;      ///< graph of PAGE_TREND
+  TextPanel<Display>& _statistics;  ///< panel of PAGE_STATISTICS
+  TextPanel<Display>& _diagnostics; ///< panel of PAGE_DIAGNOSTICS
+};
+
+// ____________________________________________________________________________
+template <class Display>
+PageManager<Display>::PageManager(Display* display, uint16_t background,
+                                  ValueBar<Display>& co2,
+                                  ValueBar<Display>& temp,
+                                  ValueBar<Display>& rh,
+                                  ExposureBar<Display>& exposure,
+                                  TrendGraph<Display>& graph,
+                                  TextPanel<Display>& statistics,
+                                  TextPanel<Display>& diagnostics)
+    // init all members with the given values
+    : Graphics<Display>(display), _background(background),
+      _page(PAGE_VALUES), _shown(false), _exposure(exposure), _graph(graph),
+      _statistics(statistics), _diagnostics(diagnostics) {
+  _bars[0] = &co2;
+  _bars[1] = &temp;
+  _bars[2] = &rh;
+  // nothing is drawn before show()
+  for (uint8_t page = 0; page < PAGES; page++) {
+    setVisible((Page) page, false);
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void PageManager<Display>::show(Page page) {
+  if (_shown && page == _page) return;
+  Page old = _page;
+  setVisible(old, false);
+  setVisible(page, true);
+  _page = page;
+
+  if (!_shown) {
+    // something else was drawn in the area
+    _display->fillRect(Layout::PAGE.x, Layout::PAGE.y, Layout::PAGE.w,
+                       Layout::PAGE.h, _background);
+    draw(page);
+  } else if (old == PAGE_VALUES || page == PAGE_VALUES) {
+    // the shapes differ, those of the new page cover the old one
+    clearGaps(page);
+    draw(page);
+  } else if (old == PAGE_TREND) {
+    _graph.clear();
+    panel(page).drawContent();
+  } else if (page == PAGE_TREND) {
+    panel(old).clear();
+    _graph.drawContent();
+  } else {
+    panel(page).drawOver(panel(old));
+  }
+  _shown = true;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void PageManager<Display>::hide(void) {
+  setVisible(_page, false);
+  _display->fillRect(Layout::PAGE.x, Layout::PAGE.y, Layout::PAGE.w,
+                     Layout::PAGE.h, _background);
+  _shown = false;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void PageManager<Display>::setVisible(Page page, bool visible) {
+  switch (page) {
+    case PAGE_VALUES:
+      for (uint8_t i = 0; i < 3; i++) {
+        _bars[i]->setVisible(visible);
+      }
+      _exposure.setVisible(visible);
+      break;
+    case PAGE_TREND:
+      _graph.setVisible(visible);
+      break;
+    default:
+      panel(page).setVisible(visible);
+      break;
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void PageManager<Display>::clearGaps(Page page) const {
+  const Layout::Rect& area = Layout::PAGE;
+  int16_t r = Layout::RADIUS;
+  if (page != PAGE_VALUES) {
+    // the corners of the panel
+    _display->fillRect(area.x, area.y, r, r, _background);
+    _display->fillRect(area.x + area.w - r, area.y, r, r, _background);
+    _display->fillRect(area.x, area.y + area.h - r, r, r, _background);
+    _display->fillRect(area.x + area.w - r, area.y + area.h - r, r, r,
+                       _background);
+    return;
+  }
+  // the corners of the bars and the rows between them, top to bottom
+  int16_t top = area.y;
+  for (uint8_t i = 0; i < 4; i++) {
+    Layout::Rect bar = i < 3 ? _bars[i]->rect() : _exposure.rect();
+    _display->fillRect(area.x, top, area.w, bar.y - top, _background);
+    _display->fillRect(bar.x, bar.y, r, r, _background);
+    _display->fillRect(bar.x + bar.w - r, bar.y, r, r, _background);
+    _display->fillRect(bar.x, bar.y + bar.h - r, r, r, _background);
+    _display->fillRect(bar.x + bar.w - r, bar.y + bar.h - r, r, r,
+                       _background);
+    top = bar.y + bar.h;
+  }
+  _display->fillRect(area.x, top, area.w, area.y + area.h - top, _background);
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void PageManager<Display>::draw(Page page) {
+  switch (page) {
+    case PAGE_VALUES:
+      for (uint8_t i = 0; i < 3; i++) {
+        _bars[i]->draw();
+      }
+      _exposure.draw();
+      break;
+    case PAGE_TREND:
+      _graph.draw();
+      break;
+    default:
+      panel(page).draw();
+      break;
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+TextPanel<Display>& PageManager<Display>::panel(Page page) {
+  return page == PAGE_STATISTICS ? _statistics : _diagnostics;
+}
+
+#endif  // _PAGES__H_
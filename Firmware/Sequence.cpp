@@ -0,0 +1,79 @@
+/******************************************************************************
+ * 
+ * Sequence numbers of the data rows and the cause of the last reset.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Sequence.h"
+
+// ____________________________________________________________________________
+const char* resetCauseName(uint8_t cause) {
+  // several bits may be set, the first one names the cause
+  if (cause & RESET_POWER_ON) return "power on";
+  if (cause & RESET_BOD12)    return "brown out core";
+  if (cause & RESET_BOD33)    return "brown out supply";
+  if (cause & RESET_EXTERNAL) return "reset button";
+  if (cause & RESET_WATCHDOG) return "watchdog";
+  if (cause & RESET_SYSTEM)   return "software";
+  return "unknown";
+}
+
+// ____________________________________________________________________________
+Sequence::Sequence() : _sd(NULL), _filename(NULL), _next(0), _end(0) {
+}
+
+// ____________________________________________________________________________
+bool Sequence::begin(SDClass& sd, const char* filename) {
+  _sd = &sd;
+  _filename = filename;
+  File file = sd.open(filename);
+  if (file) {
+    uint8_t data[8];
+    if (file.read(data, sizeof(data)) == sizeof(data)) {
+      uint32_t end = 0, check = 0;
+      for (int8_t i = 3; i >= 0; i--) {
+        end = (end << 8) | data[i];
+        check = (check << 8) | data[i + 4];
+      }
+      if (end == ~check) _next = end;
+    }
+    file.close();
+  }
+  if (!lease()) {
+    // the file could not be read, a later lease might lower the numbers
+    _sd = NULL;
+    return false;
+  }
+  return true;
+}
+
+// ____________________________________________________________________________
+uint32_t Sequence::next(void) {
+  // renew early, so a card missing for a while does not run the lease out
+  if (_sd && (int32_t) (_end - _next) <= SEQUENCE_LEASE / 2) lease();
+  return _next++;
+}
+
+// ____________________________________________________________________________
+bool Sequence::lease(void) {
+  File file = _sd->open(_filename, O_READ | O_WRITE | O_CREAT);
+  if (!file) return false;
+  uint32_t end = _next + SEQUENCE_LEASE;
+  uint8_t data[8];
+  for (uint8_t i = 0; i < 4; i++) {
+    data[i] = end >> (8 * i);
+    data[i + 4] = ~end >> (8 * i);
+  }
+  bool good = file.seek(0) && file.write(data, sizeof(data)) == sizeof(data);
+  file.close();
+  if (good) _end = end;
+  return good;
+}
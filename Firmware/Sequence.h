@@ -0,0 +1,72 @@
+/******************************************************************************
+ * 
+ * Sequence numbers of the data rows and the cause of the last reset.
+ * 
+ * Every row of the data files gets a number one higher than the row
+ * before, across resets, so missing rows can be found and rows ordered
+ * without a set clock. Writing the counter to the card for every row
+ * would cost a sector write each, so numbers are leased: on start the end
+ * of the last lease is read from SEQUENCE_FILE and becomes the first
+ * number, and the end of a new lease SEQUENCE_LEASE numbers further is
+ * written back. Before the lease runs out a new one is written. A reset
+ * thus skips the rest of the lease, but no number is ever used twice.
+ * 
+ * The file holds the end of the lease and its complement as two little
+ * endian uint32_t. It is kept on the card mounted on start. A new card
+ * starts at 0 again, as does a device started without card, which is
+ * noted in the boot record, see Monitor.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _SEQUENCE__H_
+#define _SEQUENCE__H_
+
+#include <Arduino.h>
+#include <SD.h>
+#include "Config.h"
+
+/* Bits of the reset cause register RCAUSE of the SAMD21 power manager */
+#define RESET_POWER_ON  0x01    ///< power on
+#define RESET_BOD12     0x02    ///< brown out of the core voltage
+#define RESET_BOD33     0x04    ///< brown out of the supply voltage
+#define RESET_EXTERNAL  0x10    ///< reset pin, e.g. the RST button
+#define RESET_WATCHDOG  0x20    ///< watchdog
+#define RESET_SYSTEM    0x40    ///< software, e.g. after uploading code
+
+// name of the cause of a reset given as RCAUSE
+const char* resetCauseName(uint8_t cause);
+
+/* Counter of the data rows, persisted in leases */
+class Sequence {
+ public:
+  Sequence();
+
+  // read the lease from given file and write the next one, false if the
+  // card can't be read or written and the numbers start at 0
+  bool begin(SDClass& sd, const char* filename);
+  // the number of the next row, without taking it
+  uint32_t peek(void) const { return _next; }
+  // take the number of the next row, renews the lease when half used
+  uint32_t next(void);
+  // if the next number is covered by a lease on the card
+  bool persistent(void) const {
+    return _sd && (int32_t) (_end - _next) > 0;
+  }
+
+ private:
+  // write the end of a lease from the next number on, false on errors
+  bool lease(void);
+
+  SDClass* _sd;             ///< card the file is on, NULL if not leased
+  const char* _filename;    ///< file of the lease
+  uint32_t _next;           ///< next number
+  uint32_t _end;            ///< first number not leased
+};
+
+#endif  // _SEQUENCE__H_
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * 
+ * Settings of one device, read from a text file on the SD card.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Settings.h"
+
+// ____________________________________________________________________________
+Settings::Settings()
+    : volume(ROOM_VOLUME), airChange(AIR_CHANGE_RATE),
+      displayFrom(DISPLAY_FROM), displayUntil(DISPLAY_UNTIL),
+      displayDays(DISPLAY_DAYS) {
+}
+
+// ____________________________________________________________________________
+bool Settings::read(SDClass& sd, const char* filename) {
+  File file = sd.open(filename);
+  if (!file) return false;
+  char line[SETTINGS_LINE];
+  uint8_t length = 0;
+  while (true) {
+    int c = file.read();
+    if (c < 0 || c == '\n') {
+      line[length] = '\0';
+      parse(line);
+      length = 0;
+      if (c < 0) break;
+    } else if (length < SETTINGS_LINE - 1) {
+      line[length++] = c;
+    }
+  }
+  file.close();
+  return true;
+}
+
+// ____________________________________________________________________________
+bool Settings::displayScheduled(const DateTime& time) const {
+  if (!(displayDays & 1 << time.dayOfTheWeek())) return false;
+  if (displayFrom == displayUntil) return true;
+  uint16_t minute = time.hour() * 60 + time.minute();
+  if (displayFrom < displayUntil) {
+    return minute >= displayFrom && minute < displayUntil;
+  }
+  // over midnight
+  return minute >= displayFrom || minute < displayUntil;
+}
+
+// ____________________________________________________________________________
+void Settings::parse(char* line) {
+  // cut the comment, split name and value at '='
+  char* comment = strchr(line, '#');
+  if (comment) *comment = '\0';
+  char* value = strchr(line, '=');
+  if (!value) return;
+  *value++ = '\0';
+  char* name = line;
+  while (*name == ' ' || *name == '\t') name++;
+  char* end = name + strlen(name);
+  while (end > name && (end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+
+  int32_t number;
+  if (!strcasecmp(name, "volume")) {
+    if (parseFixed(value, 0, &number) && number >= 0 && number <= 10000) {
+      volume = number;
+    }
+  } else if (!strcasecmp(name, "ach")) {
+    if (parseFixed(value, 2, &number) && number >= 0 && number <= 10000) {
+      airChange = number;
+    }
+  } else if (!strcasecmp(name, "display")) {
+    char* until;
+    uint16_t from, to;
+    if (splitRange(value, &until) && parseTime(value, &from)
+        && parseTime(until, &to)) {
+      displayFrom = from % 1440;
+      displayUntil = to % 1440;
+    }
+  } else if (!strcasecmp(name, "days")) {
+    // a single day or a range of days
+    char* last = value;
+    int32_t first, end;
+    splitRange(value, &last);
+    if (parseFixed(value, 0, &first)
+        && parseFixed(last, 0, &end) && first >= 1 && first <= 7
+        && end >= 1 && end <= 7) {
+      // from Monday = 1 to the bits of DateTime::dayOfTheWeek() with
+      // Sunday = 0, a range may wrap around the week
+      displayDays = 0;
+      for (int32_t day = first;; day = day % 7 + 1) {
+        displayDays |= 1 << (day % 7);
+        if (day == end) break;
+      }
+    }
+  }
+}
+
+// ____________________________________________________________________________
+bool Settings::splitRange(char* text, char** second) {
+  char* dash = strchr(text, '-');
+  if (!dash) return false;
+  *dash = '\0';
+  *second = dash + 1;
+  return true;
+}
+
+// ____________________________________________________________________________
+bool Settings::parseTime(const char* text, uint16_t* minute) {
+  while (*text == ' ' || *text == '\t') text++;
+  if (!isdigit(*text)) return false;
+  uint16_t hour = 0;
+  for (uint8_t digits = 0; isdigit(*text); text++) {
+    if (++digits > 2) return false;
+    hour = hour * 10 + (*text - '0');
+  }
+  if (*text++ != ':' || !isdigit(text[0]) || !isdigit(text[1])) return false;
+  uint16_t minutes = (text[0] - '0') * 10 + (text[1] - '0');
+  text += 2;
+  // only blanks and a carriage return may follow
+  while (*text == ' ' || *text == '\t' || *text == '\r') text++;
+  if (*text || minutes >= 60 || hour * 60 + minutes > 1440) return false;
+  *minute = hour * 60 + minutes;
+  return true;
+}
+
+// ____________________________________________________________________________
+bool Settings::parseFixed(const char* text, uint8_t decimals,
+                          int32_t* value) {
+  while (*text == ' ' || *text == '\t') text++;
+  bool negative = *text == '-';
+  if (negative) text++;
+  if (!isdigit(*text) && !(*text == '.' && isdigit(text[1]))) return false;
+  int32_t result = 0;
+  for (; isdigit(*text); text++) {
+    if (result > 10000000) return false;
+    result = result * 10 + (*text - '0');
+  }
+  // digits after the point, the ones beyond decimals are cut off
+  uint8_t digits = 0;
+  if (*text == '.') {
+    for (text++; isdigit(*text); text++) {
+      if (digits < decimals) {
+        result = result * 10 + (*text - '0');
+        digits++;
+      }
+    }
+  }
+  for (; digits < decimals; digits++) result *= 10;
+  // only blanks and a carriage return may follow
+  while (*text == ' ' || *text == '\t' || *text == '\r') text++;
+  if (*text) return false;
+  *value = negative ? -result : result;
+  return true;
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * 
+ * Settings of one device, read from a text file on the SD card.
+ * 
+ * Devices run the same firmware in different rooms. What differs between
+ * them is kept in the file SETTINGS_FILE in the root of the card, read once
+ * on start. Each line holds a name and a value, a # starts a comment:
+ * 
+ *  # room 02 017
+ *  volume = 180    # m³
+ *  ach = 0.6       # air changes per hour with windows closed
+ *  display = 7:00-19:00  # display on from to, off outside
+ *  days = 1-5      # display on Monday to Friday, 1 is Monday, 7 Sunday
+ * 
+ * Values are decimal numbers, read in fixed point, times h:mm or ranges
+ * of both separated by '-'. A range of times may span midnight, equal
+ * times keep the display on all day. Outside them the display sleeps, see
+ * DisplayPower.h. Unknown names are ignored. Missing names, a missing file
+ * or values out of range keep the defaults of Config.h.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _SETTINGS__H_
+#define _SETTINGS__H_
+
+#include <Arduino.h>
+#include <SD.h>
+#include <RTClib.h>
+#include "Config.h"
+
+#define SETTINGS_LINE   64    ///< longest line read, the rest is ignored
+
+/* Settings of a device */
+class Settings {
+ public:
+  // set the defaults of Config.h
+  Settings();
+
+  // read the settings from given file, false if it can't be opened
+  bool read(SDClass& sd, const char* filename);
+
+  uint16_t volume;      ///< room volume in m³, 0 if unknown
+  uint16_t airChange;   ///< air changes per hour in 0.01/h
+  uint16_t displayFrom; ///< minute of the day the display turns on
+  uint16_t displayUntil;  ///< minute it turns off, displayFrom for never
+  uint8_t displayDays;  ///< days the display is on, bit 0 Sunday
+
+  // if the display is to be on at given time
+  bool displayScheduled(const DateTime& time) const;
+
+ private:
+  // take the setting of a line
+  void parse(char* line);
+  // split a range "a-b" at the '-' into its two texts, false and second
+  // unchanged if there is no '-'
+  static bool splitRange(char* text, char** second);
+  // read a time h:mm as minute of the day, 24:00 included, false if it
+  // is no time
+  static bool parseTime(const char* text, uint16_t* minute);
+  // read a decimal number with given digits after the point as integer,
+  // false if it is no number
+  static bool parseFixed(const char* text, uint8_t decimals, int32_t* value);
+};
+
+#endif  // _SETTINGS__H_
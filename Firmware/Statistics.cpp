@@ -0,0 +1,104 @@
+/******************************************************************************
+ * 
+ * Statistics of the measurements of one day.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <RTClib.h>
+#include "Statistics.h"
+
+// ____________________________________________________________________________
+uint8_t co2Band(uint16_t co2) {
+  if (co2 < CO2_LEVEL_1) return 0;
+  if (co2 < CO2_LEVEL_2) return 1;
+  if (co2 < CO2_LEVEL_3) return 2;
+  if (co2 < CO2_LEVEL_4) return 3;
+  return 4;
+}
+
+// ____________________________________________________________________________
+DailyStatistics::DailyStatistics() {
+  reset();
+}
+
+// ____________________________________________________________________________
+void DailyStatistics::reset(void) {
+  _samples = 0;
+  _first = _last = 0;
+  _lastMillis = 0;
+  memset(_seconds, 0, sizeof(_seconds));
+  _ventilations = 0;
+}
+
+// ____________________________________________________________________________
+void DailyStatistics::add(const Sample& sample, uint32_t now) {
+  if (_samples == 0) {
+    _first = sample.time;
+    _co2.min = _co2.max = sample.co2;
+    _temp.min = _temp.max = sample.temp;
+    _rh.min = _rh.max = sample.rh;
+    _co2.sum = _temp.sum = _rh.sum = 0;
+  } else {
+    // the time since the sample before is spent in the band of this one
+    uint32_t gap = min(now - _lastMillis, (uint32_t) MAX_SAMPLE_GAP);
+    _seconds[co2Band(sample.co2)] += (gap + 500) / 1000;
+  }
+  _samples++;
+  _last = sample.time;
+  _lastMillis = now;
+  add(_co2, sample.co2);
+  add(_temp, sample.temp);
+  add(_rh, sample.rh);
+}
+
+// ____________________________________________________________________________
+uint16_t DailyStatistics::minutesFrom(uint8_t band) const {
+  uint32_t seconds = 0;
+  for (; band < CO2_BANDS; band++) {
+    seconds += _seconds[band];
+  }
+  return seconds / 60;
+}
+
+// ____________________________________________________________________________
+void DailyStatistics::format(char* line, size_t size) const {
+  int length;
+  if (_first) {
+    DateTime first(_first), last(_last);
+    length = snprintf(
+      line, size, "%i/%02i/%02i, %02i:%02i, %02i:%02i, %lu",
+      first.year(), first.month(), first.day(), first.hour(), first.minute(),
+      last.hour(), last.minute(), (unsigned long) _samples
+    );
+  } else {
+    // clock was not set
+    length = snprintf(line, size, ", , , %lu", (unsigned long) _samples);
+  }
+  for (uint8_t band = 0; band < CO2_BANDS && length < (int) size; band++) {
+    length += snprintf(line + length, size - length, ", %lu",
+                       (unsigned long) (_seconds[band] + 30) / 60);
+  }
+  if (length >= (int) size) return;
+  float n = max(_samples, (uint32_t) 1);
+  snprintf(line + length, size - length,
+           ", %li, %li, %.0f, %.2f, %.2f, %.2f, %.2f, %.2f, %.2f, %u\n",
+           (long) _co2.min, (long) _co2.max, _co2.sum / n,
+           _temp.min / 100.0, _temp.max / 100.0, _temp.sum / n / 100,
+           _rh.min / 100.0, _rh.max / 100.0, _rh.sum / n / 100,
+           _ventilations);
+}
+
+// ____________________________________________________________________________
+void DailyStatistics::add(Range& range, int32_t value) {
+  range.min = min(range.min, value);
+  range.max = max(range.max, value);
+  range.sum += value;
+}
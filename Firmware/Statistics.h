@@ -0,0 +1,91 @@
+/******************************************************************************
+ * 
+ * Statistics of the measurements of one day.
+ * 
+ * The statistics are updated with every sample in constant time and
+ * memory, so the summary of a day is ready at midnight without reading the
+ * data file again. It holds the minutes spent in each CO2 band (the colors
+ * of the CO2 bar), minimum, maximum and mean of each value and the number
+ * of ventilations, which are detected by VentilationDetector and counted
+ * with addVentilation().
+ * 
+ * The time of a sample is the time since the sample before, measured with
+ * millis(), but at most MAX_SAMPLE_GAP, so the time the device was off is
+ * not counted. After a reset the statistics start anew, the summary then
+ * covers the day from the first sample on, see the columns first and last.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _STATISTICS__H_
+#define _STATISTICS__H_
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Compressor.h"                       // Sample
+
+#define CO2_BANDS       5       ///< number of CO2 bands, see co2Band()
+#define MAX_SAMPLE_GAP  60000   ///< ms counted at most for one sample
+// header of the summary file, matches DailyStatistics::format(). The
+// minutes in each CO2 band are named by the color of the CO2 bar
+#define SUMMARY_HEADER  "date, first, last, samples, min grey, min green, " \
+                        "min yellow, min orange, min red, co2 min, co2 max, " \
+                        "co2 mean, temp min, temp max, temp mean, rh min, " \
+                        "rh max, rh mean, ventilations"
+
+// band of a CO2 value: 0 below CO2_LEVEL_1, ..., 4 from CO2_LEVEL_4 on
+uint8_t co2Band(uint16_t co2);
+
+/* Minimum, maximum and sum of a value */
+struct Range {
+  int32_t min, max;       ///< extremes
+  int32_t sum;            ///< sum for the mean
+};
+
+/* Statistics of the samples of one day */
+class DailyStatistics {
+ public:
+  DailyStatistics();
+
+  // forget all samples, e.g. for a new day
+  void reset(void);
+  // add a sample measured at time now (millis())
+  void add(const Sample& sample, uint32_t now);
+  // count a ventilation
+  void addVentilation(void) { _ventilations++; }
+  // format a line of the summary file, terminated by a newline
+  void format(char* line, size_t size) const;
+
+  // number of samples
+  uint32_t samples(void) const { return _samples; }
+  // seconds spent in given CO2 band
+  uint32_t seconds(uint8_t band) const { return _seconds[band]; }
+  // minutes spent in given CO2 band and all above it
+  uint16_t minutesFrom(uint8_t band) const;
+  // number of ventilations
+  uint16_t ventilations(void) const { return _ventilations; }
+  // unix time of the first sample, 0 if the clock was not set
+  uint32_t first(void) const { return _first; }
+  // ranges of CO2, temperature and humidity, valid if there are samples
+  const Range& co2(void) const { return _co2; }
+  const Range& temp(void) const { return _temp; }
+  const Range& rh(void) const { return _rh; }
+
+ private:
+  // add a value to a range
+  static void add(Range& range, int32_t value);
+
+  uint32_t _samples;              ///< number of samples
+  uint32_t _first, _last;         ///< time of first and last sample
+  uint32_t _lastMillis;           ///< millis() of the last sample
+  uint32_t _seconds[CO2_BANDS];   ///< time spent in each CO2 band
+  Range _co2, _temp, _rh;         ///< ranges of the values
+  uint16_t _ventilations;         ///< number of ventilations
+};
+
+#endif  // _STATISTICS__H_
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * 
+ * Prediction of the time until the CO2 reaches a level.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "Trend.h"
+
+// ____________________________________________________________________________
+Trend::Trend() {
+  reset();
+}
+
+// ____________________________________________________________________________
+void Trend::reset(void) {
+  _s0 = _st = _stt = _sc = _stc = 0;
+  _lastMillis = 0;
+  _samples = 0;
+}
+
+// ____________________________________________________________________________
+void Trend::add(uint16_t co2, uint32_t now) {
+  if (_samples > 0 && now - _lastMillis > MAX_SAMPLE_GAP) reset();
+
+  if (_samples > 0) {
+    // move the time of all samples so far dt seconds into the past,
+    // the remaining milliseconds are counted with the next sample
+    int64_t dt = (now - _lastMillis) / 1000;
+    _lastMillis += dt * 1000;
+    _stt += dt * (dt * _s0 - 2 * _st);
+    _stc -= dt * _sc;
+    _st  -= dt * _s0;
+    // and lower their weight
+    _s0  -= _s0 / TREND_SAMPLES;
+    _st  -= _st / TREND_SAMPLES;
+    _stt -= _stt / TREND_SAMPLES;
+    _sc  -= _sc / TREND_SAMPLES;
+    _stc -= _stc / TREND_SAMPLES;
+  } else {
+    _lastMillis = now;
+  }
+  // the new sample is at time 0 and adds nothing to the sums with time
+  _s0 += TREND_WEIGHT;
+  _sc += (int64_t) TREND_WEIGHT * co2;
+  if (_samples < 0xFFFF) _samples++;
+}
+
+// ____________________________________________________________________________
+bool Trend::fit(int64_t* slope, int64_t* level) const {
+  if (_samples < TREND_MIN_SAMPLES) return false;
+  // slope = (s0 * stc - st * sc) / (s0 * stt - st^2), the denominator is
+  // scaled down so the slope in ppm/s gets 16 fractional bits
+  int64_t den = (_s0 * _stt - _st * _st) >> 16;
+  if (den <= 0) return false;
+  *slope = (_s0 * _stc - _st * _sc) / den;
+  // level of the fit at the newest sample
+  *level = ((_sc << 16) - *slope * _st) / _s0;
+  return true;
+}
+
+// ____________________________________________________________________________
+int32_t Trend::secondsTo(uint16_t level) const {
+  int64_t slope, now;
+  if (!fit(&slope, &now)) return -1;
+  if (slope * 60 < ((int64_t) TREND_MIN_SLOPE << 16)) return -1;
+  int64_t rest = ((int64_t) level << 16) - now;
+  if (rest < 0) return -1;
+  return rest / slope;
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * 
+ * Prediction of the time until the CO2 reaches a level.
+ * 
+ * A line is fitted to the recent CO2 values by exponentially weighted least
+ * squares: each sample multiplies the weight of the ones before by
+ * 1 - 1/TREND_SAMPLES, so the fit follows about the last TREND_SAMPLES
+ * samples. Only the five weighted sums of the fit are kept, with the time
+ * counted backwards from the newest sample, which makes an update constant
+ * in time and memory. All numbers are integers: weights and sums in 64 bit,
+ * slope and level of the fit in 16.16 fixed point, the M0 has no FPU.
+ * 
+ * A line rises faster than the approach of the CO2 to its equilibrium in
+ * an occupied room, so the prediction tends to be early rather than late.
+ * A gap of more than MAX_SAMPLE_GAP between two samples starts a new fit.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _TREND__H_
+#define _TREND__H_
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Statistics.h"                       // MAX_SAMPLE_GAP
+
+#define TREND_WEIGHT  256   ///< weight of the newest sample
+
+/* Linear fit of the CO2 trend */
+class Trend {
+ public:
+  Trend();
+
+  // forget all samples
+  void reset(void);
+  // add a CO2 value measured at time now (millis())
+  void add(uint16_t co2, uint32_t now);
+  // slope of the fit in ppm/s and its level at the newest sample in ppm,
+  // both with 16 fractional bits. False if there are too few samples
+  bool fit(int64_t* slope, int64_t* level) const;
+  // seconds until the fit reaches given level, -1 if there are too few
+  // samples, it rises slower than TREND_MIN_SLOPE or is above the level
+  int32_t secondsTo(uint16_t level) const;
+
+ private:
+  int64_t _s0;              ///< sum of the weights
+  int64_t _st, _stt;        ///< weighted sums of time and time squared
+  int64_t _sc, _stc;        ///< weighted sums of CO2 and time times CO2
+  uint32_t _lastMillis;     ///< millis() of the newest sample, full seconds
+  uint16_t _samples;        ///< samples since the last reset
+};
+
+#endif  // _TREND__H_
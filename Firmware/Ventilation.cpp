@@ -0,0 +1,142 @@
+/******************************************************************************
+ * 
+ * Detection of ventilations in the CO2 values.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <math.h>
+#include <RTClib.h>
+#include "Ventilation.h"
+
+#define LEVEL_SMOOTHING 4   ///< samples averaged by the level
+#define RATE_SMOOTHING  8   ///< samples averaged by the rate
+
+// ____________________________________________________________________________
+VentilationDetector::VentilationDetector()
+    : _endMillis(0), _ventilated(false) {
+  memset(&_last, 0, sizeof(_last));
+  reset();
+}
+
+// ____________________________________________________________________________
+void VentilationDetector::reset(void) {
+  _level = 0;
+  _rate = 0;
+  _lastMillis = 0;
+  _started = false;
+  _falling = false;
+  _calm = 0;
+}
+
+// ____________________________________________________________________________
+bool VentilationDetector::add(const Sample& sample, uint32_t now) {
+  if (_started && now - _lastMillis > MAX_SAMPLE_GAP) reset();
+  if (!_started || now == _lastMillis) {
+    _level = (int32_t) sample.co2 << 4;
+    _peak = Point{_level, sample.time, now};
+    _lastMillis = now;
+    _started = true;
+    return false;
+  }
+
+  // smooth level and its change per minute
+  int32_t last = _level;
+  _level += (((int32_t) sample.co2 << 4) - _level) / LEVEL_SMOOTHING;
+  int32_t rate = (int64_t) (_level - last) * 60000
+                 / (int32_t) (now - _lastMillis);
+  _rate += (rate - _rate) / RATE_SMOOTHING;
+  _lastMillis = now;
+  Point point = {_level, sample.time, now};
+
+  if (!_falling) {
+    // the peak follows the level unless it falls
+    if (_level >= _peak.level || _rate >= 0) _peak = point;
+    if (_rate <= -(VENTILATION_RATE << 4)) {
+      _falling = true;
+      _calm = 0;
+      _lowest = point;
+    }
+    return false;
+  }
+
+  if (_level < _lowest.level) _lowest = point;
+  _calm = _rate >= -(VENTILATION_END_RATE << 4) ? _calm + 1 : 0;
+  if (_calm >= VENTILATION_DEBOUNCE
+      || _level - _lowest.level >= (VENTILATION_DROP << 4) / 2) {
+    _falling = false;
+    bool ventilated = finish();
+    _peak = point;
+    return ventilated;
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+bool VentilationDetector::finish(void) {
+  if (_peak.level - _lowest.level < (VENTILATION_DROP << 4)) return false;
+  Ventilation last = _last;
+  _last.start = _peak.time;
+  _last.end = _lowest.time;
+  _last.co2Start = (_peak.level + 8) >> 4;
+  _last.co2End = (_lowest.level + 8) >> 4;
+  _last.duration = (_lowest.millis - _peak.millis + 500) / 1000;
+  if (decay() > VENTILATION_DECAY * 60UL) {
+    _last = last;   // keep the ventilation before
+    return false;
+  }
+  _endMillis = _lowest.millis;
+  _ventilated = true;
+  return true;
+}
+
+// ____________________________________________________________________________
+uint32_t VentilationDetector::decay(void) const {
+  // once per ventilation, so a float logarithm is cheap enough
+  if (_last.co2End <= BACKGROUND_CO2) return 0;
+  float ratio = (float) (_last.co2Start - BACKGROUND_CO2)
+                / (_last.co2End - BACKGROUND_CO2);
+  return lroundf(_last.duration / logf(ratio));
+}
+
+// ____________________________________________________________________________
+void VentilationDetector::format(char* line, size_t size) const {
+  int length;
+  if (_last.start) {
+    DateTime start(_last.start), end(_last.end);
+    length = snprintf(
+      line, size, "%i/%02i/%02i %02i:%02i:%02i, %02i:%02i:%02i",
+      start.year(), start.month(), start.day(),
+      start.hour(), start.minute(), start.second(),
+      end.hour(), end.minute(), end.second()
+    );
+  } else {
+    // clock was not set
+    length = snprintf(line, size, ",");
+  }
+  if (length >= (int) size) return;
+  length += snprintf(line + length, size - length, ", %u, %u, %u, ",
+                     _last.co2Start, _last.co2End,
+                     _last.co2Start - _last.co2End);
+  if (length >= (int) size) return;
+  // decay in minutes, empty if there is none
+  uint32_t tau = decay();
+  if (tau) {
+    snprintf(line + length, size - length, "%.1f\n", tau / 60.0);
+  } else {
+    snprintf(line + length, size - length, "\n");
+  }
+}
+
+// ____________________________________________________________________________
+int32_t VentilationDetector::minutesSinceVentilation(uint32_t now) const {
+  if (!_ventilated) return -1;
+  return (now - _endMillis) / 60000;
+}
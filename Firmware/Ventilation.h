@@ -0,0 +1,93 @@
+/******************************************************************************
+ * 
+ * Detection of ventilations in the CO2 values.
+ * 
+ * Each sample updates a smoothed CO2 level and its rate of change, both
+ * exponential moving averages in integers with 4 fractional bits, in
+ * constant time and memory. A ventilation starts at the highest level
+ * before the rate falls below -VENTILATION_RATE and ends at the lowest level
+ * once the rate stayed above -VENTILATION_END_RATE for VENTILATION_DEBOUNCE
+ * samples, or the level rose again by half of VENTILATION_DROP.
+ * 
+ * The decay constant of a ventilation is that of an exponential fall from
+ * the start to the end level towards the outdoor level BACKGROUND_CO2. It is
+ * the time the excess CO2 needs to fall to 37 %, lower is more effective.
+ * A fall is only counted if the level fell by at least VENTILATION_DROP and
+ * the decay constant is at most VENTILATION_DECAY, so noise and the slow
+ * fall after people left a room are ignored.
+ * 
+ * A gap of more than MAX_SAMPLE_GAP between two samples starts anew.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _VENTILATION__H_
+#define _VENTILATION__H_
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Compressor.h"                       // Sample
+#include "Statistics.h"                       // MAX_SAMPLE_GAP
+
+// header of the events file, matches VentilationDetector::format(). The
+// decay constant is given in minutes
+#define EVENTS_HEADER "start, end, co2 start, co2 end, drop, decay min"
+
+/* One ventilation */
+struct Ventilation {
+  uint32_t start, end;        ///< unix time, 0 if the clock was not set
+  uint16_t co2Start, co2End;  ///< smoothed CO2 at start and end in ppm
+  uint32_t duration;          ///< seconds from start to end
+};
+
+/* Detector of ventilations */
+class VentilationDetector {
+ public:
+  VentilationDetector();
+
+  // forget the current state, e.g. after a gap
+  void reset(void);
+  // add a sample measured at time now (millis()), true if it ended a
+  // ventilation, see last()
+  bool add(const Sample& sample, uint32_t now);
+  // the ventilation detected last
+  const Ventilation& last(void) const { return _last; }
+  // decay constant of the last ventilation in seconds, 0 if it fell to or
+  // below the outdoor level
+  uint32_t decay(void) const;
+  // format a line of the events file, terminated by a newline
+  void format(char* line, size_t size) const;
+  // minutes since the end of the last ventilation at time now (millis()),
+  // -1 if there was none since startup
+  int32_t minutesSinceVentilation(uint32_t now) const;
+
+ private:
+  // a point of the smoothed CO2 curve
+  struct Point {
+    int32_t level;            ///< smoothed CO2 in ppm / 16
+    uint32_t time;            ///< unix time
+    uint32_t millis;          ///< millis()
+  };
+
+  // end the fall at the lowest point, true if it was deep enough
+  bool finish(void);
+
+  int32_t _level;             ///< smoothed CO2 in ppm / 16
+  int32_t _rate;              ///< smoothed change in ppm / 16 per minute
+  uint32_t _lastMillis;       ///< millis() of the last sample
+  bool _started;              ///< if there was a sample since the reset
+  bool _falling;              ///< if a fall is in progress
+  uint8_t _calm;              ///< samples since the rate got low in a fall
+  Point _peak;                ///< highest point before the fall
+  Point _lowest;              ///< lowest point of the fall
+  Ventilation _last;          ///< last detected ventilation
+  uint32_t _endMillis;        ///< millis() of its end
+  bool _ventilated;           ///< if there was one since startup
+};
+
+#endif  // _VENTILATION__H_
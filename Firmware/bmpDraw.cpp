@@ -1,142 +1,316 @@
-/******************************************************************************
- * 
- * Read bmp files and print them on display.
- * 
- * Further documentation in .h file
- * 
- * created        14.04.2021
- * last modified  29.05.2021
- * by             Jannik Sehringer (adapted from Adafruit example code)
- * for            Laboratory for Sensors,
- *                IMTEK - Department of Microsystems Engineering,
- *                University of Freiburg
- * 
-******************************************************************************/
-
-#include "bmpDraw.h"
-
-// This function opens a Windows Bitmap (BMP) file and
-// displays it at the given coordinates.  It's sped up
-// by reading many pixels worth of data at a time
-// (rather than pixel by pixel).  Increasing the buffer
-// size takes more of the Arduino's precious RAM but
-// makes loading a little faster.  20 pixels seems a
-// good balance.
-void bmpReader::draw(const char* filename, int16_t x, int16_t y) {
-  // copied from Adafruit and modified
-  // (basically only removed all Serial.print() commands)
-  File     bmpFile;
-  int      bmpWidth, bmpHeight;   // W+H in pixels
-  uint8_t  bmpDepth;              // Bit depth (currently must be 24)
-  uint32_t bmpImageoffset;        // Start of image data in file
-  uint32_t rowSize;               // Not always = bmpWidth; may have padding
-  uint8_t  sdbuffer[3*BUFFPIXEL]; // pixel buffer (R+G+B per pixel)
-  uint16_t  buffidx = sizeof(sdbuffer); // Current position in sdbuffer
-  boolean  goodBmp = false;       // Set to true on valid header parse
-  boolean  flip    = true;        // BMP is stored bottom-to-top
-  int      w, h, row, col;
-  uint8_t  r, g, b;
-  uint32_t pos = 0;
-
-  if((x >= _display->width()) || (y >= _display->height())) return;
-
-  // Open requested file on SD card
-  if (!(bmpFile = SD.open(filename)))
-    return;
-
-  // Parse BMP header
-  if(read16(bmpFile) == 0x4D42) { // BMP signature
-    (void)read32(bmpFile);  // file size
-    (void)read32(bmpFile);  // Read & ignore creator bytes
-    bmpImageoffset = read32(bmpFile); // Start of image data
-    // Read DIB header
-    (void)read32(bmpFile); // header size
-    bmpWidth  = read32(bmpFile);
-    bmpHeight = read32(bmpFile);
-    if(read16(bmpFile) == 1) { // # planes -- must be '1'
-      bmpDepth = read16(bmpFile); // bits per pixel
-      if((bmpDepth == 24) && (read32(bmpFile) == 0)) { // 0 = uncompressed
-
-        goodBmp = true; // Supported BMP format -- proceed!
-
-        // BMP rows are padded (if needed) to 4-byte boundary
-        rowSize = (bmpWidth * 3 + 3) & ~3;
-
-        // If bmpHeight is negative, image is in top-down order.
-        // This is not canon but has been observed in the wild.
-        if(bmpHeight < 0) {
-          bmpHeight = -bmpHeight;
-          flip      = false;
-        }
-
-        // Crop area to be loaded
-        w = bmpWidth;
-        h = bmpHeight;
-        if((x+w-1) >= _display->width())  w = _display->width()  - x;
-        if((y+h-1) >= _display->height()) h = _display->height() - y;
-
-        // Set TFT address window to clipped image bounds
-        _display->startWrite(); // Start TFT transaction
-        _display->setAddrWindow(x, y, w, h);
-
-        for (row=0; row<h; row++) { // For each scanline...
-
-          // Seek to start of scan line.  It might seem labor-
-          // intensive to be doing this on every line, but this
-          // method covers a lot of gritty details like cropping
-          // and scanline padding.  Also, the seek only takes
-          // place if the file position actually needs to change
-          // (avoids a lot of cluster math in SD library).
-          if(flip) // Bitmap is stored bottom-to-top order (normal BMP)
-            pos = bmpImageoffset + (bmpHeight - 1 - row) * rowSize;
-          else     // Bitmap is stored top-to-bottom
-            pos = bmpImageoffset + row * rowSize;
-          if(bmpFile.position() != pos) { // Need seek?
-            _display->endWrite(); // End TFT transaction
-            bmpFile.seek(pos);
-            buffidx = sizeof(sdbuffer); // Force buffer reload
-            _display->startWrite(); // Start new TFT transaction
-          }
-
-          for (col=0; col<w; col++) { // For each pixel...
-            // Time to read more pixel data?
-            if (buffidx >= sizeof(sdbuffer)) { // Indeed
-              _display->endWrite(); // End TFT transaction
-              bmpFile.read(sdbuffer, sizeof(sdbuffer));
-              buffidx = 0; // Set index to beginning
-              _display->startWrite(); // Start new TFT transaction
-            }
-
-            // Convert pixel from BMP to TFT format, push to display
-            b = sdbuffer[buffidx++];
-            g = sdbuffer[buffidx++];
-            r = sdbuffer[buffidx++];
-            _display->pushColor(_display->color565(r,g,b));
-          } // end pixel
-        } // end scanline
-        _display->endWrite(); // End last TFT transaction
-      } // end goodBmp
-    }
-  }
-  bmpFile.close();
-}
-
-// ____________________________________________________________________________
-uint16_t bmpReader::read16(File &f) {
-  // entirely copied from Adafruit
-  uint16_t result;
-  ((uint8_t *)&result)[0] = f.read(); // LSB
-  ((uint8_t *)&result)[1] = f.read(); // MSB
-  return result;
-}
-
-// ____________________________________________________________________________
-uint32_t bmpReader::read32(File &f) {
-  // entirely copied from Adafruit
-  uint32_t result;
-  ((uint8_t *)&result)[0] = f.read(); // LSB
-  ((uint8_t *)&result)[1] = f.read();
-  ((uint8_t *)&result)[2] = f.read();
-  ((uint8_t *)&result)[3] = f.read(); // MSB
-  return result;
-}
\ No newline at end of file
+/******************************************************************************
+ * 
+ * Read bmp files and print them on display.
+ * 
+ * Further documentation in .h file
+ * 
+ * created        14.04.2021
+ * last modified  16.10.2026
+ * by             Jannik Sehringer (adapted from Adafruit example code)
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "bmpDraw.h"
+
+// ____________________________________________________________________________
+uint16_t bmpReaderBase::read16(File &f) {
+  // entirely copied from Adafruit
+  uint16_t result;
+  ((uint8_t *)&result)[0] = f.read(); // LSB
+  ((uint8_t *)&result)[1] = f.read(); // MSB
+  return result;
+}
+
+// ____________________________________________________________________________
+uint32_t bmpReaderBase::read32(File &f) {
+  // entirely copied from Adafruit
+  uint32_t result;
+  ((uint8_t *)&result)[0] = f.read(); // LSB
+  ((uint8_t *)&result)[1] = f.read();
+  ((uint8_t *)&result)[2] = f.read();
+  ((uint8_t *)&result)[3] = f.read(); // MSB
+  return result;
+}
+
+// ____________________________________________________________________________
+String bmpReaderBase::rawName(const char* filename) {
+  String name = filename;
+  int16_t dot = name.lastIndexOf('.');
+  String extension = name.substring(dot + 1);
+  if (dot >= 0 && extension.equalsIgnoreCase("bmp")) {
+    name = name.substring(0, dot + 1) + RAW_EXTENSION;
+  }
+  return name;
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::open(SDClass& sd, const char* filename) {
+  if (!(_file = sd.open(filename))) return false;
+  _bufferPos = _bufferLen = 0;
+
+  char magic[4];
+  bool good = false;
+  if (_file.read(magic, 4) == 4) {
+    if (memcmp(magic, RAW_MAGIC, 4) == 0) {
+      good = openRaw();
+    } else if (magic[0] == 'B' && magic[1] == 'M') {
+      good = openBmp();
+    }
+  }
+  if (!good) _file.close();
+  return good;
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::openRaw() {
+  _width  = read16(_file);
+  _height = read16(_file);
+  _format = (_file.read() & RAW_FLAG_RLE) ? RAW_RLE : RAW;
+  _flip = false;
+  _bigEndian = true;
+  _imageOffset = RAW_HEADER_SIZE;
+  _rowSize = 2 * (uint32_t) _width;
+  return _file.seek(_imageOffset);
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::openBmp() {
+  _file.seek(10);
+  _imageOffset         = read32(_file);   // start of image data
+  uint32_t headerSize  = read32(_file);   // size of DIB header
+  int32_t  width       = read32(_file);
+  int32_t  height      = read32(_file);   // negative: stored top-to-bottom
+  uint16_t planes      = read16(_file);
+  _depth               = read16(_file);
+  uint32_t compression = read32(_file);
+  _file.seek(46);
+  uint32_t colors      = read32(_file);   // palette entries, 0: all
+
+  if (headerSize < 40 || planes != 1 || width <= 0 || width > 0xFFFF
+      || height == 0 || height < -0xFFFF || height > 0xFFFF) {
+    return false;
+  }
+  _width  = width;
+  _height = height < 0 ? -height : height;
+  _flip   = height > 0;
+  _bigEndian = false;
+  _rgb555 = false;
+
+  if (compression == 0
+      && (_depth == 1 || _depth == 4 || _depth == 8 || _depth == 16
+          || _depth == 24)) {
+    _format = BMP;
+    _rgb555 = _depth == 16;   // default 16 bit format
+  } else if (compression == 1 && _depth == 8) {
+    _format = BMP_RLE8;
+  } else if (compression == 3 && _depth == 16) {
+    // bit fields, the masks follow the 40 byte header
+    _format = BMP;
+    _file.seek(54);
+    uint32_t red = read32(_file);
+    if (red == 0x7C00) {
+      _rgb555 = true;
+    } else if (red != 0xF800) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  if (_depth <= 8) {
+    // convert the palette once instead of every pixel
+    memset(_palette, 0, sizeof(_palette));
+    if (colors == 0 || colors > (1UL << _depth)) colors = 1UL << _depth;
+    _file.seek(14 + headerSize);
+    for (uint16_t i = 0; i < colors; i++) {
+      uint8_t bgra[4];
+      if (_file.read(bgra, 4) != 4) return false;
+      _palette[i] = color565(bgra[2], bgra[1], bgra[0]);
+    }
+  }
+
+  // bmp rows are padded (if needed) to 4-byte boundary
+  _rowSize = (((uint32_t) _width * _depth + 31) / 32) * 4;
+  _rleEnd = false;
+  _rleSkipRows = 0;
+  _rleColumn = 0;
+  return _file.seek(_imageOffset);
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::readRow(uint16_t* line, uint16_t first, uint16_t w) {
+  switch (_format) {
+    case RAW:
+    case RAW_RLE:   return readRawRow(line, first, w);
+    case BMP:       return readBmpRow(line, first, w);
+    case BMP_RLE8:  return readRle8Row(line, first, w);
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::seekRow(uint16_t n) {
+  if (_format != RAW && _format != BMP) return false;
+  _bufferPos = _bufferLen = 0;
+  return _file.seek(_imageOffset + n * _rowSize);
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::readRawRow(uint16_t* line, uint16_t first, uint16_t w) {
+  if (_format == RAW) {
+    // uncompressed, read visible pixels and skip the rest of the row
+    skip(2 * (uint32_t) first);
+    if (_file.read(line, 2*w) != 2*w) return false;
+    skip(2 * (uint32_t) (_width - first - w));
+    return true;
+  }
+  uint16_t col = 0;     // column of the next packet
+  uint16_t end = first + w;
+  while (col < _width) {
+    int c = _file.read();   // control byte of next packet
+    if (c < 0) return false;
+    uint16_t n = (c & 0x7F) + 1;
+    // part of the packet that is visible
+    uint16_t from = max(col, first);
+    uint16_t to = min((uint16_t) (col + n), end);
+    uint16_t visible = from < to ? to - from : 0;
+    if (c & 0x80) {
+      // run of a single pixel
+      uint16_t pixel;
+      if (_file.read(&pixel, 2) != 2) return false;
+      for (uint16_t i = 0; i < visible; i++) line[from - first + i] = pixel;
+    } else if (visible) {
+      // literal pixels
+      skip(2 * (from - col));
+      if (_file.read(line + from - first, 2*visible) != 2*visible) {
+        return false;
+      }
+      skip(2 * (col + n - to));
+    } else {
+      skip(2 * n);
+    }
+    col += n;
+  }
+  return true;
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::readBmpRow(uint16_t* line, uint16_t first, uint16_t w) {
+  // bit of the row the first pixel starts, the rest of the row is skipped
+  uint32_t start = (uint32_t) first * _depth;
+  uint32_t used = (start + (uint32_t) w * _depth + 7) / 8;
+  skip(start / 8);
+  if (_depth == 16) {
+    // little endian pixels can be used as they are
+    if (_file.read(line, 2*w) != 2*w) return false;
+    if (_rgb555) {
+      for (uint16_t i = 0; i < w; i++) {
+        uint16_t c = line[i];
+        line[i] = ((c & 0x7FE0) << 1) | ((c & 0x0200) >> 4) | (c & 0x001F);
+      }
+    }
+  } else if (_depth == 24) {
+    for (uint16_t i = 0; i < w; i++) {
+      int b = nextByte();
+      int g = nextByte();
+      int r = nextByte();
+      if (r < 0) return false;
+      line[i] = color565(r, g, b);
+    }
+  } else {
+    // palette indices, the leftmost pixel in the most significant bits
+    uint8_t mask = (1 << _depth) - 1;
+    uint8_t bits = 0;   // bits left in current byte
+    int byte = 0;
+    if (w && start % 8) {
+      if ((byte = nextByte()) < 0) return false;
+      bits = 8 - start % 8;
+    }
+    for (uint16_t i = 0; i < w; i++) {
+      if (bits == 0) {
+        if ((byte = nextByte()) < 0) return false;
+        bits = 8;
+      }
+      bits -= _depth;
+      line[i] = _palette[(byte >> bits) & mask];
+    }
+  }
+  skip(_rowSize - used);
+  return true;
+}
+
+// ____________________________________________________________________________
+bool bmpReaderBase::readRle8Row(uint16_t* line, uint16_t first, uint16_t w) {
+  // pixels skipped by a delta or the end of the bitmap get color 0
+  for (uint16_t i = 0; i < w; i++) line[i] = _palette[0];
+  if (_rleEnd) return true;
+  if (_rleSkipRows) {
+    _rleSkipRows--;
+    return true;
+  }
+
+  uint16_t col = _rleColumn;
+  uint16_t end = first + w;
+  _rleColumn = 0;
+  while (true) {
+    int n = nextByte();
+    int c = nextByte();
+    if (c < 0) return false;
+    if (n > 0) {
+      // encoded run of n pixels of color c
+      for (; n > 0; n--, col++) {
+        if (col >= first && col < end) line[col - first] = _palette[c];
+      }
+    } else if (c == 0) {
+      return true;            // end of line
+    } else if (c == 1) {
+      _rleEnd = true;         // end of bitmap
+      return true;
+    } else if (c == 2) {
+      // delta, continue dx pixels right and dy rows down
+      int dx = nextByte();
+      int dy = nextByte();
+      if (dy < 0) return false;
+      col += dx;
+      if (dy > 0) {
+        _rleSkipRows = dy - 1;
+        _rleColumn = col;
+        return true;
+      }
+    } else {
+      // absolute mode, c literal pixels padded to 16 bit
+      for (n = 0; n < c; n++, col++) {
+        int i = nextByte();
+        if (i < 0) return false;
+        if (col >= first && col < end) line[col - first] = _palette[i];
+      }
+      if (c & 1) nextByte();
+    }
+  }
+}
+
+// ____________________________________________________________________________
+int bmpReaderBase::nextByte() {
+  if (_bufferPos >= _bufferLen) {
+    int n = _file.read(_buffer, sizeof(_buffer));
+    if (n <= 0) return -1;
+    _bufferLen = n;
+    _bufferPos = 0;
+  }
+  return _buffer[_bufferPos++];
+}
+
+// ____________________________________________________________________________
+void bmpReaderBase::skip(uint32_t n) {
+  uint32_t buffered = _bufferLen - _bufferPos;
+  if (n <= buffered) {
+    _bufferPos += n;
+  } else {
+    // the file position is behind the buffered bytes
+    _file.seek(_file.position() + n - buffered);
+    _bufferPos = _bufferLen = 0;
+  }
+}
@@ -1,75 +1,307 @@
-/******************************************************************************
- * 
- * Read bmp files and print them on display.
- * 
- * A function to read a bmp file from an SD card and directly print it on
- * a display with its helper functions to read data from files put together
- * in a class. The class used to controll the display must be derived from
- * "Adafruit_SPITFT".
- * 
- * Circuit:
- *  - Adafruit TFT FeatherWing - 3,5" 480x320
- *      other displays might work to, provided there is a library derived
- *      from "Adafruit_SPITFT" to controll them. Make sure to change
- *      DISPLAY_TYPE accordingly.
- *  - A SD-card socket
- *      is provided on the Adafruit TFT FeatherWing - 3,5" 480x320
- * 
- * created        14.04.2021
- * last modified  29.05.2021
- * by             Jannik Sehringer (adapted from Adafruit example code)
- * for            Laboratory for Sensors,
- *                IMTEK - Department of Microsystems Engineering,
- *                University of Freiburg
- * 
- * /***************************************************
-  This is our library for the Adafruit HX8357D FeatherWing
-  ----> http://www.adafruit.com/products/3651
-
-  Check out the links above for our tutorials and wiring diagrams
-  These displays use SPI to communicate, 4 or 5 pins are required to
-  interface (RST is optional)
-  Adafruit invests time and resources providing this open source code,
-  please support Adafruit and open-source hardware by purchasing
-  products from Adafruit!
-
-  Written by Limor Fried/Ladyada for Adafruit Industries.
-  MIT license, all text above must be included in any redistribution
- ****************************************************
- * 
- * This code was adapted from Adafruit and slightly modified.
- * The original code can be found in the example
- * "bitmapdraw_feahterwing.ino" in the Adafruit_HX8357_Library.
- * 
-******************************************************************************/
-
-#ifndef _BMP_DRAW__H_
-#define _BMP_DRAW__H_
-
-#include <Adafruit_HX8357.h>
-#include <SD.h>
-#include "Graphics.h"
-
-
-// The main function opens a Windows Bitmap (BMP) file
-// and displays it at the given coordinates.  It's sped
-// up by reading many pixels worth of data at a time
-// (rather than pixel by pixel).  Increasing the buffer
-// size takes more of the Arduino's precious RAM but
-// makes loading a little faster.  50 pixels seems a
-// good balance.
-#define BUFFPIXEL 50
-
-class bmpReader : public Graphics {
- public:
-  // draw the bmp file of given name on display position (x, y)
-  static void draw(const char* filename, int16_t x, int16_t y);
-
- private:
-  // read 2 bytes from the given file
-  static uint16_t read16(File &f);
-  // read 4 bytes from the given file
-  static uint32_t read32(File &f);
-};
-
-#endif  // _BMP_DRAW__H_
\ No newline at end of file
+/******************************************************************************
+ * 
+ * Read bmp files and print them on display.
+ * 
+ * A function to read a bmp file from an SD card and directly print it on
+ * a display with its helper functions to read data from files put together
+ * in a class. The file is streamed row by row, supported are uncompressed
+ * bmp files with 1, 4 or 8 bit palettes, 16 bit (RGB565 or RGB555) and
+ * 24 bit colors as well as RLE8 compressed 8 bit bmp files. Palettes are
+ * converted to RGB565 once when the file is opened.
+ * Besides bmp files images can be stored in a native RGB565 raw
+ * format, created by Tools/ImageConv from bmp or png files. Its pixels are
+ * already in the format of the display and are streamed without any
+ * conversion, optionally run length encoded. If a raw image with the same
+ * name but extension ".565" exists next to a bmp file, it is drawn instead.
+ * 
+ * Raw format (all values little endian):
+ *  char     magic[4]     "R565"
+ *  uint16_t width
+ *  uint16_t height
+ *  uint8_t  flags        bit 0: rows are run length encoded
+ *  uint8_t  reserved[3]
+ *  followed by the rows from top to bottom, each pixel as RGB565 in big
+ *  endian byte order. Run length encoded rows consist of packets starting
+ *  with a control byte c: if bit 7 is set, the next pixel is repeated
+ *  (c & 0x7F) + 1 times, otherwise c + 1 pixels follow literally.
+ *  Packets never span two rows.
+ * 
+ * Only a part of an image can be drawn by giving the rectangle to draw in
+ * image coordinates, e.g. to repair a part of the screen. The image may
+ * also start left of or above the screen. Rows and columns outside are
+ * skipped in the file, only compressed rows need to be read one after
+ * another.
+ * 
+ * Images can also be drawn progressively: begin() opens the file and every
+ * call of drawRows() draws a given number of rows. So other work like
+ * resetting the watchdog can be done in between without waiting for the
+ * whole image.
+ * 
+ * The class used to controll the display is given as template parameter
+ * Display, it must provide the following methods of
+ * "Adafruit_SPITFT" in addition to those listed in Graphics.h:
+ *  int16_t width()
+ *  int16_t height()
+ *  startWrite()
+ *  endWrite()
+ *  setAddrWindow(uint16_t, uint16_t, uint16_t, uint16_t)
+ *  writePixels(uint16_t*, uint32_t, bool, bool)
+ * 
+ * Circuit:
+ *  - Adafruit TFT FeatherWing - 3,5" 480x320
+ *      other displays might work to, provided there is a library derived
+ *      from "Adafruit_SPITFT" to controll them. Pass its class as template
+ *      parameter to bmpReader.
+ *  - A SD-card socket
+ *      is provided on the Adafruit TFT FeatherWing - 3,5" 480x320
+ * 
+ * created        14.04.2021
+ * last modified  16.10.2026
+ * by             Jannik Sehringer (adapted from Adafruit example code)
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+ * /***************************************************
+  This is our library for the Adafruit HX8357D FeatherWing
+  ----> http://www.adafruit.com/products/3651
+
+  Check out the links above for our tutorials and wiring diagrams
+  These displays use SPI to communicate, 4 or 5 pins are required to
+  interface (RST is optional)
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  Written by Limor Fried/Ladyada for Adafruit Industries.
+  MIT license, all text above must be included in any redistribution
+ ****************************************************
+ * 
+ * This code was adapted from Adafruit and slightly modified.
+ * The original code can be found in the example
+ * "bitmapdraw_feahterwing.ino" in the Adafruit_HX8357_Library.
+ * 
+******************************************************************************/
+
+#ifndef _BMP_DRAW__H_
+#define _BMP_DRAW__H_
+
+#include <Arduino.h>
+#include <SD.h>
+#include "Graphics.h"
+
+
+// Bytes of bmp files are read from the SD card in chunks of BUFFPIXEL
+// 24 bit pixels. Increasing the buffer size takes more of the Arduino's
+// precious RAM but makes loading a little faster. 50 pixels seems a
+// good balance.
+#define BUFFPIXEL 50
+
+// raw image format
+#define RAW_MAGIC       "R565"  ///< signature at the start of raw images
+#define RAW_EXTENSION   "565"   ///< extension of raw images
+#define RAW_HEADER_SIZE 12      ///< bytes before the first row
+#define RAW_FLAG_RLE    0x01    ///< rows are run length encoded
+
+/* Reads the rows of an image file, independent of the display. */
+class bmpReaderBase {
+ protected:
+  // an image still open is closed
+  ~bmpReaderBase() { close(); }
+
+  // open the image file of given name and read its header, return false if
+  // it does not exist or its format is not supported
+  bool open(SDClass& sd, const char* filename);
+  // close the opened image file
+  void close() { _file.close(); }
+  // read the next row stored in the file into line, only the w pixels
+  // starting at column first are stored and w = 0 skips the row, return
+  // false on read error
+  bool readRow(uint16_t* line, uint16_t first, uint16_t w);
+  // continue reading at the n-th row stored in the file, return false if
+  // the rows are compressed and must be read one after another
+  bool seekRow(uint16_t n);
+  // image row of the n-th row stored in the file
+  uint16_t rowIndex(uint16_t n) const { return _flip ? _height - 1 - n : n; }
+
+  // read 2 bytes from the given file
+  static uint16_t read16(File &f);
+  // read 4 bytes from the given file
+  static uint32_t read32(File &f);
+  // name of the raw image belonging to a bmp file, given name if not a bmp
+  static String rawName(const char* filename);
+
+  uint16_t _width;    ///< width of the opened image in pixels
+  uint16_t _height;   ///< height of the opened image in pixels
+  bool _flip;         ///< rows are stored bottom-to-top (normal bmp)
+  bool _bigEndian;    ///< pixels are read in the byte order of the display
+
+ private:
+  // supported storage formats
+  enum Format : uint8_t { RAW, RAW_RLE, BMP, BMP_RLE8 };
+
+  // read the header of a raw image, magic already read
+  bool openRaw();
+  // read the header and palette of a bmp file, signature already read
+  bool openBmp();
+  // read a row of the different formats, see readRow()
+  bool readRawRow(uint16_t* line, uint16_t first, uint16_t w);
+  bool readBmpRow(uint16_t* line, uint16_t first, uint16_t w);
+  bool readRle8Row(uint16_t* line, uint16_t first, uint16_t w);
+  // next byte of the file through the buffer, -1 at the end of the file
+  int nextByte();
+  // skip given number of bytes in the file
+  void skip(uint32_t n);
+  // convert 8 bit color components to RGB565
+  static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+  File _file;                     ///< opened image file
+  Format _format;                 ///< storage format of the opened image
+  uint8_t _depth;                 ///< bits per pixel of bmp files
+  bool _rgb555;                   ///< 16 bit bmp pixels are RGB555
+  uint32_t _imageOffset;          ///< start of the rows in the file
+  uint32_t _rowSize;              ///< bytes per row
+  uint16_t _palette[256];         ///< palette converted to RGB565
+  uint8_t _buffer[3*BUFFPIXEL];   ///< bytes read ahead from the file
+  uint8_t _bufferPos;             ///< next byte to use from the buffer
+  uint8_t _bufferLen;             ///< number of bytes in the buffer
+  bool _rleEnd;                   ///< RLE8 end of bitmap reached
+  uint16_t _rleSkipRows;          ///< RLE8 rows skipped by a delta
+  uint16_t _rleColumn;            ///< RLE8 column to continue after a delta
+};
+
+template <class Display>
+class bmpReader : public Graphics<Display>, protected bmpReaderBase {
+ protected:
+  using Graphics<Display>::_display;
+
+ public:
+  // take the display to draw on and the SD card to read the files from
+  bmpReader(Display* display, SDClass& sd = SD)
+    : Graphics<Display>(display), _sd(sd), _next(0), _end(0) {}
+
+  // draw the image file of given name on display position (x, y)
+  // a raw image of the same name is preferred, see above
+  void draw(const char* filename, int16_t x, int16_t y);
+  // draw only the part src of the image, given in image coordinates,
+  // the image is placed on display position (x, y) as above
+  void draw(const char* filename, int16_t x, int16_t y,
+            const Layout::Rect& src);
+
+  // open the image file of given name to be drawn progressively on display
+  // position (x, y), optionally only the part src of it, return false if
+  // there is nothing to draw
+  bool begin(const char* filename, int16_t x, int16_t y);
+  bool begin(const char* filename, int16_t x, int16_t y,
+             const Layout::Rect& src);
+  // draw the next count rows of the image opened by begin(), return true
+  // as long as rows are left
+  bool drawRows(uint16_t count);
+
+ private:
+  SDClass& _sd;     ///< SD card the files are read from
+  int16_t _x;       ///< display position of the image
+  int16_t _y;
+  uint16_t _left;   ///< first visible column of the image
+  uint16_t _w;      ///< number of visible columns
+  uint16_t _top;    ///< first visible row of the image
+  uint16_t _h;      ///< number of visible rows
+  uint16_t _next;   ///< next row stored in the file to be read
+  uint16_t _first;  ///< first and end of the rows stored in the file that
+  uint16_t _end;    ///< are visible
+};
+
+// ____________________________________________________________________________
+template <class Display>
+void bmpReader<Display>::draw(const char* filename, int16_t x, int16_t y) {
+  if (begin(filename, x, y)) {
+    while (drawRows(UINT16_MAX)) {}
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+void bmpReader<Display>::draw(const char* filename, int16_t x, int16_t y,
+                              const Layout::Rect& src) {
+  if (begin(filename, x, y, src)) {
+    while (drawRows(UINT16_MAX)) {}
+  }
+}
+
+// ____________________________________________________________________________
+template <class Display>
+bool bmpReader<Display>::begin(const char* filename, int16_t x, int16_t y) {
+  return begin(filename, x, y, {0, 0, INT16_MAX, INT16_MAX});
+}
+
+// ____________________________________________________________________________
+template <class Display>
+bool bmpReader<Display>::begin(const char* filename, int16_t x, int16_t y,
+                               const Layout::Rect& src) {
+  _next = _end = 0;   // drawRows() draws nothing unless opened below
+  if ((x >= _display->width()) || (y >= _display->height())) return false;
+  // if there is no raw image of the name use the file itself
+  if (!open(_sd, rawName(filename).c_str()) && !open(_sd, filename)) {
+    return false;
+  }
+
+  // crop area to be drawn to the image, the screen and the given part,
+  // a line can never be wider than the screen
+  int32_t left   = max(max((int32_t) src.x, -(int32_t) x), (int32_t) 0);
+  int32_t top    = max(max((int32_t) src.y, -(int32_t) y), (int32_t) 0);
+  int32_t right  = min(min((int32_t) src.x + src.w, (int32_t) _width),
+                       (int32_t) _display->width() - x);
+  int32_t bottom = min(min((int32_t) src.y + src.h, (int32_t) _height),
+                       (int32_t) _display->height() - y);
+  right = min(right, left + Layout::SCREEN_W);
+  if (left >= right || top >= bottom) {
+    close();
+    return false;
+  }
+  _x = x;
+  _y = y;
+  _left = left;
+  _w = right - left;
+  _top = top;
+  _h = bottom - top;
+
+  // rows stored in the file that are visible, bmp files are usually stored
+  // bottom-to-top
+  _first = _flip ? _height - bottom : top;
+  _end   = _flip ? _height - top : bottom;
+  // jump to the first visible row, compressed rows are skipped by reading
+  _next = seekRow(_first) ? _first : 0;
+  return true;
+}
+
+// ____________________________________________________________________________
+template <class Display>
+bool bmpReader<Display>::drawRows(uint16_t count) {
+  uint16_t line[Layout::SCREEN_W];
+
+  // rows are drawn in the order they are stored, so bmp files stored
+  // bottom-to-top are read without seeking back for every row
+  for (; count > 0 && _next < _end; _next++) {
+    if (_next < _first) {
+      // skip compressed row above or below the visible part
+      if (!readRow(line, 0, 0)) break;
+      continue;
+    }
+    // read the whole row first, as SD card and display share the SPI bus
+    if (!readRow(line, _left, _w)) break;
+    _display->startWrite();
+    _display->setAddrWindow(_x + _left, _y + rowIndex(_next), _w, 1);
+    _display->writePixels(line, _w, true, _bigEndian);
+    _display->endWrite();
+    count--;
+  }
+  if (count == 0 && _next < _end) return true;
+  // all rows drawn or a read error
+  _next = _end;
+  close();
+  return false;
+}
+
+#endif  // _BMP_DRAW__H_
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * 
+ * Fit the air change rate of a room from the decays of its CO2.
+ * 
+ * Host program printing the decays found in data files with the air change
+ * rate of each, and the median of the ones fitting well as value for
+ * "ach" in the settings file of the device, see Firmware/Settings.h. The
+ * fitting is done by AirChange.h, which can also be included by other
+ * analysis programs.
+ * 
+ * Usage:
+ *  airchange [-o outdoor] [-m minutes] data.csv ...
+ *    -o  outdoor CO2 in ppm, default 417 as BACKGROUND_CO2 of the firmware
+ *    -m  shortest decay in minutes, default 60
+ * 
+ * Build from the repository root:
+ *  g++ -O2 -o airchange Tools/AirChange/AirChange.cpp
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include "AirChange.h"
+
+const double MIN_R2 = 0.95;   ///< decays fitting worse are not in the median
+
+// ____________________________________________________________________________
+// print a unix time as "YYYY/MM/DD hh:mm"
+static void printTime(uint32_t unixTime) {
+  time_t time = unixTime;
+  struct tm* t = gmtime(&time);
+  printf("%i/%02i/%02i %02i:%02i", t->tm_year + 1900, t->tm_mon + 1,
+         t->tm_mday, t->tm_hour, t->tm_min);
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  double outdoor = 417;
+  int minutes = 60;
+  int arg = 1;
+  for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+    if (!strcmp(argv[arg], "-o")) {
+      outdoor = atof(argv[arg + 1]);
+    } else if (!strcmp(argv[arg], "-m")) {
+      minutes = atoi(argv[arg + 1]);
+    } else {
+      break;
+    }
+  }
+  if (arg >= argc) {
+    fprintf(stderr, "usage: %s [-o outdoor] [-m minutes] data.csv ...\n",
+            argv[0]);
+    return 1;
+  }
+
+  // files in the order of time, e.g. Data/2026/10/*.csv
+  std::vector<AirChange::Point> points;
+  for (; arg < argc; arg++) {
+    if (!AirChange::readFile(argv[arg], points)) {
+      fprintf(stderr, "cannot read %s\n", argv[arg]);
+      return 1;
+    }
+  }
+
+  std::vector<double> good;
+  printf("start, end, co2 start, co2 end, ach, r2\n");
+  for (auto& decay : AirChange::findDecays(points, outdoor, minutes)) {
+    printTime(decay.start);
+    printf(", ");
+    printTime(decay.end);
+    printf(", %.0f, %.0f, %.2f, %.3f\n", decay.from, decay.to, decay.ach,
+           decay.r2);
+    if (decay.r2 >= MIN_R2 && decay.ach > 0) good.push_back(decay.ach);
+  }
+  if (good.empty()) {
+    fprintf(stderr, "no decay with r2 >= %.2f found\n", MIN_R2);
+    return 1;
+  }
+  std::sort(good.begin(), good.end());
+  fprintf(stderr, "%zu decays with r2 >= %.2f, settings: ach = %.2f\n",
+          good.size(), MIN_R2, good[good.size() / 2]);
+  return 0;
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * 
+ * Fit the air change rate of a room from the decays of its CO2.
+ * 
+ * Header-only host library. When a room is left with windows closed, its
+ * CO2 falls towards the outdoor level C_outdoor with the air change rate n
+ * of the room:
+ * 
+ *  C(t) - C_outdoor = (C(0) - C_outdoor) exp(-n t)
+ * 
+ * The samples of the data files are averaged per minute. A decay is a run
+ * of minutes in which the CO2 never rises more than TOLERANCE above its
+ * lowest value so far, lasting at least the given minutes and starting at
+ * least MIN_EXCESS above C_outdoor. Minutes less than END_EXCESS above
+ * C_outdoor are left out, there noise dominates. A line fitted to
+ * ln(C - C_outdoor) over the time in hours has the slope -n, its R² tells
+ * how exponential the decay is.
+ * 
+ * Windows opened give decays too, but short ones, so a minimum of one hour
+ * mostly leaves the evenings and nights with the room empty. People still
+ * in the room make n too low.
+ * 
+ * Usage:
+ *  #include "AirChange.h"
+ *  std::vector<AirChange::Point> points;
+ *  AirChange::readFile("Data/2026/10/16.csv", points);
+ *  for (auto& decay : AirChange::findDecays(points, 417, 60)) { ... }
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _AIR_CHANGE__H_
+#define _AIR_CHANGE__H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace AirChange {
+
+const double TOLERANCE  = 10;   ///< ppm a decay may rise above its minimum
+const double MIN_EXCESS = 150;  ///< ppm above outdoors a decay starts at
+const double END_EXCESS = 50;   ///< ppm above outdoors minutes are used
+
+/* CO2 averaged over one minute */
+struct Point {
+  uint32_t time;      ///< unix time of the start of the minute
+  double co2;         ///< mean CO2 in ppm
+};
+
+/* A decay of the CO2 */
+struct Decay {
+  uint32_t start, end;  ///< unix time of the first and last minute
+  double from, to;      ///< CO2 at start and end in ppm
+  double ach;           ///< air changes per hour
+  double r2;            ///< coefficient of determination of the fit
+};
+
+// ____________________________________________________________________________
+// seconds since 1.1.1970 of the given date and time, as in DataIndex.h
+inline uint32_t unixTime(int year, int month, int day,
+                         int hour, int minute, int second) {
+  // days from civil date, year starting in March
+  year -= month <= 2;
+  int era = year / 400;
+  int yoe = year - era * 400;
+  int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  int32_t days = era * 146097 + doe - 719468;
+  return days * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+// ____________________________________________________________________________
+// append the minute means of the lines "YYYY/MM/DD hh:mm:ss[.mmm], co2,
+// ..." of a data file to points, false if it can't be read
+inline bool readFile(const std::string& filename, std::vector<Point>& points) {
+  FILE* file = fopen(filename.c_str(), "r");
+  if (!file) return false;
+  char line[256];
+  uint32_t minute = 0;
+  double sum = 0;
+  int count = 0;
+  while (fgets(line, sizeof(line), file)) {
+    int year, month, day, hour, min, sec, co2, length;
+    if (sscanf(line, "%4d/%2d/%2d %2d:%2d:%2d%n", &year, &month, &day,
+               &hour, &min, &sec, &length) != 6) {
+      continue;   // header or comment
+    }
+    // the ms of newer files are skipped
+    const char* comma = strchr(line + length, ',');
+    if (!comma || sscanf(comma, ", %d", &co2) != 1) continue;
+    uint32_t time = unixTime(year, month, day, hour, min, 0);
+    if (count && time != minute) {
+      points.push_back(Point{minute, sum / count});
+      sum = 0;
+      count = 0;
+    }
+    minute = time;
+    sum += co2;
+    count++;
+  }
+  if (count) points.push_back(Point{minute, sum / count});
+  fclose(file);
+  return true;
+}
+
+// ____________________________________________________________________________
+// fit the decay of the points first to last towards outdoor
+inline Decay fitDecay(const std::vector<Point>& points, size_t first,
+                      size_t last, double outdoor) {
+  double n = 0, st = 0, sy = 0, stt = 0, sty = 0, syy = 0;
+  for (size_t i = first; i <= last; i++) {
+    if (points[i].co2 - outdoor < END_EXCESS) continue;
+    double t = (points[i].time - points[first].time) / 3600.0;
+    double y = log(points[i].co2 - outdoor);
+    n++; st += t; sy += y; stt += t * t; sty += t * y; syy += y * y;
+  }
+  Decay decay = {points[first].time, points[last].time,
+                 points[first].co2, points[last].co2, 0, 0};
+  double dt = n * stt - st * st, dy = n * syy - sy * sy;
+  if (n < 3 || dt <= 0) return decay;
+  double slope = (n * sty - st * sy) / dt;
+  decay.ach = -slope;
+  decay.r2 = dy > 0 ? slope * slope * dt / dy : 0;
+  return decay;
+}
+
+// ____________________________________________________________________________
+// all decays of at least given minutes, points in the order of time
+inline std::vector<Decay> findDecays(const std::vector<Point>& points,
+                                     double outdoor, int minutes) {
+  std::vector<Decay> decays;
+  size_t i = 0;
+  while (i < points.size()) {
+    // extend the decay while the CO2 stays near its minimum, without gaps
+    size_t j = i;
+    double lowest = points[i].co2;
+    while (j + 1 < points.size()
+           && points[j + 1].time - points[j].time <= 120
+           && points[j + 1].co2 <= lowest + TOLERANCE
+           && points[j + 1].co2 - outdoor >= END_EXCESS) {
+      j++;
+      if (points[j].co2 < lowest) lowest = points[j].co2;
+    }
+    if (points[i].co2 - outdoor >= MIN_EXCESS
+        && points[j].time - points[i].time >= minutes * 60U) {
+      decays.push_back(fitDecay(points, i, j, outdoor));
+      i = j + 1;
+    } else {
+      i++;
+    }
+  }
+  return decays;
+}
+
+}  // namespace AirChange
+
+#endif  // _AIR_CHANGE__H_
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * 
+ * Convert compressed data files into the CSV files of the firmware.
+ * 
+ * Host program printing the samples of a compressed data file as lines of
+ * the CSV format, so the usual tools can be used with them. Decoding is
+ * done by DataDecode.h, which can also be included by other analysis
+ * programs.
+ * 
+ * Usage:
+ *  datadecode 16.bin > 16.csv
+ * 
+ * Build from the repository root:
+ *  g++ -O2 -o datadecode Tools/DataDecode/DataDecode.cpp
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "DataDecode.h"
+
+// ____________________________________________________________________________
+// print a sample like a line of the CSV files, without time if the clock
+// of the device was not set
+static void print(const DataDecode::Sample& sample) {
+  if (sample.time) {
+    time_t time = sample.time;
+    struct tm* t = gmtime(&time);
+    printf("%i/%02i/%02i %02i:%02i:%02i", t->tm_year + 1900, t->tm_mon + 1,
+           t->tm_mday, t->tm_hour, t->tm_min, t->tm_sec);
+  }
+  printf(", %i, %.2f, %.2f\n", sample.co2, sample.temp / 100.0,
+         sample.rh / 100.0);
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s data.bin\n", argv[0]);
+    return 1;
+  }
+  printf("dateTime, co2, temp, rh\n");
+  size_t count = 0;
+  DataDecode::Statistics statistics;
+  bool good = DataDecode::decodeFile(argv[1], [&](
+      const DataDecode::Sample& sample) {
+    print(sample);
+    count++;
+  }, &statistics);
+  if (!good) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "%zu samples, %zu blocks, %zu partial blocks (%zu ended "
+                  "at invalid data), %zu bytes skipped\n", count,
+          statistics.blocks, statistics.partial, statistics.invalid,
+          statistics.skipped);
+  return 0;
+}
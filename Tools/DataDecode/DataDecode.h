@@ -0,0 +1,272 @@
+/******************************************************************************
+ * 
+ * Decode the compressed data files of the firmware.
+ * 
+ * Header-only host library reading the blocks of delta encoded samples
+ * written by Firmware/Compressor.cpp, see Firmware/Compressor.h for the
+ * format. Every block is decoded on its own: a block with a valid trailer
+ * gives the number of samples it holds, a block without, e.g. the last one
+ * written before a reset, is read until the bits end at the next block or
+ * the end of the file. Bytes between blocks are skipped.
+ * 
+ * A block without trailer has no CRC, so its samples are checked against
+ * the range of the SCD30 and reading stops at the first one outside. Older
+ * firmware wrote the note "# N lines lost" into the file if data was lost,
+ * followed by the rest of the block cut by the loss. Such a block ends at
+ * the note and the bytes up to the next block are skipped.
+ * 
+ * Usage:
+ *  #include "DataDecode.h"
+ *  DataDecode::decodeFile("Data/2026/10/16.bin",
+ *                         [](const DataDecode::Sample& s) { ... });
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _DATA_DECODE__H_
+#define _DATA_DECODE__H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace DataDecode {
+
+// constants of the format, as in Firmware/Compressor.h
+const uint32_t MAGIC   = 0x4B4C4243;  ///< "CBLK" at the start of a block
+const size_t   BLOCK   = 448;         ///< bytes of a block
+const size_t   HEADER  = 16;          ///< bytes before the bit stream
+const size_t   TRAILER = 4;           ///< bytes after the bit stream
+
+// range of the SCD30, samples of blocks without trailer outside are invalid
+const uint16_t MAX_CO2  = 40000;      ///< ppm
+const int16_t  MIN_TEMP = -4000;      ///< 0.01 °C
+const int16_t  MAX_TEMP = 7000;       ///< 0.01 °C
+const uint16_t MAX_RH   = 10000;      ///< 0.01 %
+
+/* One measurement */
+struct Sample {
+  uint32_t time;      ///< unix time
+  uint16_t co2;       ///< CO2 in ppm
+  int16_t temp;       ///< temperature in 0.01 °C
+  uint16_t rh;        ///< relative humidity in 0.01 %
+};
+
+/* Statistics of a decoded file */
+struct Statistics {
+  size_t blocks;      ///< blocks with a valid trailer
+  size_t partial;     ///< blocks without, read until the bits ended
+  size_t invalid;     ///< of those, ended early at invalid data
+  size_t skipped;     ///< bytes not belonging to a block
+};
+
+// ____________________________________________________________________________
+// little endian numbers
+inline uint16_t get16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+inline uint32_t get32(const uint8_t* p) {
+  return get16(p) | ((uint32_t) get16(p + 2) << 16);
+}
+
+// ____________________________________________________________________________
+// CRC-16/CCITT of given data
+inline uint16_t crc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+/* Reads a stream of bits, most significant bit first */
+class BitReader {
+ public:
+  BitReader(const uint8_t* data, size_t length)
+      : _data(data), _bits(length * 8), _position(0) {}
+
+  // read count bits, false if there are not as many left
+  bool read(int count, uint32_t* value) {
+    if (_position + count > _bits) return false;
+    *value = 0;
+    for (int i = 0; i < count; i++, _position++) {
+      int bit = (_data[_position / 8] >> (7 - _position % 8)) & 1;
+      *value = (*value << 1) | bit;
+    }
+    return true;
+  }
+  // read count bits as two's complement number
+  bool readSigned(int count, int32_t* value) {
+    uint32_t bits;
+    if (!read(count, &bits)) return false;
+    *value = (count < 32 && (bits >> (count - 1)) & 1)
+             ? (int32_t) (bits | (0xFFFFFFFFUL << count)) : (int32_t) bits;
+    return true;
+  }
+  // read a prefix of up to 4 ones ended by a zero, the number of ones
+  bool readPrefix(int* ones) {
+    uint32_t bit = 1;
+    for (*ones = 0; *ones < 4; (*ones)++) {
+      if (!read(1, &bit)) return false;
+      if (!bit) break;
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t* _data;
+  size_t _bits;
+  size_t _position;
+};
+
+// ____________________________________________________________________________
+// read a number of the bit stream with given widths after 0 to 4 ones
+inline bool readNumber(BitReader& reader, const int widths[5],
+                       int32_t* value) {
+  int ones;
+  if (!reader.readPrefix(&ones)) return false;
+  if (ones == 0) {
+    *value = 0;
+    return true;
+  }
+  return reader.readSigned(widths[ones], value);
+}
+
+// ____________________________________________________________________________
+// check if the values of a sample are in the range of the sensor
+inline bool plausible(const Sample& sample) {
+  return sample.co2 <= MAX_CO2 && sample.temp >= MIN_TEMP
+         && sample.temp <= MAX_TEMP && sample.rh <= MAX_RH;
+}
+
+// ____________________________________________________________________________
+// check if the note "# N lines lost\n" of older firmware starts at data
+inline bool lossNote(const uint8_t* data, size_t length) {
+  static const char END[] = " lines lost\n";
+  size_t i = 2;
+  if (length < i || data[0] != '#' || data[1] != ' ') return false;
+  while (i < length && data[i] >= '0' && data[i] <= '9') i++;
+  return i > 2 && length - i >= sizeof(END) - 1
+         && std::equal(END, END + sizeof(END) - 1, data + i);
+}
+
+// ____________________________________________________________________________
+// decode a block of given length, stopping after count samples or when
+// the bits end if count is 0. Returns the number of samples. If invalid is
+// given, decoding also stops before the first sample out of the range of
+// the sensor and sets it
+template <class Callback>
+size_t decodeBlock(const uint8_t* block, size_t length, size_t count,
+                   Callback callback, bool* invalid = NULL) {
+  static const int TIME_WIDTHS[5]  = {0, 7, 9, 12, 32};
+  static const int VALUE_WIDTHS[5] = {0, 4, 8, 12, 16};
+  if (length < HEADER || get32(block) != MAGIC) return 0;
+  Sample sample;
+  sample.time = get32(block + 4);
+  sample.co2  = get16(block + 8);
+  sample.temp = (int16_t) get16(block + 10);
+  sample.rh   = get16(block + 12);
+  if (invalid) {
+    *invalid = !plausible(sample);
+    if (*invalid) return 0;
+  }
+  callback(sample);
+
+  BitReader reader(block + HEADER, length - HEADER);
+  int32_t delta = 0;
+  size_t n = 1;
+  for (; count == 0 || n < count; n++) {
+    int32_t dod, co2, temp, rh;
+    if (!readNumber(reader, TIME_WIDTHS, &dod)
+        || !readNumber(reader, VALUE_WIDTHS, &co2)
+        || !readNumber(reader, VALUE_WIDTHS, &temp)
+        || !readNumber(reader, VALUE_WIDTHS, &rh)) {
+      break;
+    }
+    // modulo 2^32 like the encoder
+    delta = (uint32_t) delta + (uint32_t) dod;
+    sample.time += delta;
+    sample.co2  += co2;
+    sample.temp += temp;
+    sample.rh   += rh;
+    if (invalid && !plausible(sample)) {
+      *invalid = true;
+      break;
+    }
+    callback(sample);
+  }
+  return n;
+}
+
+// ____________________________________________________________________________
+// check if a complete block with a valid trailer starts at data
+inline bool complete(const uint8_t* data, size_t length) {
+  return length >= BLOCK && get32(data) == MAGIC
+         && crc16(data, BLOCK - 2) == get16(data + BLOCK - 2);
+}
+
+// ____________________________________________________________________________
+// decode all samples of a buffer holding a compressed data file
+template <class Callback>
+Statistics decode(const std::vector<uint8_t>& data, Callback callback) {
+  Statistics statistics = {0, 0, 0, 0};
+  size_t position = 0;
+  while (position + HEADER <= data.size()) {
+    const uint8_t* block = data.data() + position;
+    size_t left = data.size() - position;
+    if (complete(block, left)) {
+      decodeBlock(block, BLOCK - TRAILER, get16(block + BLOCK - 4), callback);
+      statistics.blocks++;
+      position += BLOCK;
+    } else if (get32(block) == MAGIC) {
+      // block without trailer, its bits end at the next block or a note
+      size_t end = HEADER;
+      while (end < left && end < BLOCK
+             && !(end + 4 <= left && get32(block + end) == MAGIC)
+             && !lossNote(block + end, left - end)) {
+        end++;
+      }
+      bool invalid;
+      decodeBlock(block, end, 0, callback, &invalid);
+      statistics.partial++;
+      statistics.invalid += invalid || lossNote(block + end, left - end);
+      position += end;
+    } else {
+      statistics.skipped++;
+      position++;
+    }
+  }
+  statistics.skipped += data.size() - position;
+  return statistics;
+}
+
+// ____________________________________________________________________________
+// decode all samples of a compressed data file, false if it can't be read
+template <class Callback>
+bool decodeFile(const std::string& filename, Callback callback,
+                Statistics* statistics = NULL) {
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (!file) return false;
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + n);
+  }
+  fclose(file);
+  Statistics result = decode(data, callback);
+  if (statistics) *statistics = result;
+  return true;
+}
+
+}  // namespace DataDecode
+
+#endif  // _DATA_DECODE__H_
@@ -0,0 +1,321 @@
+/******************************************************************************
+ * 
+ * Round trip of the compressed data files through encoder and decoder.
+ * 
+ * Host program compiling Firmware/Compressor.cpp and Firmware/Logger.cpp
+ * against the fakes of Tools/HostSim and decoding what they wrote with
+ * DataDecode.h:
+ *  - random samples with large jumps of time and values, written by one
+ *    or more starts of the encoder, the last block of each left without
+ *    trailer at a random sample, must be decoded exactly
+ *  - files of older firmware with a "# N lines lost" note and the rest of
+ *    the block cut by the loss behind it must give the samples before the
+ *    note and all of the following blocks, nothing else
+ *  - data written by the logger with the card out for hours must give the
+ *    samples not lost and nothing else, the loss noted in the text file
+ * It ends with exit code 1 if a result differs.
+ * 
+ * Usage:
+ *  datadecodetest [trials]     400 trials by default
+ * 
+ * Build and run from the repository root:
+ *  g++ -std=gnu++11 -O2 -ITools/HostSim/libraries -IFirmware \
+ *      -o datadecodetest Tools/DataDecode/DataDecodeTest.cpp \
+ *      Firmware/Compressor.cpp Firmware/Logger.cpp
+ *  ./datadecodetest
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <Arduino.h>
+#include "Compressor.h"
+#include "DataDecode.h"
+
+#define CARD_PIN 10   ///< chip select of the slot of the fake card
+
+/* Samples and the bytes of a compressed file written with them */
+struct Written {
+  std::vector<Sample> samples;
+  std::vector<uint8_t> file;
+};
+
+// ____________________________________________________________________________
+// next random sample: mostly small steps every 2 s, now and then a jump
+// of the time or of a value to anywhere in the range of the sensor
+static Sample nextSample(std::mt19937& random, const Sample& last) {
+  Sample s = last;
+  uint32_t r = random() % 100;
+  if (r == 0) {
+    s.time += (int32_t) (random() % 2000000) - 1000000;
+  } else if (r == 1) {
+    s.time = s.time ? 0 : random();   // clock lost or set
+  } else if (s.time) {
+    s.time += random() % 8 ? 2 : random() % 5;
+  }
+  r = random() % 100;
+  if (r < 3) {
+    s.co2 = random() % (DataDecode::MAX_CO2 + 1);
+    s.temp = DataDecode::MIN_TEMP
+             + random() % (DataDecode::MAX_TEMP - DataDecode::MIN_TEMP + 1);
+    s.rh = random() % (DataDecode::MAX_RH + 1);
+  } else if (r < 60) {
+    // constrain() evaluates its arguments more than once
+    int co2 = s.co2 + (int) (random() % 41) - 20;
+    int temp = s.temp + (int) (random() % 21) - 10;
+    int rh = s.rh + (int) (random() % 41) - 20;
+    s.co2 = constrain(co2, 0, (int) DataDecode::MAX_CO2);
+    s.temp = constrain(temp, (int) DataDecode::MIN_TEMP,
+                       (int) DataDecode::MAX_TEMP);
+    s.rh = constrain(rh, 0, (int) DataDecode::MAX_RH);
+  }
+  return s;
+}
+
+// ____________________________________________________________________________
+// add the bytes completed by the encoder to a file
+static void takeAll(Compressor& compressor, std::vector<uint8_t>& file) {
+  const uint8_t* data;
+  bool part;
+  while (uint16_t length = compressor.take(&data, &part)) {
+    file.insert(file.end(), data, data + length);
+  }
+}
+
+// ____________________________________________________________________________
+static bool same(const Sample& a, const DataDecode::Sample& b) {
+  return a.time == b.time && a.co2 == b.co2 && a.temp == b.temp
+         && a.rh == b.rh;
+}
+
+// ____________________________________________________________________________
+static std::vector<DataDecode::Sample> decode(
+    const std::vector<uint8_t>& file, DataDecode::Statistics* statistics) {
+  std::vector<DataDecode::Sample> samples;
+  *statistics = DataDecode::decode(file, [&samples](
+      const DataDecode::Sample& s) { samples.push_back(s); });
+  return samples;
+}
+
+// ____________________________________________________________________________
+// result of a check, prints the failure
+static bool expect(bool ok, const char* what, int trial) {
+  if (!ok) printf("FAILED in trial %d: %s\n", trial, what);
+  return ok;
+}
+
+// ____________________________________________________________________________
+// samples written by 1 to 3 starts of the encoder, each one ending after a
+// random sample with its block closed or without trailer. Without trailer
+// the last samples not filling a byte yet are lost, at most 2
+static bool roundTrip(std::mt19937& random, int trial, size_t* partial) {
+  std::vector<uint8_t> file;
+  std::vector<std::vector<Sample>> starts(1 + random() % 3);
+  std::vector<bool> closed;
+  Sample s = {1790000000, 800, 2150, 4000};
+  for (size_t start = 0; start < starts.size(); start++) {
+    Compressor compressor;
+    uint32_t count = 1 + random() % 3000;
+    for (uint32_t i = 0; i < count; i++) {
+      s = nextSample(random, s);
+      // a time of its own, so the first sample tells the starts apart
+      if (i == 0) s.time = 4000000000UL + start;
+      starts[start].push_back(s);
+      compressor.add(s);
+      takeAll(compressor, file);
+    }
+    closed.push_back(random() % 2);
+    if (closed.back()) compressor.close();
+    takeAll(compressor, file);
+  }
+
+  DataDecode::Statistics statistics;
+  std::vector<DataDecode::Sample> decoded = decode(file, &statistics);
+  bool ok = true;
+  size_t i = 0;
+  for (size_t start = 0; start < starts.size(); start++) {
+    size_t n = 0;
+    while (n < starts[start].size() && i < decoded.size()
+           && same(starts[start][n], decoded[i])) {
+      n++;
+      i++;
+    }
+    ok &= n == starts[start].size()
+          || (!closed[start] && starts[start].size() - n <= 2);
+  }
+  ok &= i == decoded.size();
+  *partial += statistics.partial;
+  return expect(ok, "samples decoded as written", trial)
+         && expect(!statistics.invalid && !statistics.skipped,
+                   "no invalid data", trial);
+}
+
+// ____________________________________________________________________________
+// file of older firmware: a block cut by a loss, the note, the rest of the
+// block and then further blocks. Gives the samples before the note
+static bool lossNote(std::mt19937& random, int trial) {
+  Written before, cut, after;
+  Sample s = {1790000000, 800, 2150, 4000};
+  Compressor compressor;
+  uint32_t count = 1 + random() % 1000;
+  for (uint32_t i = 0; i < count; i++) {
+    s = nextSample(random, s);
+    before.samples.push_back(s);
+    compressor.add(s);
+    takeAll(compressor, before.file);
+  }
+  compressor.close();
+  takeAll(compressor, before.file);
+
+  // the block cut: bytes up to the loss, then the ones after it
+  // few enough samples for the block not to run full
+  count = 2 + random() % 30;
+  uint32_t loss = 1 + random() % (count - 1);
+  std::vector<uint8_t> rest;
+  for (uint32_t i = 0; i < count; i++) {
+    s = nextSample(random, s);
+    cut.samples.push_back(s);
+    compressor.add(s);
+    takeAll(compressor, i < loss ? cut.file : rest);
+  }
+  compressor.close();
+  takeAll(compressor, rest);
+  for (uint32_t i = 0, n = 1 + random() % 1000; i < n; i++) {
+    s = nextSample(random, s);
+    after.samples.push_back(s);
+    compressor.add(s);
+    takeAll(compressor, after.file);
+  }
+  compressor.close();
+  takeAll(compressor, after.file);
+
+  std::vector<uint8_t> file = before.file;
+  file.insert(file.end(), cut.file.begin(), cut.file.end());
+  char note[32];
+  snprintf(note, sizeof(note), "# %u lines lost\n",
+           (unsigned) (random() % 500 + 1));
+  file.insert(file.end(), note, note + strlen(note));
+  size_t dropped = random() % (rest.size() + 1);
+  file.insert(file.end(), rest.begin() + dropped, rest.end());
+  file.insert(file.end(), after.file.begin(), after.file.end());
+
+  // all samples before, a part of those of the cut block, all after
+  DataDecode::Statistics statistics;
+  std::vector<DataDecode::Sample> decoded = decode(file, &statistics);
+  size_t n = decoded.size(), i = 0;
+  bool ok = n >= before.samples.size() + after.samples.size() + 1;
+  for (; ok && i < before.samples.size(); i++) {
+    ok = same(before.samples[i], decoded[i]);
+  }
+  size_t cutSamples = n - before.samples.size() - after.samples.size();
+  ok &= cutSamples <= loss;
+  for (size_t j = 0; ok && j < cutSamples; j++, i++) {
+    ok = same(cut.samples[j], decoded[i]);
+  }
+  for (size_t j = 0; ok && j < after.samples.size(); j++, i++) {
+    ok = same(after.samples[j], decoded[i]);
+  }
+  return expect(ok, "the samples of the file without the cut", trial)
+         && expect(statistics.invalid == 1, "one block ended at the note",
+                   trial);
+}
+
+// ____________________________________________________________________________
+// samples written like Monitor::appendBlocks() by a logger whose card is
+// out long enough that the ring buffer runs full
+static bool logger(void) {
+  HostSim::reset();
+  FakeCard card;
+  SDClass sd;
+  sd.insert(CARD_PIN, &card);
+  Logger logger(sd, CARD_PIN);
+  logger.begin();
+  Compressor compressor;
+  std::mt19937 random(5);
+  const char* binary = "DATA/2026/10/16.BIN";
+  const char* text = "DATA/2026/10/16.CSV";
+
+  // every 2 s a sample, the card is out from 1 h to 4 h
+  std::vector<Sample> samples;
+  Sample s = {1790000000, 800, 2150, 4000};
+  uint32_t lostData = 0, notes = 0;
+  uint32_t out = 1800, in = out + 5400;
+  for (uint32_t i = 0; i < in + 3600; i++) {
+    if (i == out) sd.insert(CARD_PIN, NULL);
+    if (i == in) sd.insert(CARD_PIN, &card);
+    s = nextSample(random, s);
+    s.time = samples.empty() ? s.time : samples.back().time + 2;
+    samples.push_back(s);
+    compressor.add(s);
+    const uint8_t* data;
+    bool part;
+    while (uint16_t length = compressor.take(&data, &part)) {
+      logger.append(binary, data, length, part);
+    }
+    if (logger.lostData() != lostData && logger.mounted()) {
+      lostData = logger.lostData();
+      logger.append(text, "# compressed data lost\n");
+      notes++;
+      compressor.close();
+      while (uint16_t length = compressor.take(&data, &part)) {
+        logger.append(binary, data, length, part);
+      }
+    }
+    logger.update();
+    delay(2000);
+  }
+  // the last page is written at the next start
+  Logger(sd, CARD_PIN).begin();
+
+  // each sample decoded is one written and in order
+  std::string content = card.text(binary);
+  std::vector<uint8_t> file(content.begin(), content.end());
+  DataDecode::Statistics statistics;
+  std::vector<DataDecode::Sample> decoded = decode(file, &statistics);
+  bool ok = true;
+  size_t next = 0;
+  for (const DataDecode::Sample& d : decoded) {
+    size_t i = (d.time - samples[0].time) / 2;
+    ok &= i < samples.size() && i >= next && same(samples[i], d);
+    next = i + 1;
+  }
+  bool noted = card.text(text).find("# compressed data lost") !=
+               std::string::npos;
+  printf("logger: %zu samples, %zu decoded, %u bytes lost, %zu blocks, "
+         "%zu partial, %zu skipped bytes\n", samples.size(), decoded.size(),
+         lostData, statistics.blocks, statistics.partial, statistics.skipped);
+  return expect(ok, "only samples written, in order", 0)
+         && expect(lostData && notes && noted, "the loss noted", 0)
+         && expect(!statistics.invalid && !statistics.skipped,
+                   "no invalid data in the file", 0)
+         && expect(decoded.size() >= samples.size() - lostData,
+                   "at most a sample lost per byte", 0);
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  int trials = argc > 1 ? atoi(argv[1]) : 400;
+  if (trials < 1) {
+    fprintf(stderr, "usage: %s [trials]\n", argv[0]);
+    return 2;
+  }
+  std::mt19937 random(4);
+  bool ok = true;
+  size_t partial = 0;
+  for (int trial = 0; ok && trial < trials; trial++) {
+    ok &= roundTrip(random, trial, &partial);
+  }
+  printf("round trip: %d trials, %zu blocks without trailer\n", trials,
+         partial);
+  for (int trial = 0; ok && trial < trials; trial++) {
+    ok &= lossNote(random, trial);
+  }
+  printf("loss note: %d trials\n", trials);
+  ok = ok && logger();
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
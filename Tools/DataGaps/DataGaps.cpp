@@ -0,0 +1,107 @@
+/******************************************************************************
+ * 
+ * Print the gaps in data files and their reconstructed timeline.
+ * 
+ * Host program reading data files in the given order, e.g. the days of a
+ * month, and printing the gaps found by DataGaps.h, which can also be
+ * included by ingestion programs. With -t the rows are printed instead,
+ * with the time reconstructed for rows written while the clock was not set.
+ * 
+ * Usage:
+ *  datagaps [-t] [-i interval] data.csv ...
+ *    -t  print the rows with reconstructed time instead of the gaps
+ *    -i  ms between two rows reported as gap, default 10000
+ * 
+ * Build from the repository root:
+ *  g++ -O2 -o datagaps Tools/DataGaps/DataGaps.cpp
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "DataGaps.h"
+
+// ____________________________________________________________________________
+// print a unix time like the data files, nothing for 0
+static void printTime(uint32_t unixTime) {
+  if (!unixTime) return;
+  time_t time = unixTime;
+  struct tm* t = gmtime(&time);
+  printf("%i/%02i/%02i %02i:%02i:%02i", t->tm_year + 1900, t->tm_mon + 1,
+         t->tm_mday, t->tm_hour, t->tm_min, t->tm_sec);
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  bool rows = false;
+  uint32_t interval = 10000;
+  int arg = 1;
+  for (; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (!strcmp(argv[arg], "-t")) {
+      rows = true;
+    } else if (!strcmp(argv[arg], "-i") && arg + 1 < argc) {
+      interval = atol(argv[++arg]);
+    } else {
+      break;
+    }
+  }
+  if (arg >= argc) {
+    fprintf(stderr, "usage: %s [-t] [-i interval] data.csv ...\n", argv[0]);
+    return 1;
+  }
+
+  size_t count = 0, boots = 0, gaps = 0;
+  uint32_t lastTime = 0;
+  DataGaps::Timeline timeline(interval, [&](const DataGaps::Row& row) {
+    if (rows) {
+      printTime(row.time);
+      printf("%s, %u, %u\n", row.values.c_str(), row.seq, row.uptime);
+    }
+    lastTime = row.time;
+    count++;
+  }, [&](const DataGaps::Gap& gap) {
+    gap.kind == DataGaps::GAP_BOOT ? boots++ : gaps++;
+    if (rows) return;
+    // the time of the row before the gap
+    printTime(lastTime);
+    switch (gap.kind) {
+      case DataGaps::GAP_ROWS:
+        printf(" seq %u: %u rows missing\n", gap.seq, gap.missing);
+        break;
+      case DataGaps::GAP_TIME:
+        printf(" seq %u: %.1f s without rows\n", gap.seq,
+               gap.missing / 1000.0);
+        break;
+      case DataGaps::GAP_BOOT:
+        printf(" seq %u: boot, reset cause 0x%02x %s\n", gap.seq, gap.cause,
+               gap.text.c_str());
+        break;
+      case DataGaps::GAP_UNMARKED:
+        printf(" seq %u: reset without boot record\n", gap.seq);
+        break;
+    }
+  });
+  if (rows) printf("dateTime, co2, temp, rh, people, seq, uptime\n");
+
+  char line[256];
+  for (; arg < argc; arg++) {
+    FILE* file = fopen(argv[arg], "r");
+    if (!file) {
+      fprintf(stderr, "cannot read %s\n", argv[arg]);
+      return 1;
+    }
+    while (fgets(line, sizeof(line), file)) timeline.line(line);
+    fclose(file);
+  }
+  timeline.finish();
+  fprintf(stderr, "%zu rows, %zu boots, %zu gaps\n", count, boots, gaps);
+  return 0;
+}
@@ -0,0 +1,244 @@
+/******************************************************************************
+ * 
+ * Reconstruct the timeline of data files and find gaps in it.
+ * 
+ * Header-only host library. Each data row of the firmware ends with its
+ * sequence number and the milliseconds since the start of the device
+ * (uptime), and each start writes a boot record with the reset cause, see
+ * Firmware/Sequence.h:
+ * 
+ *  2026/10/16 10:00:02, 812, 21.50, 40.20, , 1234, 56789
+ *  # Boot, seq 65536, uptime 1503, reset cause 0x20 watchdog
+ * 
+ * Lines are fed in the order of the files with Timeline::line(), each once,
+ * so the files are read in linear time. Rows without time (clock not set)
+ * get the time of the other rows of the same start, shifted by the
+ * difference of their uptime. Rows of a start are kept until one with a
+ * time is found or the start ends, rows of starts without any time keep
+ * time 0. Kept rows are assumed within 49 days of the row with time, the
+ * wrap of millis().
+ * 
+ * Gaps reported:
+ *  GAP_ROWS      sequence numbers missing within a start, e.g. lost data
+ *  GAP_TIME      more than maxInterval ms between two rows of a start
+ *  GAP_BOOT      a boot record, the rows before it end with the reset
+ *  GAP_UNMARKED  uptime or sequence number fell without boot record, e.g.
+ *                the record was lost or rows are out of order
+ * 
+ * Usage:
+ *  #include "DataGaps.h"
+ *  DataGaps::Timeline timeline(10000, onRow, onGap);
+ *  while (fgets(line, sizeof(line), file)) timeline.line(line);
+ *  timeline.finish();
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _DATA_GAPS__H_
+#define _DATA_GAPS__H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace DataGaps {
+
+/* A data row */
+struct Row {
+  uint32_t time;        ///< unix time, reconstructed if not in the file
+  bool measured;        ///< if the time was in the file
+  uint32_t seq;         ///< sequence number
+  uint32_t uptime;      ///< ms since the start of the device
+  std::string values;   ///< columns between time and sequence number
+};
+
+/* Kind of gap */
+enum Kind { GAP_ROWS, GAP_TIME, GAP_BOOT, GAP_UNMARKED };
+
+/* A gap between two rows */
+struct Gap {
+  Kind kind;            ///< kind of the gap
+  uint32_t seq;         ///< sequence number of the row after the gap
+  uint32_t missing;     ///< GAP_ROWS: rows missing, GAP_TIME: ms
+  unsigned cause;       ///< GAP_BOOT: reset cause register
+  std::string text;     ///< GAP_BOOT: name of the cause
+};
+
+// ____________________________________________________________________________
+// seconds since 1.1.1970 of the given date and time, as in DataIndex.h
+inline uint32_t unixTime(int year, int month, int day,
+                         int hour, int minute, int second) {
+  // days from civil date, year starting in March
+  year -= month <= 2;
+  int era = year / 400;
+  int yoe = year - era * 400;
+  int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  int32_t days = era * 146097 + doe - 719468;
+  return days * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+// ____________________________________________________________________________
+// split a data row "time, co2, temp, rh, people, seq, uptime", false for
+// other lines and rows of older firmware without sequence number
+inline bool parseRow(const char* line, Row* row) {
+  std::vector<std::string> fields(1);
+  for (const char* c = line; *c && *c != '\r' && *c != '\n'; c++) {
+    if (*c == ',') {
+      fields.push_back("");
+    } else {
+      fields.back() += *c;
+    }
+  }
+  if (fields.size() != 7 || line[0] == '#') return false;
+  unsigned long seq, uptime;
+  if (sscanf(fields[5].c_str(), "%lu", &seq) != 1
+      || sscanf(fields[6].c_str(), "%lu", &uptime) != 1) {
+    return false;
+  }
+  int year, month, day, hour, minute, second;
+  row->measured = sscanf(fields[0].c_str(), "%4d/%2d/%2d %2d:%2d:%2d",
+                         &year, &month, &day, &hour, &minute, &second) == 6;
+  row->time = row->measured
+              ? unixTime(year, month, day, hour, minute, second) : 0;
+  row->seq = seq;
+  row->uptime = uptime;
+  row->values.clear();
+  for (size_t i = 1; i < 5; i++) row->values += "," + fields[i];
+  return true;
+}
+
+// ____________________________________________________________________________
+// read a boot record, false for other lines
+inline bool parseBoot(const char* line, Gap* gap) {
+  unsigned long seq, uptime;
+  unsigned cause;
+  int length = 0;
+  if (sscanf(line, "# Boot, seq %lu, uptime %lu, reset cause 0x%x %n",
+             &seq, &uptime, &cause, &length) != 3) {
+    return false;
+  }
+  gap->kind = GAP_BOOT;
+  gap->seq = seq;
+  gap->missing = 0;
+  gap->cause = cause;
+  gap->text = line + length;
+  while (!gap->text.empty() && (gap->text.back() == '\n'
+                                || gap->text.back() == '\r')) {
+    gap->text.pop_back();
+  }
+  return true;
+}
+
+/* Streaming reconstruction of the timeline */
+class Timeline {
+ public:
+  typedef std::function<void(const Row&)> RowCallback;
+  typedef std::function<void(const Gap&)> GapCallback;
+
+  // rows more than maxInterval ms apart are a GAP_TIME
+  Timeline(uint32_t maxInterval, RowCallback onRow, GapCallback onGap)
+      : _maxInterval(maxInterval), _onRow(onRow), _onGap(onGap),
+        _started(false), _booted(false), _known(false), _offset(0),
+        _wraps(0), _expected(0), _lastUptime(0) {}
+
+  // feed the next line of the data files
+  void line(const char* text) {
+    Gap gap;
+    Row row;
+    if (parseBoot(text, &gap)) {
+      finish();
+      _onGap(gap);
+      _expected = gap.seq;
+      _started = true;
+      _booted = true;
+    } else if (parseRow(text, &row)) {
+      add(row);
+    }
+  }
+
+  // end the current start, call after the last line
+  void finish(void) {
+    // rows of a start without any time keep time 0
+    for (const Row& row : _pending) _onRow(row);
+    _pending.clear();
+    _started = false;
+    _booted = false;
+    _known = false;
+    _wraps = 0;
+  }
+
+ private:
+  // add a row of the data files
+  void add(Row& row) {
+    if (_started && !_booted
+        && (row.seq < _expected
+            || (row.uptime < _lastUptime
+                && _lastUptime - row.uptime < 0x80000000UL))) {
+      // numbers or uptime went back without boot record, millis() wraps
+      // only after 49 days, which lets the uptime fall by almost 2^32
+      finish();
+      _onGap(Gap{GAP_UNMARKED, row.seq, 0, 0, ""});
+    }
+    if (_started) {
+      if (row.seq > _expected) {
+        _onGap(Gap{GAP_ROWS, row.seq, row.seq - _expected, 0, ""});
+      }
+      if (!_booted) {
+        if (row.uptime < _lastUptime) _wraps++;
+        uint32_t interval = row.uptime - _lastUptime;
+        if (interval > _maxInterval) {
+          _onGap(Gap{GAP_TIME, row.seq, interval, 0, ""});
+        }
+      }
+    }
+    _started = true;
+    _booted = false;
+    _expected = row.seq + 1;
+    _lastUptime = row.uptime;
+
+    // ms of the start of the device since 1.1.1970, from the rows with time
+    uint64_t uptime = ((uint64_t) _wraps << 32) + row.uptime;
+    if (!_known) {
+      if (!row.measured) {
+        _pending.push_back(row);
+        return;
+      }
+      _offset = (uint64_t) row.time * 1000 - uptime;
+      _known = true;
+      // the rows kept get their time from this one
+      for (Row& kept : _pending) {
+        kept.time = (_offset + kept.uptime) / 1000;
+        _onRow(kept);
+      }
+      _pending.clear();
+    } else if (!row.measured) {
+      row.time = (_offset + uptime) / 1000;
+    }
+    _onRow(row);
+  }
+
+  uint32_t _maxInterval;        ///< longest interval without GAP_TIME
+  RowCallback _onRow;           ///< called for each row in order
+  GapCallback _onGap;           ///< called for each gap
+  bool _started;                ///< if there was a row or boot record
+  bool _booted;                 ///< if the last line was a boot record
+  bool _known;                  ///< if the time of the start is known
+  uint64_t _offset;             ///< unix time in ms at uptime 0
+  uint32_t _wraps;              ///< wraps of the uptime since the start
+  uint32_t _expected;           ///< sequence number of the next row
+  uint32_t _lastUptime;         ///< uptime of the last row
+  std::vector<Row> _pending;    ///< rows waiting for the time of the start
+};
+
+}  // namespace DataGaps
+
+#endif  // _DATA_GAPS__H_
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * 
+ * Gaps and times found by DataGaps.h in a hand-written data file.
+ * 
+ * The file below has a boot record, rows missing, a time without rows, a
+ * second boot with rows written before the clock was set and a reset
+ * without boot record. Each gap must be reported once, in order, and the
+ * rows must get the time of the other rows of their start.
+ * It ends with exit code 1 if a result differs.
+ * 
+ * Build and run from the repository root:
+ *  g++ -std=gnu++11 -O2 -o datagapstest Tools/DataGaps/DataGapsTest.cpp
+ *  ./datagapstest
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include "DataGaps.h"
+
+// a day of a device, as written by the firmware
+const char* FILE_LINES[] = {
+  "dateTime, co2, temp, rh, people, seq, uptime\n",
+  "# Boot, seq 0, uptime 1503, reset cause 0x01 power on\n",
+  "2026/10/16 10:00:00.120, 812, 21.50, 40.20, , 0, 2000\n",
+  "2026/10/16 10:00:02.120, 815, 21.50, 40.20, , 1, 4000\n",
+  "2026/10/16 10:00:04.120, 813, 21.51, 40.10, , 2, 6000\n",
+  // rows 3 and 4 lost
+  "2026/10/16 10:00:10.120, 820, 21.51, 40.10, , 5, 12000\n",
+  // the sensor did not answer for a minute
+  "2026/10/16 10:01:10.120, 841, 21.52, 40.00, , 6, 72000\n",
+  "2026/10/16 10:01:12.120, 843, 21.52, 40.00, , 7, 74000\n",
+  "# Boot, seq 65536, uptime 1400, reset cause 0x20 watchdog\n",
+  // the clock is set with the third row
+  ", 850, 21.60, 39.90, , 65536, 2000\n",
+  ", 852, 21.60, 39.90, , 65537, 4000\n",
+  "2026/10/16 10:05:00.000, 851, 21.60, 39.90, , 65538, 6000\n",
+  "# Prediction: 1000 ppm in ~25 min\n",
+  "2026/10/16 10:05:02.000, 853, 21.60, 39.90, , 65539, 8000\n",
+  // a reset whose boot record got lost, the clock is not set any more
+  ", 860, 21.70, 39.80, , 131072, 2500\n",
+  ", 861, 21.70, 39.80, , 131073, 4500\n",
+};
+
+/* A gap as expected */
+struct Expected {
+  DataGaps::Kind kind;
+  uint32_t seq, missing;
+};
+
+const Expected GAPS[] = {
+  {DataGaps::GAP_BOOT, 0, 0},
+  {DataGaps::GAP_ROWS, 5, 2},
+  {DataGaps::GAP_TIME, 6, 60000},
+  {DataGaps::GAP_BOOT, 65536, 0},
+  {DataGaps::GAP_UNMARKED, 131072, 0},
+};
+
+// ____________________________________________________________________________
+// result of a check, prints the failure
+static bool expect(bool ok, const char* what) {
+  if (!ok) printf("FAILED: %s\n", what);
+  return ok;
+}
+
+// ____________________________________________________________________________
+int main(void) {
+  std::vector<DataGaps::Row> rows;
+  std::vector<DataGaps::Gap> gaps;
+  DataGaps::Timeline timeline(10000, [&rows](const DataGaps::Row& row) {
+    rows.push_back(row);
+  }, [&gaps](const DataGaps::Gap& gap) {
+    gaps.push_back(gap);
+  });
+  for (const char* line : FILE_LINES) timeline.line(line);
+  timeline.finish();
+
+  bool ok = expect(gaps.size() == sizeof(GAPS) / sizeof(GAPS[0]),
+                   "every gap reported once");
+  for (size_t i = 0; ok && i < gaps.size(); i++) {
+    ok &= expect(gaps[i].kind == GAPS[i].kind && gaps[i].seq == GAPS[i].seq
+                 && gaps[i].missing == GAPS[i].missing,
+                 "gaps of the kind, row and size written");
+  }
+  ok &= expect(gaps.size() > 3 && gaps[0].cause == 0x01
+               && gaps[0].text == "power on" && gaps[3].cause == 0x20
+               && gaps[3].text == "watchdog", "reset causes of the boots");
+
+  // rows in order with their time, reconstructed ones to the second
+  uint32_t ten = DataGaps::unixTime(2026, 10, 16, 10, 0, 0);
+  const uint32_t seqs[] = {0, 1, 2, 5, 6, 7, 65536, 65537, 65538, 65539,
+                           131072, 131073};
+  const uint32_t times[] = {ten, ten + 2, ten + 4, ten + 10, ten + 70,
+                            ten + 72, ten + 296, ten + 298, ten + 300,
+                            ten + 302, 0, 0};
+  ok &= expect(rows.size() == sizeof(seqs) / sizeof(seqs[0]),
+               "every row once");
+  for (size_t i = 0; ok && i < rows.size(); i++) {
+    ok &= expect(rows[i].seq == seqs[i], "rows in the order written");
+    ok &= expect(rows[i].time == times[i], "time of each row");
+    ok &= expect(rows[i].measured == (i != 6 && i != 7 && i < 10),
+                 "rows with time in the file marked as measured");
+  }
+  ok &= expect(rows.size() > 6 && rows[6].values == ", 850, 21.60, 39.90, ",
+               "values of a row");
+  printf("%zu rows, %zu gaps\n", rows.size(), gaps.size());
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * 
+ * Print the lines of a data file within a time range.
+ * 
+ * Host program using the index file next to the data file to read only the
+ * lines needed, see DataIndex.h, which can also be included by other
+ * analysis programs.
+ * 
+ * Usage:
+ *  dataindex data.csv from to
+ *    from, to    "YYYY/MM/DD hh:mm[:ss]" or "hh:mm[:ss]" on the day of the
+ *                first line of the file
+ * 
+ * Build from the repository root:
+ *  g++ -O2 -o dataindex Tools/DataIndex/DataIndex.cpp
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "DataIndex.h"
+
+// ____________________________________________________________________________
+// date of the first data line of a file
+static bool firstDate(const char* filename, int* year, int* month, int* day) {
+  FILE* f = fopen(filename, "rb");
+  if (!f) return false;
+  char line[256];
+  bool found = false;
+  while (!found && fgets(line, sizeof(line), f)) {
+    found = sscanf(line, "%4d/%2d/%2d", year, month, day) == 3;
+  }
+  fclose(f);
+  return found;
+}
+
+// ____________________________________________________________________________
+// parse a time argument, see usage
+static bool parseArgument(const char* arg, const char* filename,
+                          uint32_t* time) {
+  int year, month, day, hour, minute, second = 0;
+  if (strchr(arg, '/')) {
+    if (sscanf(arg, "%d/%d/%d %d:%d:%d", &year, &month, &day,
+               &hour, &minute, &second) < 5) {
+      return false;
+    }
+  } else if (sscanf(arg, "%d:%d:%d", &hour, &minute, &second) < 2
+             || !firstDate(filename, &year, &month, &day)) {
+    return false;
+  }
+  *time = DataIndex::unixTime(year, month, day, hour, minute, second);
+  return true;
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  uint32_t from, to;
+  if (argc != 4 || !parseArgument(argv[2], argv[1], &from)
+      || !parseArgument(argv[3], argv[1], &to)) {
+    fprintf(stderr, "usage: %s data.csv from to\n"
+                    "  from, to: \"YYYY/MM/DD hh:mm[:ss]\" or "
+                    "\"hh:mm[:ss]\"\n", argv[0]);
+    return 1;
+  }
+
+  long bytes = 0;
+  long lines = DataIndex::readRange(
+    argv[1], from, to, [](const char* line) { fputs(line, stdout); }, &bytes);
+  if (lines < 0) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "%ld lines, %ld bytes read\n", lines, bytes);
+  return 0;
+}
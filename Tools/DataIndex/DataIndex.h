@@ -0,0 +1,173 @@
+/******************************************************************************
+ * 
+ * Read time ranges of data files using their index files.
+ * 
+ * Header-only host library. The firmware writes an index file next to each
+ * data file (same name, extension .idx) with an entry every INDEX_INTERVAL:
+ * two little endian uint32_t, the unix time of a line and its byte offset
+ * in the data file, see Firmware/Logger.h. readRange() binary searches the
+ * index for the last entry not after the start of the range, seeks there in
+ * the data file and reads lines only until the end of the range. So the
+ * bytes read are proportional to the result, not to the file.
+ * 
+ * Without index file, or if the entry found does not point to a line of
+ * its time (e.g. after data was lost on the card), the data file is read
+ * from its start. Times in the index must be increasing, which does not
+ * hold if the clock was set back during the day.
+ * 
+ * Usage:
+ *  #include "DataIndex.h"
+ *  uint32_t from = DataIndex::unixTime(2026, 10, 16, 10, 0, 0);
+ *  uint32_t to   = DataIndex::unixTime(2026, 10, 16, 11, 30, 0);
+ *  DataIndex::readRange("Data/2026/10/16.csv", from, to,
+ *                       [](const char* line) { fputs(line, stdout); });
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _DATA_INDEX__H_
+#define _DATA_INDEX__H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+namespace DataIndex {
+
+/* Entry of an index file */
+struct Entry {
+  uint32_t time;      ///< unix time of the line
+  uint32_t offset;    ///< byte offset of the line in the data file
+};
+
+// ____________________________________________________________________________
+// seconds since 1.1.1970 of the given date and time. Like DateTime::unixtime()
+// of RTClib the time of the clock is taken as UTC
+inline uint32_t unixTime(int year, int month, int day,
+                         int hour, int minute, int second) {
+  // days from civil date, year starting in March
+  year -= month <= 2;
+  int era = year / 400;
+  int yoe = year - era * 400;
+  int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  int32_t days = era * 146097 + doe - 719468;
+  return days * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+// ____________________________________________________________________________
+// time of a data line "YYYY/MM/DD hh:mm:ss, ...", false for other lines
+inline bool parseTime(const char* line, uint32_t* time) {
+  int year, month, day, hour, minute, second;
+  if (sscanf(line, "%4d/%2d/%2d %2d:%2d:%2d", &year, &month, &day,
+             &hour, &minute, &second) != 6) {
+    return false;
+  }
+  *time = unixTime(year, month, day, hour, minute, second);
+  return true;
+}
+
+// ____________________________________________________________________________
+// name of the index file of a data file
+inline std::string indexName(const std::string& dataFile) {
+  size_t dot = dataFile.rfind('.');
+  size_t slash = dataFile.find_last_of("/\\");
+  if (dot == std::string::npos
+      || (slash != std::string::npos && dot < slash)) {
+    return dataFile + ".idx";
+  }
+  return dataFile.substr(0, dot) + ".idx";
+}
+
+// ____________________________________________________________________________
+// read entry i of an index file
+inline bool readEntry(FILE* index, long i, Entry* entry) {
+  uint8_t b[8];
+  if (fseek(index, i * 8, SEEK_SET) != 0 || fread(b, 1, 8, index) != 8) {
+    return false;
+  }
+  entry->time   = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t) b[3] << 24);
+  entry->offset = b[4] | (b[5] << 8) | (b[6] << 16) | ((uint32_t) b[7] << 24);
+  return true;
+}
+
+// ____________________________________________________________________________
+// last entry of the index file not after the given time, binary search
+// reading O(log n) entries. False if there is none
+inline bool findEntry(FILE* index, uint32_t time, Entry* found) {
+  if (fseek(index, 0, SEEK_END) != 0) return false;
+  long lo = 0, hi = ftell(index) / 8;   // search in [lo, hi)
+  bool result = false;
+  while (lo < hi) {
+    long mid = lo + (hi - lo) / 2;
+    Entry entry;
+    if (!readEntry(index, mid, &entry)) return false;
+    if (entry.time <= time) {
+      *found = entry;
+      result = true;
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+// offset in the data file to start reading lines from the given time on,
+// 0 if there is no usable index entry
+inline uint32_t startOffset(const std::string& dataFile, FILE* data,
+                            uint32_t from) {
+  FILE* index = fopen(indexName(dataFile).c_str(), "rb");
+  if (!index) return 0;
+  Entry entry;
+  bool found = findEntry(index, from, &entry);
+  fclose(index);
+  if (!found) return 0;
+
+  // check the entry points to the line it was written for
+  char line[256];
+  uint32_t time;
+  if (fseek(data, entry.offset, SEEK_SET) != 0
+      || !fgets(line, sizeof(line), data)
+      || !parseTime(line, &time) || time != entry.time) {
+    return 0;
+  }
+  return entry.offset;
+}
+
+// ____________________________________________________________________________
+// call callback(const char* line) for every data line of the file with a
+// time in [from, to], return the number of lines or -1 if the file can not
+// be read. The number of bytes read is stored in bytesRead if given
+template <class Callback>
+long readRange(const std::string& dataFile, uint32_t from, uint32_t to,
+               Callback callback, long* bytesRead = NULL) {
+  FILE* data = fopen(dataFile.c_str(), "rb");
+  if (!data) return -1;
+  uint32_t offset = startOffset(dataFile, data, from);
+  fseek(data, offset, SEEK_SET);
+
+  long count = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), data)) {
+    uint32_t time;
+    if (!parseTime(line, &time)) continue;   // header, comments
+    if (time < from) continue;
+    if (time > to) break;
+    callback(line);
+    count++;
+  }
+  if (bytesRead) *bytesRead = ftell(data) - offset;
+  fclose(data);
+  return count;
+}
+
+}  // namespace DataIndex
+
+#endif  // _DATA_INDEX__H_
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * 
+ * Generate the pre-rasterized fonts used by the firmware.
+ * 
+ * Host program that rasterizes the digits and unit characters of the
+ * classic 5x7 font of "Adafruit_GFX" at the textsizes used by ValueBar and
+ * HeaderBar. Instead of plain pixel doubling, diagonal steps of the source
+ * glyphs are smoothed by filling the corner between two set neighbors with
+ * a triangle, so the glyphs look less blocky than the scaled built-in font.
+ * 
+ * The glyphs are run length encoded (see Font.h) and written to BigFont.h
+ * and BigFont.cpp, which are then drawn with one address window per glyph.
+ * 
+ * Build and run from the repository root:
+ *  g++ -O2 -o fontgen Tools/FontGen/FontGen.cpp
+ *  ./fontgen Firmware
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// dimensions of a glyph of the source font and its cell including spacing
+#define SRC_W   5
+#define SRC_H   7
+#define CELL_W  6
+#define CELL_H  8
+
+/* Source glyph in the format of glcdfont.c: 5 columns, LSB is top row */
+struct SourceGlyph {
+  uint8_t code;
+  uint8_t columns[SRC_W];
+};
+
+// characters needed for values, time, date and units
+// 248 is the degree sign in code page 437
+static const SourceGlyph SOURCE[] = {
+  {' ', {0x00, 0x00, 0x00, 0x00, 0x00}},
+  {'%', {0x23, 0x13, 0x08, 0x64, 0x62}},
+  {'-', {0x08, 0x08, 0x08, 0x08, 0x08}},
+  {'.', {0x00, 0x60, 0x60, 0x00, 0x00}},
+  {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}},
+  {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+  {'2', {0x72, 0x49, 0x49, 0x49, 0x46}},
+  {'3', {0x21, 0x41, 0x49, 0x4D, 0x33}},
+  {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}},
+  {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+  {'6', {0x3C, 0x4A, 0x49, 0x49, 0x31}},
+  {'7', {0x41, 0x21, 0x11, 0x09, 0x07}},
+  {'8', {0x36, 0x49, 0x49, 0x49, 0x36}},
+  {'9', {0x46, 0x49, 0x49, 0x29, 0x1E}},
+  {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+  {'C', {0x3E, 0x41, 0x41, 0x41, 0x22}},
+  {'m', {0x7C, 0x04, 0x18, 0x04, 0x78}},
+  {'p', {0x7C, 0x14, 0x14, 0x14, 0x08}},
+  {248, {0x00, 0x06, 0x09, 0x09, 0x06}},
+};
+static const int SOURCE_COUNT = sizeof(SOURCE) / sizeof(SOURCE[0]);
+
+// textsizes to generate, as used by ValueBar (3, 4) and HeaderBar (2, 3)
+static const int SIZES[] = {2, 3, 4};
+
+/******************************************************************************
+    Rasterization
+******************************************************************************/
+
+// ____________________________________________________________________________
+// pixel of the source glyph, everything outside the 5x7 glyph is unset
+static bool sourcePixel(const SourceGlyph& g, int x, int y) {
+  if (x < 0 || x >= SRC_W || y < 0 || y >= SRC_H) return false;
+  return (g.columns[x] >> y) & 1;
+}
+
+// ____________________________________________________________________________
+// rasterize glyph at given size into a cell of (CELL_W x CELL_H) * size
+static std::vector<bool> rasterize(const SourceGlyph& g, int size) {
+  int w = CELL_W * size, h = CELL_H * size;
+  std::vector<bool> pixels(w * h, false);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int sx = x / size, sy = y / size;
+      bool on = sourcePixel(g, sx, sy);
+      if (!on && sx < SRC_W && sy < SRC_H) {
+        // position of pixel center inside the source pixel in [0, 1)
+        float u = (x % size + 0.5f) / size;
+        float v = (y % size + 0.5f) / size;
+        bool left   = sourcePixel(g, sx-1, sy);
+        bool right  = sourcePixel(g, sx+1, sy);
+        bool top    = sourcePixel(g, sx, sy-1);
+        bool bottom = sourcePixel(g, sx, sy+1);
+        // fill the triangle in each corner enclosed by two set neighbors
+        on = (left && top && u + v < 1.0f)
+          || (right && top && (1-u) + v < 1.0f)
+          || (left && bottom && u + (1-v) < 1.0f)
+          || (right && bottom && (1-u) + (1-v) < 1.0f);
+      }
+      pixels[y*w + x] = on;
+    }
+  }
+  return pixels;
+}
+
+// ____________________________________________________________________________
+// encode pixels as alternating runs of background and foreground
+static std::vector<uint8_t> encode(const std::vector<bool>& pixels) {
+  std::vector<uint8_t> runs;
+  bool color = false;   // runs start with background
+  size_t i = 0;
+  while (i < pixels.size()) {
+    size_t n = 0;
+    while (i < pixels.size() && pixels[i] == color) { n++; i++; }
+    // split runs longer than one byte by empty runs of the other color
+    while (n > 255) {
+      runs.push_back(255);
+      runs.push_back(0);
+      n -= 255;
+    }
+    runs.push_back(n);
+    color = !color;
+  }
+  return runs;
+}
+
+/******************************************************************************
+    Output
+******************************************************************************/
+
+static const char* BANNER =
+  "/******************************************************************************\n"
+  " * \n"
+  " * Pre-rasterized fonts for values, time and units.\n"
+  " * \n"
+  " * Generated by Tools/FontGen, do not edit. See Font.h for the format.\n"
+  " * \n"
+  "******************************************************************************/\n\n";
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <firmware directory>\n", argv[0]);
+    return 1;
+  }
+  std::string dir = argv[1];
+  FILE* h = fopen((dir + "/BigFont.h").c_str(), "w");
+  FILE* c = fopen((dir + "/BigFont.cpp").c_str(), "w");
+  if (!h || !c) {
+    fprintf(stderr, "cannot write to %s\n", dir.c_str());
+    return 1;
+  }
+
+  fputs(BANNER, h);
+  fputs("#ifndef _BIG_FONT__H_\n#define _BIG_FONT__H_\n\n", h);
+  fputs("#include \"Font.h\"\n\n", h);
+  fputs(BANNER, c);
+  fputs("#include \"BigFont.h\"\n", c);
+
+  size_t total = 0;
+  for (int size : SIZES) {
+    std::vector<uint8_t> runs;
+    std::string glyphs;
+    for (int i = 0; i < SOURCE_COUNT; i++) {
+      std::vector<uint8_t> r = encode(rasterize(SOURCE[i], size));
+      char line[64];
+      snprintf(line, sizeof(line), "  {%3d, %5zu, %4zu},\n",
+               SOURCE[i].code, runs.size(), r.size());
+      glyphs += line;
+      runs.insert(runs.end(), r.begin(), r.end());
+    }
+    total += runs.size();
+
+    fprintf(h, "// font replacing textsize %d, %zu bytes of runs\n", size,
+            runs.size());
+    fprintf(h, "extern const Font BIG_FONT_%d;\n", size);
+
+    fprintf(c, "\n/* textsize %d */\n", size);
+    fprintf(c, "static const uint8_t RUNS_%d[] = {", size);
+    for (size_t i = 0; i < runs.size(); i++) {
+      fprintf(c, "%s%3d,", (i % 16) ? " " : "\n  ", runs[i]);
+    }
+    fprintf(c, "\n};\n\n");
+    fprintf(c, "static const Glyph GLYPHS_%d[] = {\n%s};\n\n", size,
+            glyphs.c_str());
+    fprintf(c, "const Font BIG_FONT_%d = {\n  %d, %d, %d, %d, GLYPHS_%d, RUNS_%d\n};\n",
+            size, size, CELL_W*size, CELL_H*size, SOURCE_COUNT, size, size);
+  }
+
+  fputs("\n#endif  // _BIG_FONT__H_\n", h);
+  fclose(h);
+  fclose(c);
+  printf("%d glyphs in %zu sizes, %zu bytes of runs\n", SOURCE_COUNT,
+         sizeof(SIZES) / sizeof(SIZES[0]), total);
+  return 0;
+}
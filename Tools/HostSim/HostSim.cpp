@@ -0,0 +1,2414 @@
+/******************************************************************************
+ * 
+ * Checks of the firmware run in the host simulation.
+ * 
+ * Host program compiling the firmware against the fakes of HostSim.h. Each
+ * check sets up monitors or parts of the firmware with fake peripherals,
+ * runs them on the virtual time and prints what it measured. It ends with
+ * exit code 1 if a result is not what the firmware promises.
+ * 
+ * Usage:
+ *  hostsim <check> [arguments]
+ *    stress [monitors] [days] [workers]
+ *                                monitors with their own peripherals, cards
+ *                                taken out, button presses and day changes.
+ *                                Up to BUTTON_MAX of them share a program,
+ *                                as they share the interrupt tables of
+ *                                Button and Clock like on the MCU, the
+ *                                programs run in a pool of worker processes
+ *                                instead of threads. Each program has its
+ *                                own virtual time, the files of past days
+ *                                are checked and removed from the cards, so
+ *                                runs of hundreds of monitors over months
+ *                                take CPU time but little memory
+ *    glyphs [updates]            bytes sent for values, time and date with
+ *                                the built-in and the pre-rasterized fonts
+ *    start                       time from power on to the first sample,
+ *                                with and without card
+ *    journal [trials]            power cuts while data is logged and while
+ *                                the file is repaired at the next start
+ *    index [ranges]              time ranges of a day read with the index
+ *                                files, compared to a full scan
+ *    trend [rooms] [files]       predictions of the time until 1000 ppm in
+ *                                simulated rooms and recorded data files
+ *    ventilation [days] [files]  ventilations detected in simulated school
+ *                                days and recorded data files
+ *    filter [values]             spikes and a step of the CO2 through the
+ *                                filter in each mode
+ *    occupancy                   people estimated in a simulated room and
+ *                                its air change rate fitted by AirChange
+ *    clock [hours]               drift of millis() against the RTC found by
+ *                                the clock and its error
+ *    gestures                    presses of two buttons with bouncing
+ *                                contacts decoded into gestures
+ *    pages [rounds]              page switches drawing what differs,
+ *                                compared to clearing the area first
+ *    schedule                    schedules read from settings files, and
+ *                                the display of a monitor asleep outside
+ *                                them and woken by a press
+ *    images                      test images in each format drawn by
+ *                                bmpReader, compared pixel by pixel
+ *    crops                       parts of images drawn, also beyond the
+ *                                image and the screen, compared with the
+ *                                whole image, and the sectors read
+ *    remount [minutes]           attempts to mount missing cards, right
+ *                                after samples and ever less often, and a
+ *                                card inserted later
+ *    mirror [minutes]            two cards written by LOG_MIRROR, one
+ *                                taken out for some minutes, must end
+ *                                with the same files
+ *    migration [days]            files of the old flat layout moved while
+ *                                power is cut at random times
+ *    statistics [minutes]        a scripted CO2 trace in the statistics of
+ *                                the day and the ventilation detector,
+ *                                compared to results worked out by hand,
+ *                                and the bytes drawn into the exposure bar
+ * 
+ * Build from the repository root with the .cpp files of Firmware, see
+ * Tools/README.md for the command, and run e.g.
+ *  ./hostsim stress 256 30
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include "HostSim.h"
+#include "Monitor.h"
+#include "../AirChange/AirChange.h"
+#include "../DataIndex/DataIndex.h"
+
+#define US_PER_MIN 60000000ULL
+
+/* Row of a CSV data file */
+struct Row {
+  uint32_t seq;
+  int co2;
+  double temp, rh;
+  double people;      ///< -1 if not estimated
+  std::string line;
+};
+
+/* Monitor with its own set of fake peripherals */
+struct Device {
+  FakeDisplay tft;
+  SCD30 scd30;
+  RTC_DS3231 rtc;
+  SDClass sd;
+  TwoWire wire;
+  WatchdogType watchdog;
+  FakeCard cards[2];
+  Monitor<FakeDisplay> monitor;
+  uint64_t longestLoop;     ///< µs of the longest update()
+  uint64_t lastRun;         ///< µs begin() or update() returned, 0 before
+
+  Device()
+      : monitor(tft, scd30, rtc, sd, wire, watchdog), longestLoop(0),
+        lastRun(0) {}
+  void begin(void) {
+    monitor.begin();
+    lastRun = HostSim::now();
+  }
+  // the time other monitors of the program ran since the last call is
+  // not the monitor's own, its watchdog does not count it
+  void update(void) {
+    uint64_t start = HostSim::now();
+    if (lastRun) watchdog.state().last += start - lastRun;
+    monitor.update();
+    lastRun = HostSim::now();
+    longestLoop = max(longestLoop, lastRun - start);
+  }
+};
+
+/*****************************************************************************
+    Helpers
+*****************************************************************************/
+
+// ____________________________________________________________________________
+// rows of a data file on a card, comments and the header are left out
+static std::vector<Row> readRows(const FakeCard& card, const char* path) {
+  std::vector<Row> rows;
+  std::string text = card.text(path);
+  size_t begin = 0, end;
+  for (; (end = text.find('\n', begin)) != std::string::npos;
+       begin = end + 1) {
+    std::string line = text.substr(begin, end - begin);
+    Row row;
+    row.line = line;
+    row.people = -1;
+    char people[16];
+    if (sscanf(line.c_str(), "%*d/%*d/%*d %*d:%*d:%*f, %d, %lf, %lf, %15[^,], "
+               "%u", &row.co2, &row.temp, &row.rh, people, &row.seq) == 5) {
+      row.people = atof(people);
+      rows.push_back(row);
+    } else if (sscanf(line.c_str(), "%*d/%*d/%*d %*d:%*d:%*f, %d, %lf, %lf, "
+                      ", %u", &row.co2, &row.temp, &row.rh, &row.seq) == 4) {
+      rows.push_back(row);
+    }
+  }
+  return rows;
+}
+
+// ____________________________________________________________________________
+// press the button on pin at µs of the simulation for given ms, the
+// contacts bounce a few times at the press and at the release
+static void press(uint8_t pin, uint64_t at, uint32_t ms) {
+  for (uint8_t i = 0; i < 5; i++) {
+    HostSim::at(at + i * 700, [pin, i]() { HostSim::setPin(pin, i % 2); });
+  }
+  uint64_t release = at + ms * 1000ULL;
+  for (uint8_t i = 0; i < 5; i++) {
+    HostSim::at(release + i * 900,
+                [pin, i]() { HostSim::setPin(pin, !(i % 2)); });
+  }
+}
+
+// ____________________________________________________________________________
+// copy a file of a card to the host, for the tools reading files
+static bool copyOut(const FakeCard& card, const char* path,
+                    const std::string& hostPath) {
+  FILE* file = fopen(hostPath.c_str(), "wb");
+  if (!file) return false;
+  std::string text = card.text(path);
+  bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+  return !fclose(file) && ok;
+}
+
+// ____________________________________________________________________________
+// result of a check, prints the failure
+static bool expect(bool ok, const char* what) {
+  if (!ok) printf("FAILED: %s\n", what);
+  return ok;
+}
+
+/*****************************************************************************
+    Checks
+*****************************************************************************/
+
+/* Rows of a monitor found on its cards so far */
+struct Tally {
+  std::vector<size_t> lines;  ///< hash of the row of each seq, 0 if none
+  uint32_t rows;              ///< sequence numbers found
+  uint32_t differing;         ///< rows of the same seq with other text
+  uint32_t foreign;           ///< rows of another monitor
+  uint32_t aborted;           ///< calibrations aborted
+};
+
+// ____________________________________________________________________________
+// add the rows of a data file of monitor i of count to its tally
+static void tally(const FakeCard& card, const std::string& path, int i,
+                  int count, Tally& t) {
+  for (const Row& row : readRows(card, path.c_str())) {
+    if (row.seq >= t.lines.size()) t.lines.resize(row.seq + 1, 0);
+    size_t line = std::hash<std::string>()(row.line) | 1;
+    if (!t.lines[row.seq]) {
+      t.lines[row.seq] = line;
+      t.rows++;
+    } else if (t.lines[row.seq] != line) {
+      t.differing++;
+    }
+    if (row.co2 % count != i || row.temp != 20 + i % 50 + 0.25) t.foreign++;
+  }
+  std::string text = card.text(path.c_str());
+  for (size_t p = 0; (p = text.find("# Calibration aborted", p))
+                     != std::string::npos; p++) {
+    t.aborted++;
+  }
+}
+
+// ____________________________________________________________________________
+// tally the data files on the cards of monitor i of count and remove them,
+// those of days ended before a given unix time only
+static void collect(Device& d, int i, int count, Tally& t,
+                    uint32_t before = UINT32_MAX) {
+  for (FakeCard& card : d.cards) {
+    std::vector<std::string> paths;
+    for (const auto& file : card.files) {
+      unsigned year, month, day;
+      char extension[4];
+      if (sscanf(file.first.c_str(), "DATA/%4u/%2u/%2u.%3s", &year, &month,
+                 &day, extension) != 4
+          || DateTime(year, month, day).unixtime() + 86400 > before) {
+        continue;
+      }
+      if (!strcmp(extension, "CSV")) tally(card, file.first, i, count, t);
+      paths.push_back(file.first);
+    }
+    for (const std::string& path : paths) card.files.erase(path);
+  }
+}
+
+// ____________________________________________________________________________
+// monitors first to first + group - 1 of count in one program, as Monitor
+// keeps all state in its members they must not see each other's data,
+// cards or button presses. Prints to out, false if a check failed
+static bool stressGroup(int first, int group, int count, double days,
+                        FILE* out) {
+  HostSim::reset();
+  std::vector<std::unique_ptr<Device>> devices;
+  for (int j = 0; j < group; j++) {
+    int i = first + j;
+    devices.emplace_back(new Device());
+    Device& d = *devices.back();
+    // each one with clock, crystal, room and cards of its own. The CO2 of
+    // a room is i modulo the number of rooms, so data written to the
+    // wrong file would be found
+    d.rtc.adjust(DateTime(2026, 10, 16, 23, 0, j));
+    d.rtc.ppm = 20 * j - 20;
+    d.scd30.measure = [i, count](SCD30& s) {
+      double minutes = HostSim::now() / 60e6;
+      int co2 = 800 + 350 * sin(minutes / (6 + i % 50));
+      s.co2 = co2 - co2 % count + i;
+      s.temperature = 20 + i % 50 + 0.25;
+      s.humidity = 40 + i % 50;
+    };
+    d.cards[0].load("SD card");
+    d.sd.insert(SD_CS, &d.cards[0]);
+    if (j == 1) d.sd.insert(SD2_CS, &d.cards[1]);
+    if (j == 2) d.cards[0].put(SETTINGS_FILE, "display = 8:00-17:00\n");
+  }
+  for (std::unique_ptr<Device>& d : devices) d->begin();
+
+  // events shared by the monitors of the program, the button is on the
+  // same pin of each
+  uint64_t start = HostSim::now();
+  uint64_t end = start + days * 24 * 60 * US_PER_MIN;
+  for (uint64_t t = start + 7 * US_PER_MIN; t < end; t += 7 * US_PER_MIN) {
+    press(CALIB, t, 150);
+  }
+  press(CALIB, start + 20 * US_PER_MIN, 120);
+  press(CALIB, start + 20 * US_PER_MIN + 300000, 120);
+  // calibration started and aborted
+  press(CALIB, start + 50 * US_PER_MIN, 1500);
+  press(CALIB, start + 52 * US_PER_MIN, 1500);
+  // the card of the first monitor is out for 5 min, the one in the first
+  // slot of the second monitor is taken out for good
+  Device& firstDevice = *devices[0];
+  HostSim::at(start + 30 * US_PER_MIN,
+              [&firstDevice]() { firstDevice.sd.insert(SD_CS, NULL); });
+  HostSim::at(start + 35 * US_PER_MIN, [&firstDevice]() {
+    firstDevice.sd.insert(SD_CS, &firstDevice.cards[0]);
+  });
+  if (group > 1) {
+    Device& second = *devices[1];
+    HostSim::at(start + 40 * US_PER_MIN,
+                [&second]() { second.sd.insert(SD_CS, NULL); });
+  }
+
+  // the files of each day are tallied and removed once the next day is
+  // over, so the cards of a run of months fit into memory
+  std::vector<Tally> tallies(group, Tally());
+  for (uint64_t day = start + 24 * 60 * US_PER_MIN; HostSim::now() < end;
+       day += 24 * 60 * US_PER_MIN) {
+    while (HostSim::now() < min(day, end)) {
+      for (std::unique_ptr<Device>& d : devices) d->update();
+    }
+    for (int j = 0; j < group; j++) {
+      Device& d = *devices[j];
+      collect(d, first + j, count, tallies[j], d.rtc.now().unixtime()
+                                               - 86400);
+    }
+  }
+  // off and on again: the last rows are in the journal only, a logger
+  // started on the cards writes them into the data files
+  for (std::unique_ptr<Device>& d : devices) {
+    Logger logger(d->sd, SD_CS, SD2_CS, LOG_MODE);
+    logger.begin();
+  }
+
+  bool ok = true;
+  for (int j = 0; j < group; j++) {
+    Device& d = *devices[j];
+    Tally& t = tallies[j];
+    bool summary = !d.cards[0].text(DIRECTORY "/" SUMMARY_FILE).empty()
+                   || !d.cards[1].text(DIRECTORY "/" SUMMARY_FILE).empty();
+    collect(d, first + j, count, t);
+    uint32_t missing = d.scd30.measurements - t.rows;
+    WatchdogState& watchdog = d.watchdog.state();
+    fprintf(out, "monitor %d: %u samples, %u rows, %u missing, %u differing, "
+            "%u foreign, %u aborted calibrations, longest loop %.1f ms, "
+            "display %.1f MB, watchdog %u timeouts, longest %.0f ms\n",
+            first + j, d.scd30.measurements, t.rows, missing, t.differing,
+            t.foreign, t.aborted, d.longestLoop / 1e3, d.tft.bytes() / 1e6,
+            watchdog.bites, watchdog.longest / 1e3);
+    ok &= expect(t.rows == d.scd30.measurements, "a row per sample");
+    ok &= expect(t.rows == t.lines.size(), "sequence numbers without gaps");
+    ok &= expect(!t.differing && !t.foreign, "rows of the monitor only");
+    ok &= expect(t.aborted == 1, "one calibration started and aborted");
+    ok &= expect(summary, "a summary at the day change");
+    ok &= expect(!watchdog.bites, "no watchdog timeout");
+  }
+  return ok;
+}
+
+// ____________________________________________________________________________
+// many monitors in groups of BUTTON_MAX, each group in a program of its own
+// as on the MCU the interrupt tables of Button and Clock are shared by the
+// whole program. The groups run in a pool of worker processes
+static int stress(int argc, char** argv) {
+  int count = argc > 0 ? atoi(argv[0]) : 8;
+  double days = argc > 1 ? atof(argv[1]) : 1;
+  int workers = argc > 2 ? atoi(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+  if (count < 1 || days <= 0 || workers < 1) return 2;
+  int groups = (count + BUTTON_MAX - 1) / BUTTON_MAX;
+  printf("%d monitors in %d program(s) on %d worker(s), %.1f days from "
+         "23:00\n",
+         count, groups, workers, days);
+  fflush(stdout);
+
+  // each worker writes into a file of its own, printed once it is done
+  std::vector<FILE*> outputs(groups, NULL);
+  std::map<pid_t, int> running;
+  bool ok = true;
+  for (int next = 0; next < groups || !running.empty();) {
+    if (next < groups && (int) running.size() < workers) {
+      outputs[next] = tmpfile();
+      if (!outputs[next]) return 2;
+      pid_t pid = fork();
+      if (pid < 0) return 2;
+      if (!pid) {
+        int first = next * BUTTON_MAX;
+        bool passed = stressGroup(first, min(BUTTON_MAX, count - first),
+                                  count, days, outputs[next]);
+        fflush(outputs[next]);
+        _exit(!passed);
+      }
+      running[pid] = next++;
+      continue;
+    }
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) return 2;
+    FILE* output = outputs[running[pid]];
+    running.erase(pid);
+    ok &= WIFEXITED(status) && !WEXITSTATUS(status);
+    rewind(output);
+    char line[512];
+    while (fgets(line, sizeof(line), output)) fputs(line, stdout);
+    fclose(output);
+    fflush(stdout);
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// values, time and date drawn with the built-in font scaled by the textsize
+// and with the pre-rasterized fonts of BigFont.h, redrawn whole or only the
+// glyphs that changed
+static int glyphs(int argc, char** argv) {
+  int updates = argc > 0 ? atoi(argv[0]) : 1000;
+  if (updates < 1) return 2;
+  HostSim::reset();
+  FakeDisplay tft;
+  tft.setRotation(PANEL_ROTATION);
+
+  // texts as shown by the firmware: CO2 every 2 s, temperature, the time
+  // every minute and the date
+  std::mt19937 random(1);
+  std::vector<String> texts[4];
+  int co2 = 800, temp = 2150;
+  for (int i = 0; i < updates; i++) {
+    co2 = constrain(co2 + (int) (random() % 21) - 10, 400, 2500);
+    temp = constrain(temp + (int) (random() % 5) - 2, 1500, 3000);
+    texts[0].push_back(String(co2, DEC));
+    texts[1].push_back(String(temp / 100.0f, 1));
+    texts[2].push_back(dig2(i / 60 % 24) + ":" + dig2(i % 60));
+    texts[3].push_back(dig2(i % 28 + 1) + "." + dig2(i / 28 % 12 + 1)
+                       + ".2026");
+  }
+  const char* names[4] = {"CO2", "temp", "time", "date"};
+  const uint8_t sizes[4] = {Layout::VALUE_SIZE, Layout::VALUE_SIZE,
+                            Layout::HEADER_SIZE, Layout::HEADER_SIZE - 1};
+  const char* ways[3] = {"built-in", "big, whole", "big, changes"};
+
+  bool ok = true;
+  printf("per update       windows   pixels    bytes       ms\n");
+  for (uint8_t t = 0; t < 4; t++) {
+    uint64_t bytes[3];
+    for (uint8_t way = 0; way < 3; way++) {
+      Label<FakeDisplay> label(&tft, 100, 100, texts[t][0], sizes[t], WHITE);
+      if (way > 0) label.changeFont(bigFont(sizes[t]), BLACK);
+      label.print();
+      tft.resetCounters();
+      for (const String& text : texts[t]) {
+        if (way == 1) {
+          label.erase(BLACK);
+          label.changeName(text);
+          label.print();
+        } else {
+          label.refresh(text);
+        }
+      }
+      bytes[way] = tft.bytes();
+      printf("%-4s size %u %-12s %5.1f %8.1f %8.1f %8.3f\n", names[t],
+             sizes[t], ways[way], (double) tft.windows / updates,
+             (double) tft.pixels / updates, (double) tft.bytes() / updates,
+             tft.milliseconds() / updates);
+    }
+    ok &= expect(bytes[2] < bytes[0], "fewer bytes with the big font");
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// time from power on until the title is shown, until begin() returns and
+// until the first sample is read, the splash screen is shown until the
+// sensor has measured. The title must not wait for the card.
+static int start(int, char**) {
+  bool ok = true;
+  const char* setups[3] = {"card with logos", "empty card", "no card"};
+  printf("%-16s %10s %10s %10s %12s %10s\n", "", "display", "title",
+         "begin()", "first sample", "watchdog");
+  for (uint8_t setup = 0; setup < 3; setup++) {
+    HostSim::reset();
+    Device d;
+    d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+    if (setup == 0) d.cards[0].load("SD card");
+    if (setup < 2) d.sd.insert(SD_CS, &d.cards[0]);
+    d.begin();
+    double begun = HostSim::now() / 1e3;
+    while (!d.scd30.measurements && HostSim::now() < 60000000) d.update();
+    double first = HostSim::now() / 1e3;
+    d.watchdog.reset();
+    WatchdogState& watchdog = d.watchdog.state();
+    double title = d.tft.shownAt / 1e3;
+    printf("%-16s %7.0f ms %7.0f ms %7.0f ms %9.0f ms %7.0f ms\n",
+           setups[setup], d.tft.milliseconds(), title, begun, first,
+           watchdog.longest / 1e3);
+    ok &= expect(d.tft.shownAt && title < 200, "title shown at once");
+    ok &= expect(first - begun < 50, "first sample read by the first loops");
+    ok &= expect(!watchdog.bites, "no watchdog timeout");
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// line n written by the journal check, its length varies so pages end
+// anywhere in a line
+static std::string journalLine(uint32_t n) {
+  return std::to_string(n) + " " + std::string(n * 7919 % 61, 'a' + n % 26)
+         + "\n";
+}
+
+/* Power cut thrown by an event */
+struct PowerCut {};
+
+// ____________________________________________________________________________
+// power cut at random times while a logger writes lines and while it
+// repairs the file at the next start, writes in progress are torn. Every
+// line the logger journaled must be in the file once and in order, only
+// the line it was writing may be lost
+static int journal(int argc, char** argv) {
+  int trials = argc > 0 ? atoi(argv[0]) : 400;
+  if (trials < 1) return 2;
+  const char* path = "DATA/2026/10/16.CSV";
+  std::mt19937 random(2);
+  uint32_t cuts = 0, repairCuts = 0, starts = 0, lost = 0;
+  bool ok = true;
+  for (int trial = 0; trial < trials && ok; trial++) {
+    HostSim::reset();
+    FakeCard card;
+    SDClass sd;
+    sd.insert(SD_CS, &card);
+    std::vector<bool> journaled;     // for each line appended
+    uint32_t trialCuts = 1 + random() % 5;
+    for (uint32_t cut = 0; cut <= trialCuts; cut++) {
+      // the last start is not cut, it only repairs
+      if (cut < trialCuts) {
+        HostSim::at(HostSim::now() + random() % 400000,
+                    []() { throw PowerCut(); });
+      }
+      bool starting = true;
+      try {
+        Logger logger(sd, SD_CS);
+        logger.begin();
+        starting = false;
+        starts++;
+        // lines of this start are journaled once the ring is empty
+        size_t first = journaled.size();
+        while (cut < trialCuts) {
+          journaled.push_back(false);
+          logger.append(path, journalLine(journaled.size() - 1).c_str());
+          logger.update();
+          if (!logger.pending()) {
+            std::fill(journaled.begin() + first, journaled.end(), true);
+          }
+        }
+      } catch (const PowerCut&) {
+        cuts++;
+        repairCuts += starting;
+      }
+    }
+
+    // the lines of the file: each one whole, in order and at most once
+    std::string text = card.text(path);
+    std::vector<bool> found(journaled.size(), false);
+    uint32_t last = 0;
+    bool first = true, garbage = false;
+    size_t begin = 0, end;
+    for (; (end = text.find('\n', begin)) != std::string::npos;
+         begin = end + 1) {
+      uint32_t n = strtoul(text.c_str() + begin, NULL, 10);
+      if (n >= found.size() || (!first && n <= last)
+          || text.compare(begin, end + 1 - begin, journalLine(n))) {
+        garbage = true;
+        break;
+      }
+      found[n] = true;
+      last = n;
+      first = false;
+    }
+    garbage |= begin != text.size();
+    for (size_t n = 0; n < found.size(); n++) {
+      lost += journaled[n] && !found[n];
+    }
+    ok &= expect(!garbage, "only whole lines in order, each once");
+    ok &= expect(!lost, "every line journaled in the file");
+  }
+  printf("%d trials, %u power cuts, %u of them while repairing, %u starts "
+         "completed\n", trials, cuts, repairCuts, starts);
+  printf("%u lines journaled but lost\n", lost);
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// a day logged with the card out for a while, then random time ranges read
+// by Tools/DataIndex with the index must give the lines of a full scan
+static int timeIndex(int argc, char** argv) {
+  int ranges = argc > 0 ? atoi(argv[0]) : 400;
+  if (ranges < 1) return 2;
+  HostSim::reset();
+  Device d;
+  d.rtc.adjust(DateTime(2026, 10, 16, 0, 0, 0));
+  d.scd30.measure = [](SCD30& s) {
+    s.co2 = 800 + 300 * sin(HostSim::now() / 60e6 / 40);
+  };
+  d.sd.insert(SD_CS, &d.cards[0]);
+  d.begin();
+  // the card is out for 5 min, the ring buffer keeps the lines
+  HostSim::at(3 * 60 * US_PER_MIN, [&d]() { d.sd.insert(SD_CS, NULL); });
+  HostSim::at(3 * 60 * US_PER_MIN + 5 * US_PER_MIN,
+              [&d]() { d.sd.insert(SD_CS, &d.cards[0]); });
+  // until 23:59, before the files of the next day are started
+  while (HostSim::now() < (24 * 60 - 1) * US_PER_MIN) d.update();
+
+  char directory[] = "/tmp/hostsimXXXXXX";
+  if (!mkdtemp(directory)) return 2;
+  std::string data = std::string(directory) + "/16.csv";
+  std::string index = std::string(directory) + "/16.idx";
+  if (!copyOut(d.cards[0], "DATA/2026/10/16.CSV", data)
+      || !copyOut(d.cards[0], "DATA/2026/10/16.IDX", index)) {
+    return 2;
+  }
+
+  // every entry must point to the line of its time
+  FILE* file = fopen(data.c_str(), "rb");
+  FILE* entries = fopen(index.c_str(), "rb");
+  DataIndex::Entry entry;
+  uint32_t count = 0, valid = 0;
+  for (; DataIndex::readEntry(entries, count, &entry); count++) {
+    valid += DataIndex::startOffset(data, file, entry.time) == entry.offset;
+  }
+  fclose(entries);
+  fclose(file);
+
+  // the data lines with their time
+  std::vector<std::pair<uint32_t, std::string>> all;
+  std::string text = d.cards[0].text("DATA/2026/10/16.CSV");
+  for (size_t begin = 0, end; (end = text.find('\n', begin)) !=
+       std::string::npos; begin = end + 1) {
+    std::string line = text.substr(begin, end + 1 - begin);
+    uint32_t time;
+    if (DataIndex::parseTime(line.c_str(), &time)) {
+      all.push_back(std::make_pair(time, line));
+    }
+  }
+  std::mt19937 random(3);
+  uint32_t day = DataIndex::unixTime(2026, 10, 16, 0, 0, 0);
+  uint32_t wrong = 0;
+  uint64_t bytes = 0;
+  for (int i = 0; i < ranges; i++) {
+    uint32_t from = day + random() % 86400;
+    uint32_t to = from + random() % 7200;
+    std::vector<std::string> expected, lines;
+    for (const std::pair<uint32_t, std::string>& line : all) {
+      if (line.first >= from && line.first <= to) {
+        expected.push_back(line.second);
+      }
+    }
+    long read = 0;
+    DataIndex::readRange(data, from, to, [&lines](const char* line) {
+      lines.push_back(line);
+    }, &read);
+    bytes += read;
+    wrong += lines != expected;
+  }
+  remove(data.c_str());
+  remove(index.c_str());
+  rmdir(directory);
+
+  printf("%zu lines, %zu bytes, %u index entries, %u pointing to their "
+         "line\n", all.size(), text.size(), count, valid);
+  printf("%d ranges of up to 2 h: %u differing from a full scan, %.0f bytes "
+         "read on average\n", ranges, wrong, (double) bytes / ranges);
+  bool ok = true;
+  ok &= expect(count >= 24 * 60 * 60 / INDEX_INTERVAL - 1,
+               "an entry per INDEX_INTERVAL");
+  ok &= expect(valid == count, "every entry pointing to its line");
+  ok &= expect(!wrong, "the lines of a full scan");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// CO2 of a room filling with people every 2 s, time in ms: exponential rise
+// towards the equilibrium of its volume, air change rate and people, now
+// and then a window opened for a few minutes, sensor noise of a few ppm
+static std::vector<std::pair<uint32_t, int>> fillRoom(std::mt19937& random) {
+  std::normal_distribution<double> noise(0, 8);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  double volume, ach, people, outdoor = 420;
+  do {
+    volume = 60 + 240 * uniform(random);
+    ach = 0.3 + 3.7 * uniform(random);
+    people = 5 + (int) (26 * uniform(random));
+  } while (outdoor + people * 5.2 / volume * 3600 / ach < CO2_LEVEL_2 + 100);
+  double co2 = outdoor + 200 * uniform(random);
+  double windowAt = uniform(random) < 0.3 ? 3600 * uniform(random) : -1;
+  double windowFor = 180 + 300 * uniform(random);
+  std::vector<std::pair<uint32_t, int>> samples;
+  for (uint32_t t = 0; t < 4 * 3600; t += 2) {
+    // 5.2 ml/s of CO2 per person
+    bool open = t >= windowAt && t < windowAt + windowFor;
+    co2 += 2 * (people * 5.2 / volume
+                - (open ? ach + 10 : ach) / 3600 * (co2 - outdoor));
+    samples.push_back(std::make_pair(t * 1000, (int) lround(co2
+                                                 + noise(random))));
+    if (co2 > CO2_LEVEL_2 + 100) break;
+  }
+  return samples;
+}
+
+/* Predictions of the crossings of a level */
+struct Crossings {
+  uint32_t count;           ///< crossings from below
+  uint32_t predicted;       ///< crossings shown beforehand
+  std::vector<double> errors[3];  ///< min, predictions 0-10, 10-20, 20-30
+                                  ///< min before the crossing
+  uint32_t early;           ///< predictions of a crossing before the real
+  uint32_t predictions;     ///< all predictions of a crossing
+};
+
+// ____________________________________________________________________________
+// feed samples (ms, ppm) to Trend as Monitor does and compare the time it
+// predicts for 1000 ppm with the time the samples cross it
+static void replayTrend(const std::vector<std::pair<uint32_t, int>>& samples,
+                        Crossings* crossings) {
+  Trend trend;
+  // ms of each prediction and of the crossing it predicts
+  std::vector<std::pair<uint32_t, uint32_t>> predictions;
+  bool below = false;
+  for (const std::pair<uint32_t, int>& sample : samples) {
+    trend.add(sample.second, sample.first);
+    if (sample.second < CO2_LEVEL_2 - 100) below = true;
+    if (below && sample.second >= CO2_LEVEL_2) {
+      // a crossing, rising again after being 100 ppm below
+      below = false;
+      crossings->count++;
+      bool shown = false;
+      for (const std::pair<uint32_t, uint32_t>& p : predictions) {
+        uint32_t ahead = sample.first - p.first;
+        if (ahead > PREDICTION_TIME * 60000UL) continue;
+        double error = ((double) p.second - sample.first) / 60000;
+        crossings->errors[min(ahead / 600000, 2U)].push_back(fabs(error));
+        crossings->early += error < 0;
+        crossings->predictions++;
+        shown = true;
+      }
+      crossings->predicted += shown;
+      predictions.clear();
+      continue;
+    }
+    int32_t seconds = sample.second < CO2_LEVEL_2
+                      ? trend.secondsTo(CO2_LEVEL_2) : -1;
+    if (seconds >= 0 && seconds <= PREDICTION_TIME * 60L) {
+      predictions.push_back(std::make_pair(sample.first,
+                                           sample.first + seconds * 1000));
+    }
+  }
+}
+
+// ____________________________________________________________________________
+// median of values, 0 if there are none
+static double median(std::vector<double> values) {
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+// ____________________________________________________________________________
+// simulated rooms and recorded data files replayed through the prediction
+// of the CO2 trend: how many crossings of 1000 ppm it showed beforehand and
+// how far off the time was
+static int trend(int argc, char** argv) {
+  int rooms = argc > 0 ? atoi(argv[0]) : 200;
+  if (rooms < 1) return 2;
+  std::mt19937 random(6);
+  Crossings simulated = {}, recorded = {};
+  for (int room = 0; room < rooms; room++) {
+    replayTrend(fillRoom(random), &simulated);
+  }
+  // data files given after the number of rooms, one replay per file
+  for (int i = 1; i < argc; i++) {
+    FILE* file = fopen(argv[i], "r");
+    if (!file) return 2;
+    std::vector<std::pair<uint32_t, int>> samples;
+    char line[256];
+    uint32_t first = 0, time;
+    int co2;
+    while (fgets(line, sizeof(line), file)) {
+      const char* comma = strchr(line, ',');
+      if (!DataIndex::parseTime(line, &time) || !comma
+          || sscanf(comma, ", %d", &co2) != 1) {
+        continue;
+      }
+      if (samples.empty()) first = time;
+      samples.push_back(std::make_pair((time - first) * 1000, co2));
+    }
+    fclose(file);
+    replayTrend(samples, &recorded);
+  }
+
+  const Crossings* results[2] = {&simulated, &recorded};
+  const char* names[2] = {"simulated rooms", "recorded files"};
+  for (uint8_t i = 0; i < 2; i++) {
+    const Crossings& c = *results[i];
+    if (!c.count) continue;
+    printf("%s: %u of %u crossings of %u ppm predicted beforehand, %.0f %% "
+           "of the predictions early\n", names[i], c.predicted, c.count,
+           CO2_LEVEL_2, 100.0 * c.early / max(c.predictions, 1U));
+    for (uint8_t j = 0; j < 3; j++) {
+      printf("  %2u-%2u min ahead: %6zu predictions, median error %.1f min\n",
+             j * 10, j * 10 + 10, c.errors[j].size(), median(c.errors[j]));
+    }
+  }
+  bool ok = true;
+  ok &= expect(simulated.predicted >= simulated.count * 9 / 10,
+               "9 of 10 crossings predicted");
+  ok &= expect(median(simulated.errors[0]) < 2,
+               "median error below 2 min for 10 min ahead");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+/* Ventilation of a simulated day */
+struct Window {
+  uint32_t start, end;      ///< s of the day
+  double drop;              ///< ppm the CO2 fell without noise
+};
+
+// ____________________________________________________________________________
+// CO2 of a school day every 2 s, time in ms: lessons of 10 to 30 people,
+// breaks in which the room is left with the window closed or opened for 3
+// to 15 min, sometimes also opened during a lesson. Sensor noise of a few
+// ppm and now and then a spike of someone breathing at the sensor. The
+// windows opened are added to windows
+static std::vector<std::pair<uint32_t, int>> schoolDay(
+    std::mt19937& random, std::vector<Window>* windows) {
+  std::normal_distribution<double> noise(0, 8);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  double volume = 60 + 240 * uniform(random);
+  double ach = 0.2 + 0.8 * uniform(random);
+  double outdoor = 420, co2 = outdoor + 50 * uniform(random);
+
+  // people and opened window of each second of the day, lessons from 8:00
+  std::vector<uint8_t> people(86400, 0);
+  std::vector<bool> open(86400, false);
+  uint32_t t = 8 * 3600;
+  while (t < 17 * 3600) {
+    uint32_t lesson = 45 * 60 + random() % (45 * 60);
+    uint8_t n = 10 + random() % 21;
+    std::fill(people.begin() + t, people.begin() + t + lesson, n);
+    if (uniform(random) < 0.3) {
+      uint32_t at = t + 10 * 60 + random() % (lesson - 25 * 60);
+      std::fill(open.begin() + at, open.begin() + at + 180 + random() % 720,
+                true);
+    }
+    t += lesson;
+    uint32_t pause = 10 * 60 + random() % (20 * 60);
+    if (uniform(random) < 0.6) {
+      uint32_t at = t + random() % 120;
+      std::fill(open.begin() + at, open.begin() + at + 180 + random() % 720,
+                true);
+    }
+    t += pause;
+  }
+
+  std::vector<std::pair<uint32_t, int>> samples;
+  double before = co2;
+  uint32_t spike = 0;
+  int spikeHeight = 0;
+  for (t = 0; t < 86400; t += 2) {
+    // opened windows change the air 4 to 15 times an hour
+    if (open[t] && (t < 2 || !open[t - 2])) {
+      before = co2;
+      ach += 4 + 11 * uniform(random);
+    }
+    if (!open[t] && t >= 2 && open[t - 2]) {
+      windows->push_back(Window{0, t, before - co2});
+      for (uint32_t s = t - 2; s > 0 && open[s - 1]; s--) {
+        windows->back().start = s - 1;
+      }
+      ach = 0.2 + 0.8 * uniform(random);
+    }
+    co2 += 2 * (people[t] * 5.2 / volume - ach / 3600 * (co2 - outdoor));
+    if (!spike && random() % 2000 == 0) {
+      spike = 1 + random() % 3;
+      spikeHeight = 200 + random() % 400;
+    }
+    int value = lround(co2 + noise(random)) + (spike ? spikeHeight : 0);
+    if (spike) spike--;
+    samples.push_back(std::make_pair(t * 1000, value));
+  }
+  return samples;
+}
+
+// ____________________________________________________________________________
+// simulated school days and recorded data files replayed through the
+// detector of ventilations: how many windows opened it found and how many
+// ventilations it reported that were none
+static int ventilation(int argc, char** argv) {
+  int days = argc > 0 ? atoi(argv[0]) : 50;
+  if (days < 1) return 2;
+  std::mt19937 random(7);
+  uint32_t deep = 0, found = 0, shallow = 0, shallowFound = 0, wrong = 0;
+  for (int day = 0; day < days; day++) {
+    std::vector<Window> windows;
+    std::vector<std::pair<uint32_t, int>> samples = schoolDay(random,
+                                                              &windows);
+    std::vector<bool> matched(windows.size(), false);
+    VentilationDetector detector;
+    for (const std::pair<uint32_t, int>& sample : samples) {
+      Sample s = {sample.first / 1000, (uint16_t) sample.second, 2150, 4000};
+      if (!detector.add(s, sample.first)) continue;
+      // the window whose time overlaps the detected fall, 2 min margin
+      const Ventilation& v = detector.last();
+      bool any = false;
+      for (size_t i = 0; i < windows.size(); i++) {
+        if (v.start <= windows[i].end + 120
+            && v.end + 120 >= windows[i].start) {
+          matched[i] = true;
+          any = true;
+        }
+      }
+      wrong += !any;
+    }
+    for (size_t i = 0; i < windows.size(); i++) {
+      bool isDeep = windows[i].drop >= VENTILATION_DROP + 30;
+      deep += isDeep;
+      found += isDeep && matched[i];
+      shallow += !isDeep;
+      shallowFound += !isDeep && matched[i];
+    }
+  }
+
+  // data files given after the number of days, the events of each
+  uint32_t events = 0;
+  for (int i = 1; i < argc; i++) {
+    FILE* file = fopen(argv[i], "r");
+    if (!file) return 2;
+    VentilationDetector detector;
+    char line[256];
+    uint32_t first = 0, time;
+    int co2;
+    bool started = false;
+    while (fgets(line, sizeof(line), file)) {
+      const char* comma = strchr(line, ',');
+      if (!DataIndex::parseTime(line, &time) || !comma
+          || sscanf(comma, ", %d", &co2) != 1) {
+        continue;
+      }
+      if (!started) first = time;
+      started = true;
+      Sample s = {time, (uint16_t) co2, 2150, 4000};
+      if (detector.add(s, (time - first) * 1000)) {
+        char event[96];
+        detector.format(event, sizeof(event));
+        printf("%s: %s", argv[i], event);
+        events++;
+      }
+    }
+    fclose(file);
+  }
+
+  printf("%d simulated days: %u of %u ventilations deeper than %u ppm "
+         "detected (%.1f %%), %u of %u shallower ones\n", days, found, deep,
+         VENTILATION_DROP + 30, 100.0 * found / max(deep, 1U), shallowFound,
+         shallow);
+  printf("%u detections without a window opened\n", wrong);
+  if (argc > 1) printf("%u ventilations in the recorded files\n", events);
+  bool ok = true;
+  ok &= expect(found >= deep * 95 / 100, "95 % of the deep ones detected");
+  ok &= expect(!wrong, "no detection without a window opened");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// noisy CO2 values with single spikes of +400 ppm and a step of +300 ppm
+// through the filter in each mode: spikes removed, other values changed
+// and samples until the step passes
+static int filter(int argc, char** argv) {
+  int count = argc > 0 ? atoi(argv[0]) : 20000;
+  if (count < 1000) return 2;
+  std::mt19937 random(8);
+  std::normal_distribution<double> noise(0, 8);
+  std::vector<int32_t> values(count);
+  std::vector<bool> spikes(count, false);
+  int step = count / 2;
+  double co2 = 800;
+  for (int i = 0; i < count; i++) {
+    co2 = constrain(co2 + noise(random) / 4, 500.0, 1500.0);
+    values[i] = lround(co2 + noise(random)) + (i >= step ? 300 : 0);
+  }
+  // 40 spikes apart from each other and from the step
+  for (int n = 0; n < 40;) {
+    int i = 10 + random() % (count - 20);
+    if (abs(i - step) < 10 || spikes[i - 1] || spikes[i] || spikes[i + 1]) {
+      continue;
+    }
+    spikes[i] = true;
+    values[i] += 400;
+    n++;
+  }
+
+  const FilterMode modes[3] = {FILTER_NONE, FILTER_MEDIAN, FILTER_HAMPEL};
+  const char* names[3] = {"none", "median", "Hampel"};
+  bool ok = true;
+  printf("%-8s %8s %16s %14s\n", "mode", "spikes", "others changed",
+         "step after");
+  for (uint8_t m = 0; m < 3; m++) {
+    SpikeFilter filter(modes[m], FILTER_WINDOW, SPIKE_CO2);
+    uint32_t removed = 0, changed = 0;
+    int passed = -1;
+    for (int i = 0; i < count; i++) {
+      int32_t filtered = filter.add(values[i]);
+      if (spikes[i]) {
+        removed += filtered < values[i] - 200;
+      } else {
+        changed += filtered != values[i];
+      }
+      if (passed < 0 && i >= step && filtered >= values[step - 1] + 150) {
+        passed = i - step;
+      }
+    }
+    printf("%-8s %5u/40 %9u/%-6d %6d samples\n", names[m], removed, changed,
+           count - 40, passed);
+    if (modes[m] == FILTER_MODE) {
+      ok &= expect(removed == 40, "all spikes removed");
+      ok &= expect(changed < (uint32_t) count / 100,
+                   "fewer than 1 % of the other values changed");
+      ok &= expect(passed >= 0 && passed <= FILTER_WINDOW / 2,
+                   "step passed after half the window");
+    }
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// two days of a room of 180 m³ at 0.6/h logged by a monitor, 25 and then
+// 10 people each morning: people estimated from the data files, and the air
+// change rate fitted by Tools/AirChange from the decays in the files
+static int occupancy(int, char**) {
+  const double volume = 180, ach = 0.6;
+  HostSim::reset();
+  Device d;
+  d.rtc.adjust(DateTime(2026, 10, 16, 0, 0, 0));
+  d.cards[0].put("settings.txt", "volume = 180\nach = 0.6\n");
+  d.sd.insert(SD_CS, &d.cards[0]);
+
+  // people from 8:00 to 10:00, from 10:00 to 12:00 and from 13:00 to 16:00
+  // each day, the CO2 follows the mass balance of Occupancy.h exactly
+  std::mt19937 random(9);
+  std::normal_distribution<double> noise(0, 5);
+  double co2 = BACKGROUND_CO2;
+  uint64_t last = 0;
+  d.scd30.measure = [&](SCD30& s) {
+    uint32_t minute = HostSim::now() / US_PER_MIN % (24 * 60);
+    int people = minute >= 8 * 60 && minute < 10 * 60 ? 25
+               : minute >= 10 * 60 && minute < 12 * 60 ? 10
+               : minute >= 13 * 60 && minute < 16 * 60 ? 15 : 0;
+    double hours = (HostSim::now() - last) / 3600e6;
+    last = HostSim::now();
+    double equilibrium = BACKGROUND_CO2
+                         + people * (double) CO2_PER_PERSON / volume / ach;
+    co2 = equilibrium + (co2 - equilibrium) * exp(-ach * hours);
+    s.co2 = co2 + noise(random);
+  };
+  d.begin();
+  // until 23:59 of the second day, before the files of the next day
+  while (HostSim::now() < (2 * 24 * 60 - 1) * US_PER_MIN) d.update();
+
+  // estimates from 15 min after the people changed, the fit has settled
+  const char* days[2] = {"DATA/2026/10/16.CSV", "DATA/2026/10/17.CSV"};
+  double lowest[2] = {1e9, 1e9}, highest[2] = {0, 0};
+  for (const char* path : days) {
+    for (const Row& row : readRows(d.cards[0], path)) {
+      uint32_t time;
+      if (!DataIndex::parseTime(row.line.c_str(), &time)) continue;
+      uint32_t minute = time / 60 % (24 * 60);
+      int phase = minute >= 8 * 60 + 15 && minute < 10 * 60 ? 0
+                : minute >= 10 * 60 + 15 && minute < 12 * 60 ? 1 : -1;
+      if (phase < 0) continue;
+      lowest[phase] = min(lowest[phase], row.people);
+      highest[phase] = max(highest[phase], row.people);
+    }
+  }
+
+  // the files on the host, read by the tool in the order of time
+  char directory[] = "/tmp/hostsimXXXXXX";
+  if (!mkdtemp(directory)) return 2;
+  std::vector<AirChange::Point> points;
+  for (const char* path : days) {
+    std::string file = std::string(directory) + "/" + (path + 13);
+    if (!copyOut(d.cards[0], path, file)
+        || !AirChange::readFile(file, points)) {
+      return 2;
+    }
+    remove(file.c_str());
+  }
+  rmdir(directory);
+  // median of the decays of at least 60 min fitting well, as the tool does
+  std::vector<double> good;
+  for (const AirChange::Decay& decay :
+       AirChange::findDecays(points, BACKGROUND_CO2, 60)) {
+    if (decay.r2 >= 0.95 && decay.ach > 0) good.push_back(decay.ach);
+  }
+  std::sort(good.begin(), good.end());
+  double fitted = good.empty() ? 0 : good[good.size() / 2];
+
+  printf("%.0f m³ at %.2f/h, 2 days\n", volume, ach);
+  printf("25 people estimated at %.1f to %.1f\n", lowest[0], highest[0]);
+  printf("10 people estimated at %.1f to %.1f\n", lowest[1], highest[1]);
+  printf("%zu decays, ach = %.2f\n", good.size(), fitted);
+  bool ok = true;
+  ok &= expect(lowest[0] >= 25 * 0.85 && highest[0] <= 25 * 1.15,
+               "25 people estimated within 15 %");
+  ok &= expect(lowest[1] >= 10 * 0.85 && highest[1] <= 10 * 1.15,
+               "10 people estimated within 15 %");
+  ok &= expect(fabs(fitted - ach) < 0.03, "air change rate fitted");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// millis() running fast and slow against the RTC: the drift the clock finds
+// and its error against the RTC before and after the first sync
+static int clockDrift(int argc, char** argv) {
+  double hours = argc > 0 ? atof(argv[0]) : 2;
+  if (hours <= 0) return 2;
+  bool ok = true;
+  const int32_t rates[2] = {50, -300};
+  printf("%8s %8s %18s %18s %6s\n", "millis()", "found", "max error before",
+         "max error after", "steps");
+  for (int32_t rate : rates) {
+    HostSim::reset();
+    RTC_DS3231 rtc;
+    rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+    uint64_t setAt = HostSim::now();
+    // the RTC runs slower by the rate millis() runs faster
+    rtc.ppm = -rate / (1 + rate * 1e-6);
+    Clock clock;
+    clock.begin(rtc, -1);
+
+    // error of the clock against the RTC every 10 ms, before and after the
+    // first sync found the drift
+    double before = 0, after = 0;
+    while (HostSim::now() < hours * 3600e6) {
+      clock.update();
+      uint16_t ms;
+      uint32_t time = clock.now(&ms).unixtime();
+      double rtcMs = DateTime(2026, 10, 16, 9, 0, 0).unixtime() * 1e3
+                     + (HostSim::now() - setAt) * (1 + rtc.ppm * 1e-6) / 1e3;
+      double error = fabs(time * 1e3 + ms - rtcMs);
+      if (clock.drift()) {
+        after = max(after, error);
+      } else {
+        before = max(before, error);
+      }
+      delay(10);
+    }
+    char report[96];
+    clock.report(report, sizeof(report));
+    unsigned steps = 0;
+    sscanf(strstr(report, "steps"), "steps %u", &steps);
+    printf("%+5d ppm %+4d ppm %15.1f ms %15.1f ms %6u\n", rate,
+           clock.drift(), before, after, steps);
+    ok &= expect(abs(clock.drift() - rate) <= 2, "drift found");
+    ok &= expect(after < 4, "error below 4 ms after the first sync");
+    ok &= expect(!steps, "no steps");
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// gestures of two buttons on their own pins with bouncing contacts, read by
+// a fast and a slow loop: each must give its own gestures in order
+static int gestures(int, char**) {
+  const uint8_t pins[2] = {5, 6};
+  // presses as ms from the start and ms held, and the gestures of them
+  const uint32_t presses[2][6][2] = {
+    {{1000, 120}, {2000, 120}, {2270, 120}, {3500, 1500}, {6000, 200},
+     {8000, 80}},
+    {{1500, 1200}, {4000, 100}, {4250, 100}, {6000, 150}, {7000, 90},
+     {7200, 90}},
+  };
+  const std::vector<Gesture> expected[2] = {
+    {GESTURE_SHORT, GESTURE_DOUBLE, GESTURE_LONG, GESTURE_SHORT,
+     GESTURE_SHORT},
+    {GESTURE_LONG, GESTURE_DOUBLE, GESTURE_SHORT, GESTURE_DOUBLE},
+  };
+  const uint32_t loops[2] = {1, 250};
+  bool ok = true;
+  for (uint32_t loop : loops) {
+    HostSim::reset();
+    for (uint8_t pin : pins) HostSim::setPin(pin, HIGH);
+    Button buttons[2];
+    std::vector<Gesture> got[2];
+    for (uint8_t b = 0; b < 2; b++) {
+      ok &= expect(buttons[b].begin(pins[b]), "buttons begun");
+      for (const uint32_t* p : presses[b]) {
+        press(pins[b], p[0] * 1000ULL, p[1]);
+      }
+    }
+    while (HostSim::now() < 10000000) {
+      for (uint8_t b = 0; b < 2; b++) {
+        Gesture gesture = buttons[b].update();
+        if (gesture != GESTURE_NONE) got[b].push_back(gesture);
+      }
+      delay(loop);
+    }
+    const char* names[4] = {"none", "short", "double", "long"};
+    for (uint8_t b = 0; b < 2; b++) {
+      printf("loop of %3u ms, pin %u:", loop, pins[b]);
+      for (Gesture gesture : got[b]) printf(" %s", names[gesture]);
+      printf("\n");
+      ok &= expect(got[b] == expected[b], "the gestures pressed, in order");
+    }
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+/* Elements of the pages as in Monitor, on their own display */
+struct PageSet {
+  FakeDisplay tft;
+  ValueBar<FakeDisplay> co2, temp, rh;
+  ExposureBar<FakeDisplay> exposure;
+  TrendGraph<FakeDisplay> graph;
+  TextPanel<FakeDisplay> statistics, diagnostics;
+  PageManager<FakeDisplay> pages;
+
+  PageSet()
+      : co2(&tft, Layout::CO2_BAR, IMTEK_BLUE, TEXT_COLOR, "CO2", "ppm", 3),
+        temp(&tft, Layout::TEMP_BAR, IMTEK_BLUE, TEXT_COLOR, "Temp", "°C"),
+        rh(&tft, Layout::RH_BAR, IMTEK_BLUE, TEXT_COLOR, "RH", "%"),
+        exposure(&tft, Layout::EXPOSURE, GREY, TEXT_COLOR, CO2_COLORS + 2),
+        graph(&tft, Layout::GRAPH_PAGE, IMTEK_BLUE, TEXT_COLOR, CO2_LEVEL_1,
+              GRAPH_LEVELS, CO2_COLORS + 2, GRAPH_STEP),
+        statistics(&tft, Layout::TEXT_PAGE, IMTEK_BLUE, TEXT_COLOR, "Today"),
+        diagnostics(&tft, Layout::TEXT_PAGE, IMTEK_BLUE, TEXT_COLOR,
+                    "Diagnostics"),
+        pages(&tft, BACKGROUND_COLOR, co2, temp, rh, exposure, graph,
+              statistics, diagnostics) {
+    tft.setRotation(PANEL_ROTATION);
+    tft.fillScreen(BACKGROUND_COLOR);
+  }
+  // a sample every 2 s for given minutes, shown or not
+  void feed(std::mt19937& random, uint32_t minutes) {
+    for (uint32_t i = 0; i < minutes * 30; i++) {
+      value = constrain(value + (int) (random() % 21) - 10, 400, 2500);
+      graph.add(value);
+      if (++samples % (GRAPH_STEP / 2) == 0) graph.close();
+      co2.changeColor(CO2_COLORS[co2Band(value)]);
+      co2.refreshValue((uint16_t) value);
+      temp.refreshValue(21.5f + (samples % 50) / 10.0f);
+      rh.refreshValue(40.0f + (samples % 70) / 10.0f);
+    }
+    const uint16_t above[3] = {(uint16_t) (samples / 300),
+                               (uint16_t) (samples / 900), 0};
+    exposure.refresh(above, samples / 60 % 90);
+    for (uint8_t line = 0; line < 9; line++) {
+      // some lines change, the others stay
+      statistics.refreshLine(line, "CO2 " + String(value + line % 3 * 7)
+                                   + " ppm, line " + String(line));
+      diagnostics.refreshLine(line, line < 4 ? "Card ok, line "
+                                               + String(line)
+                                             : "Uptime " + String(samples));
+    }
+  }
+  int value = 800;
+  uint32_t samples = 0;
+};
+
+// ____________________________________________________________________________
+// pages switched by drawing what differs, compared to clearing the area
+// and drawing the page: bytes on the bus and the image after the switch
+static int pages(int argc, char** argv) {
+  int rounds = argc > 0 ? atoi(argv[0]) : 5;
+  if (rounds < 1) return 2;
+  HostSim::reset();
+  // the same data on both, the first one switches pages, the second one
+  // clears the area and draws them
+  std::unique_ptr<PageSet> sets[2] = {std::unique_ptr<PageSet>(new PageSet),
+                                      std::unique_ptr<PageSet>(new PageSet)};
+  std::mt19937 randoms[2] = {std::mt19937(10), std::mt19937(10)};
+  for (uint8_t s = 0; s < 2; s++) {
+    sets[s]->feed(randoms[s], 3 * 60);
+    sets[s]->pages.show(PAGE_VALUES);
+  }
+
+  // ms of the switches between bars and panel and between two panels
+  double lowest[2][2] = {{1e9, 1e9}, {1e9, 1e9}}, highest[2][2] = {};
+  uint32_t slower = 0, differing = 0, switches = 0;
+  for (int round = 0; round < rounds; round++) {
+    for (uint8_t p = 1; p <= PAGES; p++) {
+      Page page = (Page) (p % PAGES);
+      Page old = sets[0]->pages.page();
+      double ms[2];
+      for (uint8_t s = 0; s < 2; s++) {
+        PageSet& set = *sets[s];
+        set.feed(randoms[s], 5);
+        set.tft.resetCounters();
+        if (s == 1) set.pages.hide();
+        set.pages.show(page);
+        ms[s] = set.tft.milliseconds();
+      }
+      uint8_t kind = old != PAGE_VALUES && page != PAGE_VALUES;
+      for (uint8_t s = 0; s < 2; s++) {
+        lowest[kind][s] = min(lowest[kind][s], ms[s]);
+        highest[kind][s] = max(highest[kind][s], ms[s]);
+      }
+      slower += ms[0] >= ms[1];
+      differing += sets[0]->tft.frame() != sets[1]->tft.frame();
+      switches++;
+    }
+  }
+
+  const char* kinds[2] = {"values <-> panel", "panel <-> panel"};
+  printf("%u switches   %18s %18s\n", switches, "drawing what differs",
+         "clearing the area");
+  for (uint8_t kind = 0; kind < 2; kind++) {
+    printf("%-16s %9.0f - %3.0f ms %11.0f - %3.0f ms\n", kinds[kind],
+           lowest[kind][0], highest[kind][0], lowest[kind][1],
+           highest[kind][1]);
+  }
+  printf("%u switches not faster, %u with another image\n", slower,
+         differing);
+  bool ok = true;
+  ok &= expect(!slower, "every switch faster than clearing the area");
+  ok &= expect(!differing, "the image of clearing the area");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// settings files with schedules read by Settings, malformed values keep the
+// defaults. Then a monitor on a schedule: the display sleeps outside it and
+// is woken by a press, without a loop waiting for the controller
+static int schedule(int, char**) {
+  /* A settings file and the schedule read from it */
+  struct Case {
+    const char* text;
+    uint16_t from, until;
+    uint8_t days;
+  };
+  const Case cases[] = {
+    {"display = 7:00-19:00\ndays = 1-5\n", 420, 1140, 0x3E},
+    // over midnight and a range of days wrapping around the week
+    {"display = 22:00-6:00\ndays = 6-2\n", 1320, 360, 0x47},
+    {"display = 7:00-24:00\ndays = 7\n", 420, 0, 0x01},
+    {"display = 8:00-17:00  # on\r\ndays = 3\r\n", 480, 1020, 0x08},
+    // malformed or out of range
+    {"display = 7-19\ndays = 0-5\n", DISPLAY_FROM, DISPLAY_UNTIL,
+     DISPLAY_DAYS},
+    {"display = 25:00-8:00\ndays = 1-8\n", DISPLAY_FROM, DISPLAY_UNTIL,
+     DISPLAY_DAYS},
+    {"display = 7:60-8:00\ndays = mon\n", DISPLAY_FROM, DISPLAY_UNTIL,
+     DISPLAY_DAYS},
+    {"display 7:00-8:00\ndays = 1-5-7\n", DISPLAY_FROM, DISPLAY_UNTIL,
+     DISPLAY_DAYS},
+  };
+  bool ok = true;
+  unsigned passed = 0;
+  Settings night;
+  for (const Case& c : cases) {
+    HostSim::reset();
+    FakeCard card;
+    card.put(SETTINGS_FILE, c.text);
+    SDClass sd;
+    sd.insert(SD_CS, &card);
+    Settings settings;
+    bool read = sd.begin(SD_CS) && settings.read(sd, SETTINGS_FILE);
+    if (read && settings.displayFrom == c.from
+        && settings.displayUntil == c.until && settings.displayDays == c.days) {
+      passed++;
+    }
+    if (c.from == 1320) night = settings;
+  }
+  printf("%u of %zu settings files read as expected\n", passed,
+         sizeof(cases) / sizeof(cases[0]));
+  ok &= expect(passed == sizeof(cases) / sizeof(cases[0]),
+               "schedules read, malformed values keep the defaults");
+  // 22:00-6:00 Saturday to Tuesday, 16.10.2026 is a Friday
+  ok &= expect(night.displayScheduled(DateTime(2026, 10, 17, 23, 0, 0))
+               && night.displayScheduled(DateTime(2026, 10, 19, 5, 59, 0))
+               && !night.displayScheduled(DateTime(2026, 10, 19, 6, 0, 0))
+               && !night.displayScheduled(DateTime(2026, 10, 16, 23, 0, 0))
+               && !night.displayScheduled(DateTime(2026, 10, 20, 12, 0, 0)),
+               "schedule over midnight and around the week");
+
+  // sleep and wake of a display quicker than its controller allows: each
+  // call returns at once, update() sends the commands when they are due
+  HostSim::reset();
+  FakeDisplay tft;
+  DisplayPower<FakeDisplay> power(&tft, -1);
+  power.begin();
+  delay(500);
+  uint64_t slowest = 0;
+  const uint32_t calls[6] = {0, 20, 30, 60, 200, 210};
+  for (uint32_t ms = 0; ms < 1000; ms++) {
+    uint64_t before = HostSim::now();
+    for (uint8_t i = 0; i < 6; i++) {
+      if (calls[i] != ms) continue;
+      if (i == 0 || i == 3) power.sleep();
+      if (i == 1 || i == 4) power.wake();
+      if (i == 2 || i == 5) power.light();
+    }
+    power.update();
+    slowest = max(slowest, HostSim::now() - before);
+    delay(1);
+  }
+  printf("sleep and wake within 200 ms: %u commands too early, slowest "
+         "call %.1f ms\n", tft.early, slowest / 1e3);
+  ok &= expect(!tft.early && slowest < 5000 && power.awake()
+               && !tft.asleep && tft.output,
+               "commands sent by update() when due, display lit at last");
+
+  // a monitor from 16:55 with the display on until 17:00, pressed at 17:05
+  HostSim::reset();
+  Device d;
+  d.rtc.adjust(DateTime(2026, 10, 16, 16, 55, 0));
+  d.cards[0].put(SETTINGS_FILE, "display = 8:00-17:00\n");
+  d.sd.insert(SD_CS, &d.cards[0]);
+  d.begin();
+  uint64_t start = HostSim::now();
+  press(CALIB, start + 10 * US_PER_MIN, 150);
+  // times the controller went to sleep and woke, and its output went off
+  // and on. In the loops changing them the time not spent on the bus, a
+  // wait for the controller would add to it
+  std::vector<std::pair<uint64_t, const char*>> changes;
+  uint64_t longest = 0;
+  bool asleep = d.tft.asleep, output = d.tft.output;
+  while (HostSim::now() < start + 15 * US_PER_MIN) {
+    uint64_t before = HostSim::now();
+    d.tft.resetCounters();
+    d.update();
+    if (d.tft.asleep == asleep && d.tft.output == output) continue;
+    longest = max(longest, HostSim::now() - before
+                           - (uint64_t) (d.tft.milliseconds() * 1e3));
+    if (asleep && !d.tft.asleep) changes.emplace_back(before, "awake");
+    if (d.tft.output != output) {
+      changes.emplace_back(before, output ? "off" : "on");
+    }
+    if (!asleep && d.tft.asleep) changes.emplace_back(before, "asleep");
+    asleep = d.tft.asleep;
+    output = d.tft.output;
+  }
+  std::string order;
+  for (size_t i = 0; i < changes.size(); i++) {
+    printf("%6.1f s  %s\n", (changes[i].first - start) / 1e6,
+           changes[i].second);
+    order += std::string(i ? " " : "") + changes[i].second;
+  }
+  printf("%u commands too early, longest loop changing the power %.1f ms "
+         "besides the bus\n", d.tft.early, longest / 1e3);
+  ok &= expect(order == "off asleep awake on off asleep",
+               "asleep outside the schedule, woken and asleep again");
+  ok &= expect(changes.size() == 6 && changes[0].first < start
+               + (5 * 60 + 5) * 1000000ULL
+               && changes[2].first < start + 10 * US_PER_MIN + 1000000
+               && changes[4].first > start + (10 * 60 + DISPLAY_WAKE_TIME)
+                                     * 1000000ULL,
+               "asleep at the end of the schedule, woken by the press");
+  ok &= expect(!d.tft.early, "SLEEP_DELAY kept between the commands");
+  ok &= expect(longest < 50000, "no loop waiting for the controller");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+#define IMAGE_W 61          ///< width of the test images, odd on purpose
+#define IMAGE_H 37          ///< height of the test images
+#define IMAGE_AROUND 0x1234 ///< color of the display around the image
+
+/* Test image in one of the formats of bmpReader and the colors of its
+ * pixels, those a 24 bit bmp of the same image shows */
+struct TestImage {
+  const char* format;
+  std::string file;
+  std::vector<uint16_t> expected;   ///< RGB565, row by row from the top
+};
+
+// ____________________________________________________________________________
+// little endian values appended to a file
+static void put16(std::string& file, uint16_t value) {
+  file += (char) (value & 0xFF);
+  file += (char) (value >> 8);
+}
+static void put32(std::string& file, uint32_t value) {
+  put16(file, value & 0xFFFF);
+  put16(file, value >> 16);
+}
+
+// ____________________________________________________________________________
+// 24 bit color 0xRRGGBB as RGB565
+static uint16_t rgb565(uint32_t rgb) {
+  return ((rgb >> 8) & 0xF800) | ((rgb >> 5) & 0x07E0) | ((rgb >> 3) & 0x1F);
+}
+
+// ____________________________________________________________________________
+// color index of each pixel of a test image with given number of colors:
+// blocks and single pixels of other colors, and areas of color 0 that RLE8
+// skips with each of its escapes, the end of the bitmap in the top rows
+static std::vector<uint8_t> testIndices(uint16_t colors) {
+  std::mt19937 random(colors);
+  std::vector<uint8_t> indices(IMAGE_W * IMAGE_H);
+  for (int y = 0; y < IMAGE_H; y++) {
+    for (int x = 0; x < IMAGE_W; x++) {
+      uint8_t index = (x / 7 + y / 5 * 3) % colors;
+      if (random() % 8 == 0) index = random() % colors;
+      if (y < 4 || (y < 10 && x < 50) || (y >= 10 && y < 20 && x >= 40)
+          || (y >= 20 && y < 24) || (y >= 26 && y < 30 && x >= 20 && x < 30)) {
+        index = 0;
+      }
+      indices[y * IMAGE_W + x] = index;
+    }
+  }
+  return indices;
+}
+
+// ____________________________________________________________________________
+// test image as RLE8 rows, bottom-up: runs, literal pixels in absolute mode,
+// and color 0 skipped by a delta, the end of a line or of the bitmap
+static std::string rle8Rows(const std::vector<uint8_t>& indices) {
+  std::string rows;
+  int x = 0;
+  int s = 0;    // row as stored, from the bottom
+  while (true) {
+    const uint8_t* row = &indices[(IMAGE_H - 1 - s) * IMAGE_W];
+    // next pixel not of color 0
+    int nx = x;
+    int ns = s;
+    while (ns < IMAGE_H && (nx == IMAGE_W
+                            || !indices[(IMAGE_H - 1 - ns) * IMAGE_W + nx])) {
+      if (++nx > IMAGE_W) {
+        nx = 0;
+        ns++;
+      }
+    }
+    if (ns == IMAGE_H) {
+      rows += std::string("\0\1", 2);     // end of bitmap
+      return rows;
+    }
+    if (ns > s) {
+      // rest of the row is color 0, a delta if it does not go left
+      if (nx >= x) {
+        rows += std::string("\0\2", 2);
+        rows += (char) (nx - x);
+        rows += (char) (ns - s);
+        x = nx;
+        s = ns;
+      } else {
+        rows += std::string("\0\0", 2);   // end of line
+        x = 0;
+        s++;
+      }
+      continue;
+    }
+    if (nx - x >= 3) {
+      // delta within the row
+      rows += std::string("\0\2", 2);
+      rows += (char) (nx - x);
+      rows += '\0';
+      x = nx;
+      continue;
+    }
+    int n = 1;
+    if (x + 1 < IMAGE_W && row[x + 1] == row[x]) {
+      while (x + n < IMAGE_W && row[x + n] == row[x]) n++;
+      rows += (char) n;
+      rows += (char) row[x];
+    } else {
+      while (x + n < IMAGE_W
+             && !(x + n + 1 < IMAGE_W && row[x + n + 1] == row[x + n])) {
+        n++;
+      }
+      if (n < 3) {
+        // absolute mode needs at least 3 pixels
+        n = 1;
+        rows += '\1';
+        rows += (char) row[x];
+      } else {
+        rows += '\0';
+        rows += (char) n;
+        rows.append((const char*) row + x, n);
+        if (n & 1) rows += '\0';
+      }
+    }
+    x += n;
+  }
+}
+
+// ____________________________________________________________________________
+// bmp file of the size of the test images, the words following the 40 byte
+// header are its palette or bit masks
+static std::string bmpFile(bool topDown, uint16_t depth, uint32_t compression,
+                           const std::vector<uint32_t>& words,
+                           const std::string& rows) {
+  std::string file = "BM";
+  uint32_t offset = 14 + 40 + 4 * words.size();
+  put32(file, offset + rows.size());
+  put32(file, 0);
+  put32(file, offset);
+  put32(file, 40);
+  put32(file, IMAGE_W);
+  put32(file, topDown ? -IMAGE_H : IMAGE_H);
+  put16(file, 1);
+  put16(file, depth);
+  put32(file, compression);
+  put32(file, rows.size());
+  put32(file, 2835);        // 72 dpi
+  put32(file, 2835);
+  put32(file, depth <= 8 ? words.size() : 0);
+  put32(file, 0);
+  for (uint32_t word : words) put32(file, word);
+  return file + rows;
+}
+
+// ____________________________________________________________________________
+// the test image in each format
+static std::vector<TestImage> testImages(void) {
+  std::vector<TestImage> images;
+  std::mt19937 random(5);
+  std::vector<uint32_t> colors(64);
+  for (uint32_t& color : colors) color = random() & 0xFFFFFF;
+  std::vector<uint8_t> indices = testIndices(colors.size());
+  std::vector<uint16_t> expected;
+  for (uint8_t index : indices) expected.push_back(rgb565(colors[index]));
+
+  // 24 bit stored bottom-up and top-down, rows padded to 4 bytes
+  for (bool topDown : {false, true}) {
+    std::string rows;
+    for (int n = 0; n < IMAGE_H; n++) {
+      int y = topDown ? n : IMAGE_H - 1 - n;
+      for (int x = 0; x < IMAGE_W; x++) {
+        uint32_t color = colors[indices[y * IMAGE_W + x]];
+        rows += (char) color;
+        rows += (char) (color >> 8);
+        rows += (char) (color >> 16);
+      }
+      rows.append((4 - IMAGE_W * 3 % 4) % 4, '\0');
+    }
+    images.push_back({topDown ? "24 bit top-down" : "24 bit",
+                      bmpFile(topDown, 24, 0, {}, rows), expected});
+  }
+
+  // raw, pixels in big endian, plain and run length encoded
+  for (bool rle : {false, true}) {
+    std::string file = RAW_MAGIC;
+    put16(file, IMAGE_W);
+    put16(file, IMAGE_H);
+    file += (char) (rle ? RAW_FLAG_RLE : 0);
+    file.append(3, '\0');
+    for (int y = 0; y < IMAGE_H; y++) {
+      const uint16_t* row = &expected[y * IMAGE_W];
+      for (int x = 0; x < IMAGE_W;) {
+        // a run of equal pixels, or literal pixels up to the next run
+        int n = 1;
+        if (!rle) {
+          n = IMAGE_W;
+        } else if (x + 1 < IMAGE_W && row[x + 1] == row[x]) {
+          while (x + n < IMAGE_W && n < 128 && row[x + n] == row[x]) n++;
+          file += (char) (0x80 | (n - 1));
+          file += (char) (row[x] >> 8);
+          file += (char) row[x];
+          x += n;
+          continue;
+        } else {
+          while (x + n < IMAGE_W && n < 128
+                 && !(x + n + 1 < IMAGE_W && row[x + n + 1] == row[x + n])) {
+            n++;
+          }
+          file += (char) (n - 1);
+        }
+        for (int i = 0; i < n; i++) {
+          file += (char) (row[x + i] >> 8);
+          file += (char) row[x + i];
+        }
+        x += n;
+      }
+    }
+    images.push_back({rle ? "raw RLE" : "raw", file, expected});
+  }
+
+  // palettes of 1, 4 and 8 bit, all entries or fewer than the depth allows,
+  // and RLE8. Odd width so rows of sub-byte pixels end within a byte.
+  struct { uint16_t depth, colors; bool rle; const char* format; } palettes[] =
+    {{1, 2, false, "1 bit palette"}, {4, 16, false, "4 bit palette"},
+     {4, 11, false, "4 bit palette of 11"}, {8, 256, false, "8 bit palette"},
+     {8, 200, false, "8 bit palette of 200"}, {8, 200, true, "RLE8"}};
+  for (const auto& palette : palettes) {
+    std::vector<uint32_t> words(palette.colors);
+    for (uint32_t& word : words) word = random() & 0xFFFFFF;
+    indices = testIndices(palette.colors);
+    expected.clear();
+    for (uint8_t index : indices) expected.push_back(rgb565(words[index]));
+    std::string rows;
+    if (palette.rle) {
+      rows = rle8Rows(indices);
+    } else {
+      for (int y = IMAGE_H - 1; y >= 0; y--) {
+        uint32_t bits = 0;
+        uint8_t byte = 0;
+        for (int x = 0; x < IMAGE_W; x++) {
+          byte = byte << palette.depth | indices[y * IMAGE_W + x];
+          bits += palette.depth;
+          if (bits % 8 == 0) {
+            rows += (char) byte;
+            byte = 0;
+          }
+        }
+        if (bits % 8) rows += (char) (byte << (8 - bits % 8));
+        rows.append((4 - (bits + 7) / 8 % 4) % 4, '\0');
+      }
+    }
+    images.push_back({palette.format,
+                      bmpFile(false, palette.depth, palette.rle ? 1 : 0, words,
+                              rows), expected});
+  }
+
+  // 16 bit: 555 by default, and 565 or 555 given by bit masks. A 24 bit bmp
+  // shows a 555 color with each channel extended to 8 bit.
+  struct { uint32_t compression, red; const char* format; } masks[] =
+    {{0, 0x7C00, "16 bit 555"}, {3, 0xF800, "16 bit 565 bit fields"},
+     {3, 0x7C00, "16 bit 555 bit fields"}};
+  for (const auto& mask : masks) {
+    bool rgb555 = mask.red == 0x7C00;
+    std::vector<uint16_t> pixels(64);
+    for (uint16_t& pixel : pixels) {
+      pixel = random() & (rgb555 ? 0x7FFF : 0xFFFF);
+    }
+    indices = testIndices(pixels.size());
+    expected.clear();
+    std::string rows;
+    for (uint8_t index : indices) {
+      uint16_t pixel = pixels[index];
+      uint32_t rgb = pixel;
+      if (rgb555) {
+        uint32_t r = pixel >> 10, g = pixel >> 5 & 0x1F, b = pixel & 0x1F;
+        rgb = (r << 3 | r >> 2) << 16 | (g << 3 | g >> 2) << 8
+              | b << 3 | b >> 2;
+        pixel = rgb565(rgb);
+      }
+      expected.push_back(pixel);
+    }
+    for (int y = IMAGE_H - 1; y >= 0; y--) {
+      for (int x = 0; x < IMAGE_W; x++) {
+        put16(rows, pixels[indices[y * IMAGE_W + x]]);
+      }
+      rows.append((4 - IMAGE_W * 2 % 4) % 4, '\0');
+    }
+    std::vector<uint32_t> words;
+    if (mask.compression == 3) {
+      words = {mask.red, rgb555 ? 0x03E0u : 0x07E0u, 0x001Fu};
+    }
+    images.push_back({mask.format,
+                      bmpFile(false, 16, mask.compression, words, rows),
+                      expected});
+  }
+  return images;
+}
+
+// ____________________________________________________________________________
+// test images in each format drawn by bmpReader: each pixel must get the
+// color of the image and the display around it must stay unchanged
+static int images(int, char**) {
+  bool ok = true;
+  printf("%-26s %8s %8s %8s\n", "format", "bytes", "sectors", "wrong");
+  for (const TestImage& image : testImages()) {
+    HostSim::reset();
+    FakeCard card;
+    const char* name = image.file.compare(0, 4, RAW_MAGIC) ? "IMAGE.BMP"
+                                                           : "IMAGE.565";
+    card.put(name, image.file);
+    SDClass sd;
+    sd.insert(SD_CS, &card);
+    FakeDisplay tft;
+    tft.fillScreen(IMAGE_AROUND);
+    bool mounted = sd.begin(SD_CS);
+    bmpReader<FakeDisplay> reader(&tft, sd);
+    uint32_t before = card.sectorReads;
+    reader.draw(name, 5, 7);
+
+    uint32_t wrong = 0;
+    for (int y = 0; y < IMAGE_H + 14; y++) {
+      for (int x = 0; x < IMAGE_W + 10; x++) {
+        bool inside = x >= 5 && x < 5 + IMAGE_W && y >= 7 && y < 7 + IMAGE_H;
+        uint16_t color = inside ? image.expected[(y - 7) * IMAGE_W + x - 5]
+                                : IMAGE_AROUND;
+        if (tft.pixel(x, y) != color) wrong++;
+      }
+    }
+    printf("%-26s %8zu %8u %8u\n", image.format, image.file.size(),
+           card.sectorReads - before, wrong);
+    ok &= expect(mounted && !wrong, "each pixel in the color of the image");
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// parts of the logos and of the test images drawn by bmpReader, also parts
+// reaching beyond the image and images reaching beyond the screen: each must
+// show the area of the whole image drawn at the same position and nothing
+// else. Rows after the part must not be read, those before only if the file
+// is compressed.
+static int crops(int, char**) {
+  struct Image { std::string format, name, file; };
+  std::vector<Image> files;
+  FakeCard logos;
+  bool loaded = logos.load("SD card");
+  for (const auto& file : logos.files) {
+    std::string content(file.second.begin(), file.second.end());
+    if (content.compare(0, 4, RAW_MAGIC) == 0) {
+      files.push_back({file.first, file.first, content});
+    } else if (content.compare(0, 2, "BM") == 0) {
+      // under a name without a raw image next to it
+      files.push_back({file.first, "LOGO.BMP", content});
+    }
+  }
+  for (const TestImage& image : testImages()) {
+    bool raw = image.file.compare(0, 4, RAW_MAGIC) == 0;
+    files.push_back({image.format, raw ? "IMAGE.565" : "IMAGE.BMP",
+                     image.file});
+  }
+
+  bool ok = expect(loaded && files.size() > 2, "logos loaded from SD card");
+  printf("%-26s %5s %5s %5s %5s %6s %6s %8s %8s\n", "image", "x", "y",
+         "src x", "src y", "src w", "src h", "sectors", "wrong");
+  for (const Image& image : files) {
+    const uint8_t* header = (const uint8_t*) image.file.data();
+    uint16_t w = header[4] | header[5] << 8;
+    uint16_t h = header[6] | header[7] << 8;
+    bool bmp = image.file.compare(0, 2, "BM") == 0;
+    bool topDown = !bmp;
+    if (bmp) {
+      int32_t height;
+      memcpy(&w, &image.file[18], 2);
+      memcpy(&height, &image.file[22], 4);
+      topDown = height < 0;
+      h = abs(height);
+    }
+    bool compressed = image.format.find("RLE") != std::string::npos
+                      || (!bmp && (image.file[8] & RAW_FLAG_RLE));
+
+    // positions and parts: inside, starting within a byte of sub-byte
+    // pixels, before the top left and beyond the bottom right of the image,
+    // and images partly off the screen
+    struct { int16_t x, y; Layout::Rect src; } parts[] = {
+      {10, 20, {3, 5, int16_t(w / 3), int16_t(h / 3)}},
+      {10, 20, {-5, -3, int16_t(w / 2), int16_t(h / 2)}},
+      {10, 20, {int16_t(w - 9), int16_t(h - 7), 40, 30}},
+      {-7, -4, {1, 2, int16_t(w - 2), int16_t(h - 3)}},
+      {int16_t(Layout::SCREEN_W - w / 2), int16_t(Layout::SCREEN_H - h / 2),
+       {0, 0, int16_t(w), int16_t(h)}},
+    };
+    for (const auto& part : parts) {
+      HostSim::reset();
+      FakeCard card;
+      card.put(image.name.c_str(), image.file);
+      SDClass sd;
+      sd.insert(SD_CS, &card);
+      sd.begin(SD_CS);
+      FakeDisplay whole;
+      FakeDisplay tft;
+      for (FakeDisplay* display : {&whole, &tft}) {
+        display->setRotation(PANEL_ROTATION);
+        display->fillScreen(IMAGE_AROUND);
+      }
+      bmpReader<FakeDisplay>(&whole, sd).draw(image.name.c_str(), part.x,
+                                              part.y);
+      uint32_t before = card.sectorReads;
+      bmpReader<FakeDisplay>(&tft, sd).draw(image.name.c_str(), part.x,
+                                            part.y, part.src);
+      uint32_t sectors = card.sectorReads - before;
+
+      uint32_t wrong = 0;
+      for (int16_t y = 0; y < tft.height(); y++) {
+        for (int16_t x = 0; x < tft.width(); x++) {
+          int32_t col = x - part.x;
+          int32_t row = y - part.y;
+          bool inside = col >= part.src.x && col < part.src.x + part.src.w
+                        && row >= part.src.y && row < part.src.y + part.src.h;
+          uint16_t color = inside ? whole.pixel(x, y) : IMAGE_AROUND;
+          if (tft.pixel(x, y) != color) wrong++;
+        }
+      }
+      // rows of the file up to the last visible one, from the first visible
+      // one if rows can be skipped. The sectors they take at most, those of
+      // the header and palette may be read twice.
+      int32_t top = max(max((int32_t) part.src.y, (int32_t) -part.y), 0);
+      int32_t bottom = min(min((int32_t) part.src.y + part.src.h, (int32_t) h),
+                           (int32_t) Layout::SCREEN_H - part.y);
+      int32_t first = topDown ? top : h - bottom;
+      int32_t end = topDown ? bottom : h - top;
+      if (compressed) first = 0;
+      uint32_t offset = RAW_HEADER_SIZE;
+      if (bmp) memcpy(&offset, &image.file[10], 4);
+      uint32_t rows = (image.file.size() - offset) * (end - first) / h;
+      uint32_t most = 2 * ((offset + 511) / 512) + (rows + 511) / 512 + 3;
+
+      printf("%-26s %5d %5d %5d %5d %6d %6d %8u %8u\n", image.format.c_str(),
+             part.x, part.y, part.src.x, part.src.y, part.src.w, part.src.h,
+             sectors, wrong);
+      ok &= expect(!wrong, "the part of the whole image, nothing else");
+      ok &= expect(sectors <= most, "only the rows needed read");
+    }
+  }
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+/* Loop of a monitor blocked by an attempt to mount a missing card */
+struct Stall {
+  uint64_t start;     ///< µs the loop started
+  uint64_t length;    ///< µs it took
+  bool sampled;       ///< a sample was read in the loop
+};
+
+// ____________________________________________________________________________
+// run a monitor until given µs, noting the loops of a second or more
+static void runStalls(Device& d, uint64_t end, std::vector<Stall>& stalls) {
+  while (HostSim::now() < end) {
+    uint32_t measurements = d.scd30.measurements;
+    uint64_t start = HostSim::now();
+    d.update();
+    uint64_t length = HostSim::now() - start;
+    if (length >= 1000000) {
+      stalls.push_back({start, length, d.scd30.measurements != measurements});
+    }
+  }
+}
+
+// ____________________________________________________________________________
+// a monitor without card in its two slots, the SD library blocks for 2 s
+// at each attempt to mount one. The attempts must come right after a
+// sample, one slot per loop, each slot again after REMOUNT_INTERVAL
+// doubling up to REMOUNT_MAX. A press during an attempt must be decoded
+// like one without. Then a card inserted later must get all rows.
+static int remount(int argc, char** argv) {
+  int minutes = argc > 0 ? atoi(argv[0]) : 20;
+  if (minutes < 5) return 2;
+  bool ok = true;
+  uint64_t end = minutes * US_PER_MIN;
+
+  // the loops mounting, a pair of slots each time
+  HostSim::reset();
+  std::vector<Stall> stalls;
+  {
+    Device d;
+    d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+    d.begin();
+    runStalls(d, end, stalls);
+    ok &= expect(!d.watchdog.state().bites, "no watchdog timeout");
+  }
+  printf("%10s %10s %8s %10s %10s\n", "start", "length", "sample", "interval",
+         "expected");
+  bool sampled = true, single = true, backoff = stalls.size() >= 4;
+  for (size_t i = 0; i < stalls.size(); i++) {
+    const Stall& stall = stalls[i];
+    sampled &= stall.sampled;
+    single &= stall.length < 2100000;
+    // from the end of the last attempt of the slot to this one, which
+    // waits for the next sample
+    uint64_t interval = 0, expected = 0;
+    if (i >= 2) {
+      const Stall& last = stalls[i - 2];
+      interval = stall.start - (last.start + last.length);
+      expected = min((uint64_t) REMOUNT_INTERVAL << (i / 2),
+                     (uint64_t) REMOUNT_MAX) * 1000;
+      backoff &= interval >= expected && interval < expected + 2500000;
+    }
+    printf("%8.1f s %7.0f ms %8s %8.1f s %8.1f s\n", stall.start / 1e6,
+           stall.length / 1e3, stall.sampled ? "yes" : "no", interval / 1e6,
+           expected / 1e6);
+  }
+  ok &= expect(sampled, "mounted only in loops that read a sample");
+  ok &= expect(single, "one slot per loop");
+  ok &= expect(backoff, "interval doubled up to REMOUNT_MAX");
+
+  // the same run with a press during the first attempt after the start
+  // switches the page like the press a second later
+  ok &= expect(stalls.size() >= 3, "attempts after the start");
+  if (stalls.size() >= 3) {
+    uint64_t at = stalls[2].start + 500000;
+    std::vector<uint16_t> frames[2];
+    for (int late = 0; late < 2; late++) {
+      HostSim::reset();
+      Device d;
+      d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+      d.begin();
+      press(CALIB, at + late * 1000000, 150);
+      std::vector<Stall> ignored;
+      runStalls(d, at + 4000000, ignored);
+      frames[late] = d.tft.frame();
+    }
+    HostSim::reset();
+    Device d;
+    d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+    d.begin();
+    std::vector<Stall> ignored;
+    runStalls(d, at + 4000000, ignored);
+    ok &= expect(frames[0] == frames[1] && frames[0] != d.tft.frame(),
+                 "press during an attempt decoded");
+  }
+
+  // a card inserted after 3 min is mounted before the ring runs full
+  HostSim::reset();
+  Device d;
+  d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+  d.begin();
+  HostSim::at(3 * US_PER_MIN, [&d]() { d.sd.insert(SD_CS, &d.cards[0]); });
+  stalls.clear();
+  runStalls(d, end, stalls);
+  Tally t = Tally();
+  collect(d, 0, 1, t);
+  printf("card inserted after 3 min: %u of %u rows, %zu attempts\n", t.rows,
+         d.scd30.measurements, stalls.size());
+  // the last rows may still be in the page not yet written to the file,
+  // each takes more than 50 bytes
+  ok &= expect(t.rows == t.lines.size() && !t.differing
+               && (d.scd30.measurements - t.rows) * 50 < PAGE_SIZE,
+               "all rows on the card inserted later");
+
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// a logger in LOG_MIRROR mode gets a line every 2 s and an index entry
+// every 5 min, the card in the second slot is taken out for some minutes.
+// Afterwards both cards must hold the same files with each line once and
+// in order. The statistics of each card count its own writes, no more than
+// sectors reached the card and at least a write per page, and errors, the
+// first card has none
+static int mirror(int argc, char** argv) {
+  int minutes = argc > 0 ? atoi(argv[0]) : 3;
+  if (minutes < 1 || minutes > 5) return 2;   // the ring holds about 6 min
+  HostSim::reset();
+  FakeCard cards[2];
+  SDClass sd;
+  sd.insert(SD_CS, &cards[0]);
+  sd.insert(SD2_CS, &cards[1]);
+  Logger logger(sd, SD_CS, SD2_CS, LOG_MIRROR);
+  bool ok = expect(logger.begin(), "card mounted");
+
+  uint64_t out = 5 * US_PER_MIN;
+  uint64_t in = out + minutes * US_PER_MIN;
+  uint64_t end = in + 5 * US_PER_MIN;
+  HostSim::at(out, [&sd]() { sd.insert(SD2_CS, NULL); });
+  HostSim::at(in, [&sd, &cards]() { sd.insert(SD2_CS, &cards[1]); });
+  const char* path = "DATA/2026/10/16.CSV";
+  uint32_t start = DateTime(2026, 10, 16, 9, 0, 0).unixtime();
+  std::string text;
+  for (uint32_t n = 0; HostSim::now() < end; n++) {
+    DateTime time(start + 2 * n);
+    char line[48];
+    snprintf(line, sizeof(line), "%i/%02i/%02i %02i:%02i:%02i, %lu\n",
+             time.year(), time.month(), time.day(), time.hour(),
+             time.minute(), time.second(), (unsigned long) n);
+    text += line;
+    logger.append(path, line, n % 150 ? 0 : time.unixtime());
+    // the loop of the monitor runs every 100 ms
+    for (uint8_t i = 0; i < 20; i++) {
+      logger.update();
+      HostSim::advance(100000);
+    }
+  }
+  // a full page for another file makes each card write the page of the
+  // data file
+  std::string page(PAGE_SIZE - 1, '-');
+  logger.append("END.TXT", (page + "\n").c_str());
+  for (uint8_t i = 0; i < 100; i++) {
+    logger.update();
+    HostSim::advance(100000);
+  }
+
+  printf("%-6s %8s %8s %8s %8s %10s\n", "card", "file", "writes", "sectors",
+         "errors", "mean");
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    const CardStats& stats = logger.stats(slot);
+    size_t size = cards[slot].text(path).size();
+    printf("%-6u %8zu %8lu %8lu %8lu %7.0f us\n", slot + 1, size,
+           (unsigned long) stats.writes,
+           (unsigned long) cards[slot].sectorWrites,
+           (unsigned long) stats.errors,
+           stats.writes ? (double) stats.totalMicros / stats.writes : 0.0);
+    ok &= expect(cards[slot].text(path) == text, "each line once, in order");
+    ok &= expect(stats.writes >= size / PAGE_SIZE
+                 && stats.writes <= cards[slot].sectorWrites,
+                 "writes of the card counted");
+  }
+  bool same = true;
+  for (const auto& file : cards[0].files) {
+    if (file.first == "JOURNAL.BIN" || file.first == "END.TXT") continue;
+    auto other = cards[1].files.find(file.first);
+    same &= other != cards[1].files.end() && other->second == file.second;
+  }
+  ok &= expect(same && cards[0].files.size() == cards[1].files.size(),
+               "same files on both cards");
+  // the write that failed and an attempt to mount every 30 s at least
+  ok &= expect(!logger.stats(0).errors && logger.stats(1).errors >= 1
+               && logger.stats(1).errors <= 1 + 2U * minutes,
+               "errors counted for the card taken out only");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// data files of the old flat layout moved into year and month directories
+// by a logger that writes a file at the same time, with power cuts at
+// random times. A file whose target exists with other content and one
+// whose target is being written go to DD-1. Every byte must arrive once,
+// and the directory must be read once per start, not once per file.
+static int migration(int argc, char** argv) {
+  int days = argc > 0 ? atoi(argv[0]) : 120;
+  if (days < 2 || days > 1000) return 2;
+  std::mt19937 random(6);
+  HostSim::reset();
+  FakeCard card;
+  SDClass sd;
+  sd.insert(SD_CS, &card);
+
+  // a data file for each day from 2025/03/04 on, every 4th day an event
+  // file as well, their targets and contents
+  struct Move { std::string source, target, content; };
+  std::vector<Move> moves;
+  uint32_t first = DateTime(2025, 3, 4).unixtime();
+  for (int i = 0; i < days; i++) {
+    DateTime date(first + i * 86400UL);
+    for (const char* extension : {"CSV", "EVT"}) {
+      if (extension[0] == 'E' && i % 4) continue;
+      bool collides = i == 1 || (i == 0 && extension[0] == 'C');
+      char source[32], target[40];
+      snprintf(source, sizeof(source), "DATA/%02d-%02d-%02d.%s",
+               date.year() % 100, date.month(), date.day(), extension);
+      snprintf(target, sizeof(target), "DATA/%04d/%02d/%02d%s.%s",
+               date.year(), date.month(), date.day(), collides ? "-1" : "",
+               extension);
+      std::string content(100 + random() % 6000, ' ');
+      for (char& c : content) c = 'a' + random() % 26;
+      card.put(source, content);
+      moves.push_back({source, target, content});
+    }
+  }
+  const char* other = "DATA/2025/03/04.CSV";
+  card.put(other, "another file\n");
+  card.put("DATA/NOTES.TXT", "no data file\n");
+  card.put("DATA/25-3-6.CSV", "no data file either\n");
+  uint32_t entries = 0;
+  for (const auto& file : card.files) {
+    entries += FakeCard::parent(file.first) == "DATA";
+  }
+  for (const std::string& directory : card.directories) {
+    entries += FakeCard::parent(directory) == "DATA";
+  }
+
+  // starts cut at random times until all files are moved, the monitor
+  // appends a line to the target of the second day every 2 s
+  const char* written = "Data/2025/03/05.csv";
+  uint32_t starts = 0, cuts = 0, cutCopies = 0, lines = 0;
+  bool done = false;
+  while (!done && HostSim::now() < 3600 * 1000000ULL) {
+    HostSim::at(HostSim::now() + random() % 10000000,
+                []() { throw PowerCut(); });
+    try {
+      Logger logger(sd, SD_CS);
+      logger.begin();
+      logger.migrate(DIRECTORY);
+      starts++;
+      while (!done) {
+        char line[24];
+        snprintf(line, sizeof(line), "line %lu\n", (unsigned long) lines++);
+        logger.append(written, line);
+        for (uint8_t i = 0; i < 20; i++) {
+          logger.update();
+          HostSim::advance(100000);
+        }
+        done = true;
+        for (const Move& move : moves) done &= !card.files.count(move.source);
+      }
+    } catch (const PowerCut&) {
+      cuts++;
+      // a copy cut in the middle leaves a target shorter than its source
+      for (const Move& move : moves) {
+        auto target = card.files.find(move.target);
+        if (card.files.count(move.source) && target != card.files.end()
+            && target->second.size() < move.content.size()) {
+          cutCopies++;
+        }
+      }
+    }
+  }
+  double seconds = HostSim::now() / 1e6;
+  HostSim::reset();   // the cut scheduled last
+
+  uint32_t moved = 0;
+  uint64_t bytes = 0;
+  for (const Move& move : moves) {
+    if (!card.files.count(move.source) && card.text(move.target.c_str())
+                                          == move.content) {
+      moved++;
+      bytes += move.content.size();
+    }
+  }
+  // no other files in the year directories than the targets, the file
+  // that was there and the one written
+  bool stray = false;
+  for (const auto& file : card.files) {
+    if (file.first.compare(0, 7, "DATA/20") || file.first == other
+        || file.first == FakeCard::key(written)) {
+      continue;
+    }
+    bool target = false;
+    for (const Move& move : moves) target |= move.target == file.first;
+    stray |= !target;
+  }
+  // lines of the written file in order, only those not yet journaled at a
+  // cut may be missing
+  std::string text = card.text(written);
+  bool ordered = !text.empty();
+  long last = -1;
+  for (size_t begin = 0, end; (end = text.find('\n', begin))
+                              != std::string::npos; begin = end + 1) {
+    long n = -1;
+    ordered &= sscanf(text.c_str() + begin, "line %ld", &n) == 1 && n > last;
+    last = n;
+  }
+
+  printf("%u files of %llu bytes moved in %.0f s, %u starts, %u cuts, "
+         "%u of them copying\n", moved, (unsigned long long) bytes,
+         seconds, starts, cuts, cutCopies);
+  printf("%u directory entries read, %u entries\n", card.entryReads, entries);
+  bool ok = expect(done, "no file left in the old layout");
+  ok &= expect(moved == moves.size(), "each file moved exactly once");
+  ok &= expect(cutCopies > 0, "copies cut in the middle");
+  ok &= expect(!stray && card.text(other) == "another file\n" && ordered,
+               "the file there before and the one written kept");
+  ok &= expect(card.entryReads <= starts * entries,
+               "directory read at most once per start");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+// ____________________________________________________________________________
+// CO2 in band as given of a sample of the scripted trace at t seconds, with
+// temperature and humidity in 0.01 units. Samples every 2 s
+//   t [s]        co2 [ppm]              temp   rh
+//      0 -  598  600 green              21.50  40.00
+//    600 - 1198  1200 yellow            24.00  40.00
+//   1200 - 1798  1700 orange            21.50  40.00
+//   1800 - 2398  2100 red               21.50  40.00
+//   2700 - 3298  2100 red, after 5 min without samples
+//   3300 - 4258  2100 - (t - 3300) * 5 / 3, a window opened, 100 ppm/min
+//                                       21.50  50.00
+//   4260 - 5398  500 green              21.50  35.00
+//   5400 - 5698  380 grey               19.00  40.00
+static Sample traceSample(uint32_t t) {
+  Sample s = {DateTime(2026, 10, 16, 8, 0, 0).unixtime() + t, 600, 2150,
+              4000};
+  if (t >= 600 && t < 1200) s.temp = 2400;
+  if (t >= 600) s.co2 = 1200;
+  if (t >= 1200) s.co2 = 1700;
+  if (t >= 1800) s.co2 = 2100;
+  if (t >= 3300 && t < 4260) {
+    s.co2 = 2100 - (t - 3300) * 5 / 3;
+    s.rh = 5000;
+  }
+  if (t >= 4260) {
+    s.co2 = 500;
+    s.rh = 3500;
+  }
+  if (t >= 5400) {
+    s.co2 = 380;
+    s.temp = 1900;
+    s.rh = 4000;
+  }
+  return s;
+}
+
+// ____________________________________________________________________________
+// statistics and ventilations of the scripted trace compared to the results
+// worked out by hand. Then a monitor with the CO2 changing at each sample:
+// bytes drawn into the exposure bar, only when the minute changes
+static int statistics(int argc, char** argv) {
+  int minutes = argc > 0 ? atoi(argv[0]) : 10;
+  if (minutes < 3) return 2;
+  bool ok = true;
+
+  DailyStatistics daily;
+  VentilationDetector detector;
+  for (uint32_t t = 0; t < 5700; t += 2) {
+    if (t >= 2400 && t < 2700) continue;     // no samples
+    Sample s = traceSample(t);
+    daily.add(s, t * 1000);
+    if (detector.add(s, t * 1000)) daily.addVentilation();
+  }
+  // The first sample adds no time, the others the 2 s since the one
+  // before, the first after the gap of 302 s only MAX_SAMPLE_GAP. The
+  // ramp is red down to 2000 ppm at t = 3360 (31 samples), orange down to
+  // 1500 at 3660 (150), yellow down to 1000 at 3960 (150) and green until
+  // 4258 (149 samples)
+  const uint32_t seconds[CO2_BANDS] = {
+    150 * 2,                            // 300, grey
+    299 * 2 + 149 * 2 + 570 * 2,        // 2036, green
+    300 * 2 + 150 * 2,                  // 900, yellow
+    300 * 2 + 150 * 2,                  // 900, orange
+    300 * 2 + 60 + 299 * 2 + 31 * 2     // 1320, red
+  };
+  // 2700 samples, the sum of CO2 is 3276960, as the sum of
+  // (t - 3300) * 5 / 3 over the 480 samples of the ramp with
+  // t - 3300 = 2k is that of 3k + k / 3 for k from 0 to 479, 383040.
+  // Temperature sums to 5842500, humidity to 10995000. Minutes are
+  // rounded to the nearest
+  const char* expected = "2026/10/16, 08:00, 09:34, 2700, 5, 34, 15, 15, "
+                         "22, 380, 2100, 1214, 19.00, 24.00, 21.64, 35.00, "
+                         "50.00, 40.72, 1\n";
+  char line[160];
+  daily.format(line, sizeof(line));
+  printf("%-8s %8s %8s\n", "band", "seconds", "expected");
+  const char* bands[CO2_BANDS] = {"grey", "green", "yellow", "orange",
+                                  "red"};
+  bool same = true;
+  for (uint8_t band = 0; band < CO2_BANDS; band++) {
+    printf("%-8s %8u %8u\n", bands[band], daily.seconds(band),
+           seconds[band]);
+    same &= daily.seconds(band) == seconds[band];
+  }
+  printf("summary   %s", line);
+  printf("expected  %s", expected);
+  ok &= expect(same, "seconds in each band");
+  ok &= expect(daily.minutesFrom(2) == 52 && daily.minutesFrom(3) == 37
+               && daily.minutesFrom(4) == 22, "minutes from the levels");
+  ok &= expect(!strcmp(line, expected), "summary line");
+  ok &= expect(daily.ventilations() == 1, "one ventilation");
+  const Ventilation& v = detector.last();
+  ok &= expect(v.co2Start >= 2000 && v.co2End <= 600,
+               "ventilation from the level before to the one after");
+
+  // the exposure bar of a monitor, the CO2 changes at each sample but stays
+  // in the yellow band, its minutes change at each minute from the second
+  HostSim::reset();
+  Device d;
+  d.rtc.adjust(DateTime(2026, 10, 16, 9, 0, 0));
+  d.scd30.measure = [](SCD30& s) { s.co2 = 1150 + s.measurements % 7 * 15; };
+  const Layout::Rect& bar = Layout::EXPOSURE.bar;
+  d.tft.watch(bar.x, bar.y, bar.w, bar.h);
+  d.begin();
+  d.update();
+  d.tft.resetCounters();
+  uint32_t redraws = 0, misplaced = 0;
+  uint64_t lowest = UINT64_MAX, highest = 0, all = 0;
+  int32_t last = -1;
+  while (HostSim::now() < minutes * US_PER_MIN) {
+    d.update();
+    if (!d.tft.watched) continue;
+    // right after the minute changed and once in it
+    int32_t minute = HostSim::now() / US_PER_MIN;
+    misplaced += HostSim::now() % US_PER_MIN > 1000000 || minute == last;
+    last = minute;
+    redraws++;
+    lowest = min(lowest, d.tft.watched);
+    highest = max(highest, d.tft.watched);
+    all += d.tft.bytes();
+    d.tft.resetCounters();
+  }
+  all += d.tft.bytes();
+  printf("%d minutes: exposure bar drawn %u times with %llu - %llu bytes, "
+         "%llu bytes in all\n", minutes, redraws,
+         (unsigned long long) (redraws ? lowest : 0),
+         (unsigned long long) highest, (unsigned long long) all);
+  ok &= expect(!misplaced, "exposure bar drawn only as the minute changes");
+  ok &= expect(redraws >= (uint32_t) minutes - 2,
+               "exposure bar drawn when its minutes change");
+  printf("%s\n", ok ? "passed" : "failed");
+  return !ok;
+}
+
+/*****************************************************************************
+    Main
+*****************************************************************************/
+
+/* A check with its name and arguments */
+struct Check {
+  const char* name;
+  int (*run)(int argc, char** argv);
+  const char* arguments;
+};
+
+const Check CHECKS[] = {
+  {"stress", stress, "[monitors] [days] [workers]"},
+  {"glyphs", glyphs, "[updates]"},
+  {"start", start, ""},
+  {"journal", journal, "[trials]"},
+  {"index", timeIndex, "[ranges]"},
+  {"trend", trend, "[rooms] [files]"},
+  {"ventilation", ventilation, "[days] [files]"},
+  {"filter", filter, "[values]"},
+  {"occupancy", occupancy, ""},
+  {"clock", clockDrift, "[hours]"},
+  {"gestures", gestures, ""},
+  {"pages", pages, "[rounds]"},
+  {"schedule", schedule, ""},
+  {"images", images, ""},
+  {"crops", crops, ""},
+  {"remount", remount, "[minutes]"},
+  {"mirror", mirror, "[minutes]"},
+  {"migration", migration, "[days]"},
+  {"statistics", statistics, "[minutes]"},
+};
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  for (const Check& check : CHECKS) {
+    if (argc > 1 && !strcmp(argv[1], check.name)) {
+      return check.run(argc - 2, argv + 2);
+    }
+  }
+  fprintf(stderr, "usage:\n");
+  for (const Check& check : CHECKS) {
+    fprintf(stderr, "  %s %s %s\n", argv[0], check.name, check.arguments);
+  }
+  return 2;
+}
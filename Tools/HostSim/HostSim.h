@@ -0,0 +1,336 @@
+/******************************************************************************
+ * 
+ * Run the firmware on the host with fake peripherals.
+ * 
+ * Header-only host library to compile the firmware for a computer instead
+ * of the Feather M0. The directory libraries/ holds fakes of the Arduino
+ * core and of the libraries the firmware includes:
+ *  - Arduino.h: virtual time, pins, interrupts and events at a given time
+ *  - SD.h: cards in memory, which can be taken out and put in at any time
+ *  - RTClib.h: DateTime and a DS3231 counting on the virtual time
+ *  - SparkFun_SCD30_Arduino_Library.h: a sensor measuring scripted values
+ *  - Adafruit_SleepyDog.h: a watchdog counting timeouts instead of a reset
+ * This file adds FakeDisplay, a display with a frame buffer that counts
+ * what is sent to it, to be given to the templates of the firmware.
+ * 
+ * Time only advances while the firmware waits or a peripheral transfers
+ * data, at roughly the rate of the real bus, so durations measured in the
+ * simulation are estimates of those of the device, not exact.
+ * 
+ * Usage:
+ *  #include "HostSim.h"
+ *  #include "Monitor.h"
+ *  FakeDisplay tft; SCD30 scd30; RTC_DS3231 rtc; SDClass sd; FakeCard card;
+ *  TwoWire wire; WatchdogType watchdog;
+ *  sd.insert(SD_CS, &card);
+ *  Monitor<FakeDisplay> monitor(tft, scd30, rtc, sd, wire, watchdog);
+ *  monitor.begin();
+ *  while (millis() < 60000) monitor.update();
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOST_SIM__H_
+#define _HOST_SIM__H_
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <SD.h>
+#include <Wire.h>
+#include <RTClib.h>
+#include <SparkFun_SCD30_Arduino_Library.h>
+#include <Adafruit_SleepyDog.h>
+
+#define DISPLAY_SPI_HZ  24000000  ///< SPI clock of the display
+#define WINDOW_BYTES    11        ///< bytes to set an address window
+
+/* Glyph of the 5x7 font of Adafruit_GFX: 5 columns, LSB is the top row */
+struct FakeGlyph {
+  uint8_t code;
+  uint8_t columns[5];
+};
+
+// glyphs of the characters drawn most, the ones of Tools/FontGen, others
+// are given a pattern of about as many pixels, see glyph()
+const FakeGlyph FAKE_GLYPHS[] = {
+  {' ', {0x00, 0x00, 0x00, 0x00, 0x00}},
+  {'%', {0x23, 0x13, 0x08, 0x64, 0x62}},
+  {'-', {0x08, 0x08, 0x08, 0x08, 0x08}},
+  {'.', {0x00, 0x60, 0x60, 0x00, 0x00}},
+  {'/', {0x20, 0x10, 0x08, 0x04, 0x02}},
+  {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}},
+  {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+  {'2', {0x72, 0x49, 0x49, 0x49, 0x46}},
+  {'3', {0x21, 0x41, 0x49, 0x4D, 0x33}},
+  {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}},
+  {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+  {'6', {0x3C, 0x4A, 0x49, 0x49, 0x31}},
+  {'7', {0x41, 0x21, 0x11, 0x09, 0x07}},
+  {'8', {0x36, 0x49, 0x49, 0x49, 0x36}},
+  {'9', {0x46, 0x49, 0x49, 0x29, 0x1E}},
+  {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+  {'C', {0x3E, 0x41, 0x41, 0x41, 0x22}},
+  {'m', {0x7C, 0x04, 0x18, 0x04, 0x78}},
+  {'p', {0x7C, 0x14, 0x14, 0x14, 0x08}},
+  {248, {0x00, 0x06, 0x09, 0x09, 0x06}},
+};
+
+/* Display with a frame buffer counting the bytes sent to it.
+ * Draws like Adafruit_SPITFT: each rectangle or line is an address window
+ * and its pixels, each pixel of a line that is not straight or of a glyph
+ * of the built-in font an address window of its own (size x size pixels
+ * with a textsize above 1). The time of the bytes at DISPLAY_SPI_HZ is
+ * added to the virtual time. Sleep in or out and display on sent less than
+ * 120 ms after a sleep in or out, too early for the HX8357, are counted. */
+class FakeDisplay {
+ public:
+  /* Methods */
+  // width and height without rotation, those of the HX8357
+  FakeDisplay(int16_t width = 320, int16_t height = 480)
+      : windows(0), pixels(0), commands(0), watched(0), early(0),
+        shownAt(0), asleep(false), output(true), _nativeW(width),
+        _nativeH(height), _w(width), _h(height), _frame(width * height, 0),
+        _window{0, 0, 0, 0}, _next(0), _cursorX(0), _cursorY(0), _size(1),
+        _color(0xFFFF), _spiBits(0), _sleepAt(0), _watch{0, 0, 0, 0} {}
+
+  // counters since the last call
+  void resetCounters(void) { windows = pixels = commands = watched = 0; }
+  // area whose windows and pixels are counted in watched
+  void watch(int16_t x, int16_t y, int16_t w, int16_t h) {
+    _watch[0] = x; _watch[1] = y; _watch[2] = w; _watch[3] = h;
+  }
+  // bytes sent since resetCounters()
+  uint64_t bytes(void) const {
+    return windows * WINDOW_BYTES + pixels * 2 + commands;
+  }
+  // ms the bytes take on the SPI bus
+  double milliseconds(void) const {
+    return bytes() * 8 * 1e3 / DISPLAY_SPI_HZ;
+  }
+  // color of a pixel of the frame buffer
+  uint16_t pixel(int16_t x, int16_t y) const {
+    return inside(x, y) ? _frame[y * _w + x] : 0;
+  }
+  const std::vector<uint16_t>& frame(void) const { return _frame; }
+
+  /* Methods of Adafruit_HX8357 used by the firmware */
+  void begin(uint32_t = 0) { send(0, 0, 24); }
+  void setRotation(uint8_t r) {
+    _w = r % 2 ? _nativeH : _nativeW;
+    _h = r % 2 ? _nativeW : _nativeH;
+    _frame.assign(_w * _h, 0);
+    send(0, 0, 2);
+  }
+  void cp437(bool = true) {}
+  int16_t width(void) const { return _w; }
+  int16_t height(void) const { return _h; }
+  void sendCommand(uint8_t command, uint8_t* = NULL, uint8_t n = 0) {
+    send(0, 0, 1 + n);
+    if (command == 0x10 || command == 0x11 || command == 0x29) {
+      if (_sleepAt && HostSim::now() - _sleepAt < 120000) early++;
+    }
+    if (command == 0x10 || command == 0x11) _sleepAt = HostSim::now();
+    if (command == 0x10) asleep = true;   // sleep in
+    if (command == 0x11) asleep = false;  // sleep out
+    if (command == 0x28) output = false;  // display off
+    if (command == 0x29) output = true;   // display on
+  }
+
+  void startWrite(void) {}
+  void endWrite(void) {}
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    _window[0] = x; _window[1] = y; _window[2] = w; _window[3] = h;
+    _next = 0;
+    send(1, 0);
+  }
+  void writeColor(uint16_t color, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) stream(color);
+    send(0, len);
+  }
+  void writePixels(uint16_t* colors, uint32_t len, bool = true,
+                   bool bigEndian = false) {
+    for (uint32_t i = 0; i < len; i++) {
+      uint16_t c = colors[i];
+      stream(bigEndian ? (uint16_t) (c << 8 | c >> 8) : c);
+    }
+    send(0, len);
+  }
+  void fillScreen(uint16_t color) { fillRect(0, 0, _w, _h, color); }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!clip(x, y, w, h)) return;
+    fill(x, y, w, h, color);
+    _window[0] = x; _window[1] = y; _window[2] = w; _window[3] = h;
+    _next = 0;
+    send(1, (uint32_t) w * h);
+  }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color) {
+    fillRect(x, y, w, h, color);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
+  }
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    fillRect(x, y, 1, 1, color);
+  }
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color) {
+    if (y0 == y1) {
+      drawFastHLine(min(x0, x1), y0, abs(x1 - x0) + 1, color);
+      return;
+    }
+    if (x0 == x1) {
+      drawFastVLine(x0, min(y0, y1), abs(y1 - y0) + 1, color);
+      return;
+    }
+    // Bresenham, a window per pixel like writeLine()
+    int16_t dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    int16_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int16_t error = dx + dy;
+    while (true) {
+      drawPixel(x0, y0, color);
+      if (x0 == x1 && y0 == y1) break;
+      int16_t e2 = 2 * error;
+      if (e2 >= dy) { error += dy; x0 += sx; }
+      if (e2 <= dx) { error += dx; y0 += sy; }
+    }
+  }
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    r = min(r, (int16_t) (min(w, h) / 2));
+    // the body, then a vertical line per column of the corners
+    fillRect(x + r, y, w - 2 * r, h, color);
+    for (int16_t i = 0; i < r; i++) {
+      int16_t d = r - i;
+      int16_t inset = r - (int16_t) lround(sqrt((double) r * r - d * d));
+      fillRect(x + i, y + inset, 1, h - 2 * inset, color);
+      fillRect(x + w - 1 - i, y + inset, 1, h - 2 * inset, color);
+    }
+  }
+
+  /* Text of the built-in font, transparent like setTextColor(color) */
+  void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+  void setTextSize(uint8_t size) { _size = size ? size : 1; }
+  void setTextColor(uint16_t color) { _color = color; }
+  void setTextColor(uint16_t color, uint16_t) { _color = color; }
+  int16_t getCursorX(void) const { return _cursorX; }
+  int16_t getCursorY(void) const { return _cursorY; }
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t print(const char* s) {
+    size_t n = 0;
+    for (; s[n]; n++) print(s[n]);
+    return n;
+  }
+  size_t print(char c) {
+    if (c == '\n') {
+      _cursorX = 0;
+      _cursorY += 8 * _size;
+    } else if (c != '\r') {
+      drawChar((uint8_t) c);
+      _cursorX += 6 * _size;
+    }
+    return 1;
+  }
+  size_t print(int value) { return print(String(value)); }
+  size_t println(void) { return print('\n'); }
+  template <class T>
+  size_t println(const T& value) { return print(value) + println(); }
+
+  /* Members */
+  uint64_t windows;         ///< address windows set
+  uint64_t pixels;          ///< pixels written
+  uint64_t commands;        ///< bytes of other commands
+  uint64_t watched;         ///< bytes of windows and pixels in watch()
+  uint32_t early;           ///< commands sent too early after a sleep
+  uint64_t shownAt;         ///< µs the first pixels were sent, 0 if none
+  bool asleep;              ///< controller in sleep mode
+  bool output;              ///< output of the controller turned on
+
+ private:
+  bool inside(int16_t x, int16_t y) const {
+    return x >= 0 && y >= 0 && x < _w && y < _h;
+  }
+  bool clip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _w) w = _w - x;
+    if (y + h > _h) h = _h - y;
+    return w > 0 && h > 0;
+  }
+  void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++) {
+      std::fill(&_frame[j * _w + x], &_frame[j * _w + x + w], color);
+    }
+  }
+  // address window overlaps the watched area
+  bool watching(void) const {
+    return _window[0] < _watch[0] + _watch[2]
+           && _watch[0] < _window[0] + _window[2]
+           && _window[1] < _watch[1] + _watch[3]
+           && _watch[1] < _window[1] + _window[3];
+  }
+  // next pixel of the address window
+  void stream(uint16_t color) {
+    uint32_t area = (uint32_t) _window[2] * _window[3];
+    if (!area) return;
+    uint32_t i = _next++ % area;
+    int16_t x = _window[0] + i % _window[2];
+    int16_t y = _window[1] + i / _window[2];
+    if (inside(x, y)) _frame[y * _w + x] = color;
+  }
+  // count and spend the time of windows, pixels and other bytes
+  void send(uint32_t newWindows, uint32_t newPixels, uint32_t other = 0) {
+    windows += newWindows;
+    pixels += newPixels;
+    commands += other;
+    if (watching()) watched += newWindows * WINDOW_BYTES + newPixels * 2ULL;
+    if (newPixels && !shownAt) shownAt = HostSim::now();
+    _spiBits += (newWindows * WINDOW_BYTES + newPixels * 2ULL + other) * 8
+                * 1000000ULL;
+    HostSim::advance(_spiBits / DISPLAY_SPI_HZ);
+    _spiBits %= DISPLAY_SPI_HZ;
+  }
+  // glyph of the 5x7 font, for the others a pattern of about as many pixels
+  FakeGlyph glyph(uint8_t c) const {
+    for (const FakeGlyph& g : FAKE_GLYPHS) {
+      if (g.code == c) return g;
+    }
+    FakeGlyph g = {c, {0x41, 0x22, 0x1C, 0x22, 0x41}};
+    for (uint8_t i = 0; i < 5; i++) g.columns[i] ^= (c >> i) & 1;
+    g.columns[2] |= 0x22;
+    return g;
+  }
+  void drawChar(uint8_t c) {
+    FakeGlyph g = glyph(c);
+    for (int16_t i = 0; i < 5; i++) {
+      for (int16_t j = 0; j < 8; j++) {
+        if (g.columns[i] >> j & 1) {
+          fillRect(_cursorX + i * _size, _cursorY + j * _size, _size, _size,
+                   _color);
+        }
+      }
+    }
+  }
+
+  int16_t _nativeW, _nativeH;   ///< size without rotation
+  int16_t _w, _h;               ///< size with rotation
+  std::vector<uint16_t> _frame; ///< pixels, row by row
+  uint16_t _window[4];          ///< x, y, w, h of the address window
+  uint32_t _next;               ///< pixel of the window written next
+  int16_t _cursorX, _cursorY;   ///< position of the next char
+  uint8_t _size;                ///< textsize
+  uint16_t _color;              ///< color of the text
+  uint64_t _spiBits;            ///< bits x 1e6 not yet added to the time
+  uint64_t _sleepAt;            ///< µs of the last sleep in or out, 0 none
+  int16_t _watch[4];            ///< x, y, w, h of the watched area
+};
+
+#endif  // _HOST_SIM__H_
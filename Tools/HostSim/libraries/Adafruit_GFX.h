@@ -0,0 +1,20 @@
+/******************************************************************************
+ * 
+ * Adafruit_GFX of the host simulation. The firmware only takes the class of
+ * its display as template parameter, the fake display of HostSim.h stands
+ * in for Adafruit_HX8357 and needs nothing from here.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_ADAFRUIT_GFX__H_
+#define _HOSTSIM_ADAFRUIT_GFX__H_
+
+#include <Arduino.h>
+
+#endif  // _HOSTSIM_ADAFRUIT_GFX__H_
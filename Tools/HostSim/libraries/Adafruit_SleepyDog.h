@@ -0,0 +1,59 @@
+/******************************************************************************
+ * 
+ * Watchdog of the host simulation, see HostSim.h.
+ * 
+ * Instead of resetting the MCU a timeout is counted as a bite, a check
+ * asserts there are none. The longest time between two resets is kept to
+ * see how close the firmware came to one.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_SLEEPYDOG__H_
+#define _HOSTSIM_SLEEPYDOG__H_
+
+#include <Arduino.h>
+
+/* State of a watchdog */
+struct WatchdogState {
+  uint32_t period;        ///< ms until it bites, 0 if disabled
+  uint64_t last;          ///< µs of the last reset
+  uint64_t longest;       ///< longest µs between two resets
+  uint32_t bites;         ///< timeouts so far
+  uint8_t cause;          ///< RCAUSE returned by resetCause()
+};
+
+/* Watchdog of the SAMD21. Each object has its own state, so every monitor
+ * of a check can be given a watchdog of its own */
+class WatchdogSAMD {
+ public:
+  WatchdogSAMD() : _state() {}
+  WatchdogState& state(void) { return _state; }
+  int enable(int maxPeriodMS = 0, bool = false) {
+    _state.period = maxPeriodMS;
+    _state.last = HostSim::now();
+    return maxPeriodMS;
+  }
+  void reset(void) {
+    if (!_state.period) return;
+    uint64_t elapsed = HostSim::now() - _state.last;
+    if (elapsed > _state.longest) _state.longest = elapsed;
+    if (elapsed > _state.period * 1000ULL) _state.bites++;
+    _state.last = HostSim::now();
+  }
+  uint8_t resetCause(void) { return _state.cause; }
+  void disable(void) { _state.period = 0; }
+  int sleep(int maxPeriodMS = 0) { delay(maxPeriodMS); return maxPeriodMS; }
+
+ private:
+  WatchdogState _state;
+};
+typedef WatchdogSAMD WatchdogType;
+static WatchdogType Watchdog __attribute__((unused));
+
+#endif  // _HOSTSIM_SLEEPYDOG__H_
@@ -0,0 +1,422 @@
+/******************************************************************************
+ * 
+ * Arduino core of the host simulation.
+ * 
+ * Stands in for the core of the Feather M0 when the firmware is compiled on
+ * the host, see HostSim.h. Time is virtual: millis() and micros() only
+ * advance when the firmware waits (delay(), __WFI() at the end of a loop)
+ * or when a fake peripheral spends time on its bus. Events scheduled by a
+ * check, e.g. a level change of a pin calling its interrupt, run when the
+ * time passes them.
+ * 
+ * Only the parts of the core used by the firmware are there. All of it is
+ * inline with its state in function-local statics, so the simulation is
+ * header-only like the other tools.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_ARDUINO__H_
+#define _HOSTSIM_ARDUINO__H_
+
+// the standard headers come first, as the macros min, max and abs below
+// break them
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define FALLING 2
+#define RISING 3
+#define CHANGE 4
+#define A0 14
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define digitalPinToInterrupt(p) (p)
+#define noInterrupts() HostSim::mask(true)
+#define interrupts() HostSim::mask(false)
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define abs(x) ((x)>0?(x):-(x))
+// the MCU idles until the next interrupt, at the latest the tick of millis()
+#define __WFI() HostSim::idle()
+#define __DSB() do {} while (0)
+
+#define PINS 32   ///< pins of the simulated MCU
+
+/* Virtual time, pins and interrupts of the simulation */
+namespace HostSim {
+
+/* Event at a time of the simulation, e.g. a level change of a pin */
+struct Event {
+  uint64_t time;                ///< µs of the simulation
+  uint32_t order;               ///< events of the same time run in order
+  std::function<void()> run;
+  bool operator<(const Event& other) const {
+    return time != other.time ? time > other.time : order > other.order;
+  }
+};
+
+/* State of the simulated MCU */
+struct Core {
+  uint64_t time;                ///< µs since the start
+  uint32_t order;               ///< number of events scheduled so far
+  std::vector<Event> events;    ///< heap of the events to come
+  bool masked;                  ///< interrupts disabled
+  bool running;                 ///< in an event, no other one starts
+  uint8_t levels[PINS];         ///< level of each pin
+  uint8_t modes[PINS];          ///< mode of each pin
+  void (*handlers[PINS])(void); ///< interrupt attached to each pin
+  uint8_t triggers[PINS];       ///< FALLING, RISING or CHANGE
+};
+
+// the one simulated MCU
+inline Core& core() {
+  static Core state = Core();
+  return state;
+}
+
+// µs since the start of the simulation
+inline uint64_t now() { return core().time; }
+
+// run fn at the given µs of the simulation, or right away if it has passed
+inline void at(uint64_t time, std::function<void()> fn) {
+  Core& c = core();
+  Event event = {time, c.order++, fn};
+  c.events.push_back(event);
+  std::push_heap(c.events.begin(), c.events.end());
+}
+
+// let us µs pass, running the events due in this time
+inline void advance(uint64_t us) {
+  Core& c = core();
+  uint64_t end = c.time + us;
+  // events only start from the outermost call, the time their peripherals
+  // take is added to the time of the simulation as a whole
+  while (!c.running && !c.masked && !c.events.empty()
+         && c.events.front().time <= end) {
+    std::pop_heap(c.events.begin(), c.events.end());
+    Event event = c.events.back();
+    c.events.pop_back();
+    if (event.time > c.time) c.time = event.time;
+    // an event may throw to end the firmware at once, e.g. a power cut,
+    // the simulation goes on with the code that catches it
+    struct Running {
+      bool& running;
+      ~Running() { running = false; }
+    } guard = {c.running};
+    c.running = true;
+    event.run();
+  }
+  if (end > c.time) c.time = end;
+}
+
+// the MCU sleeps until the next interrupt or tick of millis()
+inline void idle() {
+  Core& c = core();
+  uint64_t tick = (c.time / 1000 + 1) * 1000;
+  if (!c.events.empty() && c.events.front().time < tick) {
+    tick = c.events.front().time;
+  }
+  advance(tick > c.time ? tick - c.time : 0);
+}
+
+// disable or enable interrupts, the events held back run when enabled
+inline void mask(bool masked) {
+  core().masked = masked;
+  if (!masked) advance(0);
+}
+
+// drive a pin from outside, calls its interrupt on a matching edge
+inline void setPin(uint8_t pin, uint8_t level) {
+  Core& c = core();
+  if (pin >= PINS) return;
+  uint8_t old = c.levels[pin];
+  c.levels[pin] = level;
+  if (old == level || !c.handlers[pin]) return;
+  uint8_t trigger = c.triggers[pin];
+  if (trigger == CHANGE || (trigger == RISING && level)
+      || (trigger == FALLING && !level)) {
+    c.handlers[pin]();
+  }
+}
+
+// back to time 0 without events and interrupts, all pins high
+inline void reset() {
+  Core& c = core();
+  c = Core();
+  for (uint8_t i = 0; i < PINS; i++) c.levels[i] = HIGH;
+}
+
+}  // namespace HostSim
+
+inline unsigned long millis(void) { return HostSim::now() / 1000; }
+inline unsigned long micros(void) { return HostSim::now(); }
+inline void delay(unsigned long ms) { HostSim::advance(ms * 1000ULL); }
+inline void delayMicroseconds(unsigned int us) { HostSim::advance(us); }
+inline void yield(void) {}
+
+inline int digitalRead(uint8_t pin) {
+  return pin < PINS ? HostSim::core().levels[pin] : LOW;
+}
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+  if (pin < PINS && HostSim::core().modes[pin] == OUTPUT) {
+    HostSim::core().levels[pin] = level ? HIGH : LOW;
+  }
+}
+inline void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < PINS) HostSim::core().modes[pin] = mode;
+}
+inline void attachInterrupt(uint32_t pin, void (*handler)(void),
+                            uint32_t mode) {
+  if (pin >= PINS) return;
+  HostSim::core().handlers[pin] = handler;
+  HostSim::core().triggers[pin] = mode;
+}
+inline void detachInterrupt(uint32_t pin) {
+  if (pin < PINS) HostSim::core().handlers[pin] = NULL;
+}
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+
+/* String of the Arduino core on a std::string */
+class String {
+ public:
+  String(const char* s = "") : _s(s ? s : "") {}
+  String(const String& other) = default;
+  String& operator=(const String& other) = default;
+  explicit String(char c) : _s(1, c) {}
+  explicit String(unsigned char value, unsigned char base = 10)
+      : _s(number(value, base)) {}
+  explicit String(int value, unsigned char base = 10)
+      : _s(number(value, base)) {}
+  explicit String(unsigned int value, unsigned char base = 10)
+      : _s(number(value, base)) {}
+  explicit String(long value, unsigned char base = 10)
+      : _s(number(value, base)) {}
+  explicit String(unsigned long value, unsigned char base = 10)
+      : _s(number(value, base)) {}
+  explicit String(float value, unsigned char decimals = 2)
+      : _s(decimal(value, decimals)) {}
+  explicit String(double value, unsigned char decimals = 2)
+      : _s(decimal(value, decimals)) {}
+
+  unsigned int length() const { return _s.size(); }
+  char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char& operator[](unsigned int i) { return _s[i]; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+  const char* c_str() const { return _s.c_str(); }
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+
+  String substring(unsigned int begin) const {
+    return begin < _s.size() ? String(_s.substr(begin).c_str()) : String();
+  }
+  String substring(unsigned int begin, unsigned int end) const {
+    if (end > _s.size()) end = _s.size();
+    if (begin >= end) return String();
+    return String(_s.substr(begin, end - begin).c_str());
+  }
+  int indexOf(char c) const { return found(_s.find(c)); }
+  int indexOf(const String& s) const { return found(_s.find(s._s)); }
+  int lastIndexOf(char c) const { return found(_s.rfind(c)); }
+  bool startsWith(const String& s) const { return _s.find(s._s) == 0; }
+  bool endsWith(const String& s) const {
+    return _s.size() >= s._s.size()
+           && _s.compare(_s.size() - s._s.size(), s._s.size(), s._s) == 0;
+  }
+  bool equals(const String& s) const { return _s == s._s; }
+  bool equalsIgnoreCase(const String& s) const {
+    return strcasecmp(c_str(), s.c_str()) == 0;
+  }
+  void replace(const String& from, const String& to) {
+    if (!from.length()) return;
+    for (size_t i = _s.find(from._s); i != std::string::npos;
+         i = _s.find(from._s, i + to._s.size())) {
+      _s.replace(i, from._s.size(), to._s);
+    }
+  }
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return atof(c_str()); }
+  void trim() {
+    size_t begin = _s.find_first_not_of(" \t\r\n");
+    size_t end = _s.find_last_not_of(" \t\r\n");
+    _s = begin == std::string::npos ? "" : _s.substr(begin, end - begin + 1);
+  }
+  void toLowerCase() { for (char& c : _s) c = tolower(c); }
+  void toUpperCase() { for (char& c : _s) c = toupper(c); }
+
+  String& operator+=(const String& s) { _s += s._s; return *this; }
+  String& operator+=(const char* s) { _s += s; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  String& operator+=(int value) { return *this += String(value); }
+  String& operator+=(unsigned int value) { return *this += String(value); }
+  String& operator+=(long value) { return *this += String(value); }
+  String& operator+=(unsigned long value) { return *this += String(value); }
+  bool operator==(const String& s) const { return _s == s._s; }
+  bool operator!=(const String& s) const { return _s != s._s; }
+  bool operator==(const char* s) const { return _s == s; }
+
+ private:
+  static std::string number(unsigned long value, bool negative,
+                            unsigned char base) {
+    std::string digits;
+    do {
+      digits.insert(digits.begin(), "0123456789abcdef"[value % base]);
+      value /= base;
+    } while (value);
+    return negative ? "-" + digits : digits;
+  }
+  static std::string number(long value, unsigned char base) {
+    // negative numbers only have a sign in decimal, like the core
+    if (base == 10 && value < 0) {
+      return number(-(unsigned long) value, true, 10);
+    }
+    return number((unsigned long) value, false, base);
+  }
+  static std::string number(int value, unsigned char base) {
+    if (base == 10) return number((long) value, base);
+    return number((unsigned long) (unsigned int) value, false, base);
+  }
+  static std::string number(unsigned long value, unsigned char base) {
+    return number(value, false, base);
+  }
+  static std::string number(unsigned int value, unsigned char base) {
+    return number((unsigned long) value, false, base);
+  }
+  static std::string number(unsigned char value, unsigned char base) {
+    return number((unsigned long) value, false, base);
+  }
+  static std::string decimal(double value, unsigned char decimals) {
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", decimals, value);
+    return text;
+  }
+  static int found(size_t i) { return i == std::string::npos ? -1 : (int) i; }
+
+  std::string _s;
+};
+
+inline String operator+(const String& a, const String& b) {
+  String s(a); s += b; return s;
+}
+inline String operator+(const String& a, const char* b) {
+  String s(a); s += b; return s;
+}
+inline String operator+(const char* a, const String& b) {
+  String s(a); s += b; return s;
+}
+inline String operator+(const String& a, char b) {
+  String s(a); s += b; return s;
+}
+inline String operator+(const String& a, int b) { return a + String(b); }
+inline String operator+(const String& a, unsigned int b) {
+  return a + String(b);
+}
+inline String operator+(const String& a, long b) { return a + String(b); }
+inline String operator+(const String& a, unsigned long b) {
+  return a + String(b);
+}
+
+/* Print of the Arduino core, writing single bytes by default */
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size-- && write(*buffer++)) n++;
+    return n;
+  }
+  size_t write(const char* s) { return s ? write(s, strlen(s)) : 0; }
+  size_t write(const char* buffer, size_t size) {
+    return write((const uint8_t*) buffer, size);
+  }
+  virtual void flush() {}
+
+  size_t print(const String& s) { return write(s.c_str(), s.length()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(const __FlashStringHelper* s) { return write((const char*) s); }
+  size_t print(char c) { return write((uint8_t) c); }
+  size_t print(int value, int base = DEC) { return print(String(value, base)); }
+  size_t print(unsigned int value, int base = DEC) {
+    return print(String(value, base));
+  }
+  size_t print(long value, int base = DEC) {
+    return print(String(value, base));
+  }
+  size_t print(unsigned long value, int base = DEC) {
+    return print(String(value, base));
+  }
+  size_t print(double value, int decimals = 2) {
+    return print(String(value, decimals));
+  }
+  size_t println(void) { return write("\r\n"); }
+  template <class T>
+  size_t println(const T& value) { return print(value) + println(); }
+  template <class T>
+  size_t println(const T& value, int format) {
+    return print(value, format) + println();
+  }
+  size_t printf(const char* format, ...)
+      __attribute__((format(printf, 2, 3))) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return write(text);
+  }
+};
+
+/* Stream of the Arduino core */
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+/* Serial port writing to stderr of the host */
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fputc(c, stderr) != EOF; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  operator bool() { return true; }
+};
+static HardwareSerial Serial __attribute__((unused));
+
+#endif  // _HOSTSIM_ARDUINO__H_
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * 
+ * DateTime and DS3231 of RTClib in the host simulation, see HostSim.h.
+ * 
+ * DateTime and TimeSpan behave like those of RTClib. The fake RTC counts
+ * seconds from the time it was set to on the virtual time of the
+ * simulation, faster or slower by ppm like a real crystal. Each read costs
+ * an I2C transfer.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_RTCLIB__H_
+#define _HOSTSIM_RTCLIB__H_
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SECONDS_FROM_1970_TO_2000 946684800
+#define SECONDS_PER_DAY 86400L
+
+/* Span of time in seconds */
+class TimeSpan {
+ public:
+  TimeSpan(int32_t seconds = 0) : _seconds(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+      : _seconds(days * SECONDS_PER_DAY + hours * 3600L + minutes * 60L
+                 + seconds) {}
+  int16_t days() const { return _seconds / SECONDS_PER_DAY; }
+  int8_t hours() const { return _seconds / 3600 % 24; }
+  int8_t minutes() const { return _seconds / 60 % 60; }
+  int8_t seconds() const { return _seconds % 60; }
+  int32_t totalseconds() const { return _seconds; }
+  TimeSpan operator+(const TimeSpan& right) const {
+    return TimeSpan(_seconds + right._seconds);
+  }
+  TimeSpan operator-(const TimeSpan& right) const {
+    return TimeSpan(_seconds - right._seconds);
+  }
+
+ private:
+  int32_t _seconds;
+};
+
+/* Date and time from 2000 to 2099 */
+class DateTime {
+ public:
+  DateTime(uint32_t t = SECONDS_FROM_1970_TO_2000) {
+    t -= SECONDS_FROM_1970_TO_2000;
+    _ss = t % 60; t /= 60;
+    _mm = t % 60; t /= 60;
+    _hh = t % 24;
+    uint16_t days = t / 24;
+    uint8_t leap;
+    for (_yOff = 0;; _yOff++) {
+      leap = _yOff % 4 == 0;
+      if (days < 365U + leap) break;
+      days -= 365 + leap;
+    }
+    for (_m = 1; _m < 12; _m++) {
+      uint8_t length = daysInMonth(_m, leap);
+      if (days < length) break;
+      days -= length;
+    }
+    _d = days + 1;
+  }
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0,
+           uint8_t min = 0, uint8_t sec = 0)
+      : _yOff(year >= 2000 ? year - 2000 : year), _m(month), _d(day),
+        _hh(hour), _mm(min), _ss(sec) {}
+  DateTime(const DateTime& copy) = default;
+  DateTime& operator=(const DateTime&) = default;
+
+  uint16_t year() const { return 2000 + _yOff; }
+  uint8_t month() const { return _m; }
+  uint8_t day() const { return _d; }
+  uint8_t hour() const { return _hh; }
+  uint8_t minute() const { return _mm; }
+  uint8_t second() const { return _ss; }
+  // 0 is Sunday, 1/1/2000 was a Saturday
+  uint8_t dayOfTheWeek() const { return (days() + 6) % 7; }
+  uint32_t secondstime() const {
+    return ((days() * 24UL + _hh) * 60 + _mm) * 60 + _ss;
+  }
+  uint32_t unixtime(void) const {
+    return secondstime() + SECONDS_FROM_1970_TO_2000;
+  }
+
+  DateTime operator+(const TimeSpan& span) const {
+    return DateTime(unixtime() + span.totalseconds());
+  }
+  DateTime operator-(const TimeSpan& span) const {
+    return DateTime(unixtime() - span.totalseconds());
+  }
+  TimeSpan operator-(const DateTime& right) const {
+    return TimeSpan((int32_t) (unixtime() - right.unixtime()));
+  }
+  bool operator<(const DateTime& right) const {
+    return unixtime() < right.unixtime();
+  }
+  bool operator>(const DateTime& right) const { return right < *this; }
+  bool operator<=(const DateTime& right) const { return !(right < *this); }
+  bool operator>=(const DateTime& right) const { return !(*this < right); }
+  bool operator==(const DateTime& right) const {
+    return unixtime() == right.unixtime();
+  }
+  bool operator!=(const DateTime& right) const { return !(*this == right); }
+
+ private:
+  static uint8_t daysInMonth(uint8_t month, bool leap) {
+    static const uint8_t DAYS[12] = {31, 28, 31, 30, 31, 30,
+                                     31, 31, 30, 31, 30, 31};
+    return DAYS[month - 1] + (month == 2 && leap);
+  }
+  // days since 1/1/2000
+  uint16_t days() const {
+    uint16_t days = _d - 1;
+    for (uint8_t m = 1; m < _m; m++) days += daysInMonth(m, _yOff % 4 == 0);
+    return days + 365 * _yOff + (_yOff + 3) / 4;
+  }
+
+  uint8_t _yOff, _m, _d, _hh, _mm, _ss;
+};
+
+enum Ds3231SqwPinMode { DS3231_OFF = 0x1C, DS3231_SquareWave1Hz = 0x00 };
+
+/* DS3231 counting on the virtual time */
+class RTC_DS3231 {
+ public:
+  RTC_DS3231()
+      : ppm(0), powerLost(false), _setTime(SECONDS_FROM_1970_TO_2000),
+        _setAt(0), _sqw(DS3231_OFF) {}
+  bool begin(TwoWire* = nullptr) { return true; }
+  // set the time, the countdown of the second starts anew like on the chip
+  void adjust(const DateTime& dt) {
+    HostSim::advance(I2C_TRANSFER_US);
+    _setTime = dt.unixtime();
+    _setAt = HostSim::now();
+    powerLost = false;
+  }
+  bool lostPower(void) { HostSim::advance(I2C_TRANSFER_US); return powerLost; }
+  DateTime now() {
+    HostSim::advance(I2C_TRANSFER_US);
+    double elapsed = (HostSim::now() - _setAt) * (1 + ppm * 1e-6);
+    return DateTime(_setTime + (uint32_t) (elapsed / 1e6));
+  }
+  Ds3231SqwPinMode readSqwPinMode() { return _sqw; }
+  void writeSqwPinMode(Ds3231SqwPinMode mode) { _sqw = mode; }
+  float getTemperature() { return 21.0f; }
+
+  /* Simulation */
+  double ppm;             ///< rate of the crystal against the virtual time
+  bool powerLost;         ///< as reported by lostPower() until adjusted
+
+ private:
+  uint32_t _setTime;      ///< unix time set by adjust()
+  uint64_t _setAt;        ///< µs of the simulation it was set at
+  Ds3231SqwPinMode _sqw;  ///< mode of the SQW pin
+};
+
+#endif  // _HOSTSIM_RTCLIB__H_
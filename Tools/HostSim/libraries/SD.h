@@ -0,0 +1,426 @@
+/******************************************************************************
+ * 
+ * SD library of the host simulation, see HostSim.h.
+ * 
+ * A FakeCard holds the files and directories of a card in memory. Cards are
+ * put into and taken out of the slot of a CS pin of an SDClass at any time,
+ * so a check can remove a card while it is written. Like the stock library
+ * one card is mounted by begin() at a time, files and directories of a
+ * card taken out can not be read or written any more.
+ * 
+ * Paths are case insensitive like FAT, names are reported in upper case.
+ * Each sector read or written, each directory of a path walked and each
+ * mount cost virtual time, roughly that of a card on SPI at 4 MHz. Writes
+ * can be torn: an event throwing in the time of a sector, see Arduino.h,
+ * ends the write after half of that sector.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_SD__H_
+#define _HOSTSIM_SD__H_
+
+#include <Arduino.h>
+#include <dirent.h>
+
+#define O_READ 0x01
+#define O_RDONLY O_READ
+#define O_WRITE 0x02
+#define O_WRONLY O_WRITE
+#define O_RDWR (O_READ | O_WRITE)
+#define O_APPEND 0x04
+#define O_SYNC 0x08
+#define O_CREAT 0x10
+#define O_EXCL 0x20
+#define O_TRUNC 0x40
+#define FILE_READ O_READ
+#define FILE_WRITE (O_READ | O_WRITE | O_CREAT | O_APPEND)
+
+#define SD_SECTOR_US    1000      ///< µs to read or write a sector
+#define SD_MOUNT_US     50000     ///< µs to initialize a card
+#define SD_TIMEOUT_US   2000000   ///< µs until begin() gives up without card
+
+/* Files and directories of a card */
+struct FakeCard {
+  FakeCard()
+      : slots(0), failing(false), sectorReads(0), sectorWrites(0),
+        entryReads(0) {}
+
+  // path as key, upper case without leading or trailing '/'
+  static std::string key(const char* path) {
+    std::string k;
+    for (const char* c = path; *c; c++) {
+      if (*c == '/' && (k.empty() || k.back() == '/')) continue;
+      k += toupper(*c);
+    }
+    if (!k.empty() && k.back() == '/') k.pop_back();
+    return k;
+  }
+  // directory the path is in, "" for the root
+  static std::string parent(const std::string& k) {
+    size_t slash = k.rfind('/');
+    return slash == std::string::npos ? "" : k.substr(0, slash);
+  }
+  bool isDirectory(const std::string& k) const {
+    return k.empty() || directories.count(k);
+  }
+
+  // content of a file, empty if there is none
+  std::string text(const char* path) const {
+    std::map<std::string, std::vector<uint8_t>>::const_iterator file =
+      files.find(key(path));
+    if (file == files.end()) return "";
+    return std::string(file->second.begin(), file->second.end());
+  }
+  // put a file onto the card, creating its directories
+  void put(const char* path, const std::string& content) {
+    std::string k = key(path);
+    for (std::string d = parent(k); !d.empty(); d = parent(d)) {
+      directories.insert(d);
+    }
+    files[k].assign(content.begin(), content.end());
+  }
+  // copy the files of a directory of the host into the root of the card
+  bool load(const char* directory) {
+    DIR* dir = opendir(directory);
+    if (!dir) return false;
+    while (struct dirent* entry = readdir(dir)) {
+      if (entry->d_type != DT_REG) continue;
+      std::string path = std::string(directory) + "/" + entry->d_name;
+      FILE* file = fopen(path.c_str(), "rb");
+      if (!file) continue;
+      std::string content;
+      char buffer[4096];
+      size_t n;
+      while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, n);
+      }
+      fclose(file);
+      put(entry->d_name, content);
+    }
+    closedir(dir);
+    return true;
+  }
+
+  std::map<std::string, std::vector<uint8_t>> files;
+  std::set<std::string> directories;  ///< all but the root
+  uint8_t slots;            ///< slots the card is in, 0 if taken out
+  bool failing;             ///< every write fails, e.g. a worn card
+  uint32_t sectorReads;     ///< sectors read so far
+  uint32_t sectorWrites;    ///< sectors written so far
+  uint32_t entryReads;      ///< directory entries read by openNextFile()
+  // entries removed from each directory. FAT keeps them as free slots,
+  // which new entries take first and openNextFile() reads over, before the
+  // others as files are mostly removed in the order they were created
+  std::map<std::string, uint32_t> removed;
+};
+
+namespace SDLib {
+
+/* An open file or directory shared by the copies of a File */
+struct FileState {
+  FakeCard* card;
+  std::string key;          ///< path on the card
+  uint8_t mode;             ///< O_ flags it was opened with
+  uint32_t position;        ///< of the next byte read or written
+  int32_t cached;           ///< sector in the cache of the library
+  bool written;             ///< the directory entry is updated on close
+  std::vector<std::string> entries; ///< of a directory, in order
+  size_t next;              ///< entry openNextFile() returns
+};
+
+/* File of the SD library */
+class File : public Stream {
+ public:
+  File() {}
+  File(FakeCard* card, const std::string& key, uint8_t mode)
+      : _state(new FileState()) {
+    _state->card = card;
+    _state->key = key;
+    _state->mode = mode;
+    _state->position = 0;
+    _state->cached = -1;
+    _state->written = false;
+    _state->next = 0;
+    if (card->isDirectory(key)) {
+      std::string prefix = key.empty() ? "" : key + "/";
+      std::set<std::string> names;
+      for (const std::string& d : card->directories) {
+        if (FakeCard::parent(d) == key) names.insert(d);
+      }
+      for (const auto& f : card->files) {
+        if (FakeCard::parent(f.first) == key) names.insert(f.first);
+      }
+      _state->entries.assign(names.begin(), names.end());
+    } else if (mode & O_APPEND) {
+      _state->position = size();
+    }
+  }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  // sector by sector, each in two halves with the time of the sector in
+  // between, so a power cut or the card taken out leaves a torn write
+  size_t write(const uint8_t* buffer, size_t size) override {
+    std::vector<uint8_t>* data = content();
+    if (!data || !(_state->mode & O_WRITE) || _state->card->failing) return 0;
+    uint32_t& position = _state->position;
+    if (_state->mode & O_APPEND) position = data->size();
+    size_t done = 0;
+    while (done < size) {
+      uint32_t sector = position / SECTOR_BYTES;
+      uint32_t end = min((uint32_t) (position + size - done),
+                         (sector + 1) * SECTOR_BYTES);
+      uint32_t half = max(position, sector * SECTOR_BYTES + SECTOR_BYTES / 2);
+      for (uint8_t part = 0; part < 2; part++) {
+        uint32_t stop = part ? end : min(half, end);
+        if (!(data = content())) return done;
+        if (stop > data->size()) data->resize(stop);
+        std::copy(buffer + done, buffer + done + (stop - position),
+                  data->begin() + position);
+        done += stop - position;
+        position = stop;
+        _state->written = true;
+        HostSim::advance(SD_SECTOR_US / 2);
+      }
+      _state->cached = sector;
+      _state->card->sectorWrites++;
+    }
+    return size;
+  }
+  using Print::write;
+  int availableForWrite() { return SECTOR_BYTES; }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  int peek() override {
+    std::vector<uint8_t>* data = content();
+    if (!data || _state->position >= data->size()) return -1;
+    return (*data)[_state->position];
+  }
+  int available() override {
+    std::vector<uint8_t>* data = content();
+    return data ? data->size() - _state->position : 0;
+  }
+  void flush() override {}
+  int read(void* buffer, uint16_t size) {
+    std::vector<uint8_t>* data = content();
+    if (!data || !(_state->mode & O_READ)) return -1;
+    uint32_t& position = _state->position;
+    if (position >= data->size()) return 0;
+    uint32_t n = min((uint32_t) size, (uint32_t) data->size() - position);
+    memcpy(buffer, data->data() + position, n);
+    access(position, n);
+    position += n;
+    return n;
+  }
+  bool seek(uint32_t position) {
+    std::vector<uint8_t>* data = content();
+    if (!data || position > data->size()) return false;
+    _state->position = position;
+    return true;
+  }
+  uint32_t position() { return _state ? _state->position : 0; }
+  uint32_t size() {
+    std::vector<uint8_t>* data = content();
+    return data ? data->size() : 0;
+  }
+  void close() {
+    if (_state && _state->written && present()) {
+      // the size in the directory entry
+      HostSim::advance(SD_SECTOR_US);
+      _state->card->sectorWrites++;
+    }
+    _state.reset();
+  }
+  operator bool() { return _state && present(); }
+  char* name() {
+    if (!_state) return NULL;
+    size_t slash = _state->key.rfind('/');
+    _name = slash == std::string::npos ? _state->key
+                                       : _state->key.substr(slash + 1);
+    return &_name[0];
+  }
+  bool isDirectory(void) {
+    return _state && _state->card->isDirectory(_state->key);
+  }
+  File openNextFile(uint8_t mode = O_RDONLY) {
+    if (!isDirectory() || !present()) return File();
+    if (_state->next == 0) {
+      uint32_t slots = _state->card->removed[_state->key];
+      _state->card->entryReads += slots;
+      HostSim::advance(slots * SD_SECTOR_US / 16);
+    }
+    while (_state->next < _state->entries.size()) {
+      const std::string& key = _state->entries[_state->next++];
+      // entries removed since the directory was opened are skipped
+      FakeCard* card = _state->card;
+      card->entryReads++;
+      if (card->files.count(key) || card->directories.count(key)) {
+        HostSim::advance(SD_SECTOR_US / 16);
+        return File(_state->card, key, mode);
+      }
+    }
+    return File();
+  }
+  void rewindDirectory(void) { if (_state) _state->next = 0; }
+
+ private:
+  static const uint16_t SECTOR_BYTES = 512;
+
+  bool present(void) const { return _state->card->slots > 0; }
+  // content of the file, NULL if it is not open or the card was taken out
+  std::vector<uint8_t>* content(void) {
+    if (!_state || !present()) return NULL;
+    std::map<std::string, std::vector<uint8_t>>::iterator file =
+      _state->card->files.find(_state->key);
+    return file == _state->card->files.end() ? NULL : &file->second;
+  }
+  // time of the sectors read, but the one in the cache
+  void access(uint32_t position, uint32_t size) {
+    if (!size) return;
+    int32_t first = position / SECTOR_BYTES;
+    int32_t last = (position + size - 1) / SECTOR_BYTES;
+    uint32_t sectors = last - first + 1;
+    if (first == _state->cached) sectors--;
+    _state->cached = last;
+    HostSim::advance((uint64_t) sectors * SD_SECTOR_US);
+    _state->card->sectorReads += sectors;
+  }
+
+  std::shared_ptr<FileState> _state;
+  std::string _name;        ///< returned by name()
+};
+
+/* SD library with a card in the slot of each CS pin */
+class SDClass {
+ public:
+  SDClass() : _mounted(NULL) {}
+
+  // put a card into the slot of a CS pin, NULL takes the card out
+  void insert(uint8_t csPin, FakeCard* card) {
+    FakeCard*& slot = _slots[csPin];
+    if (slot) slot->slots--;
+    slot = card;
+    if (card) card->slots++;
+  }
+  FakeCard* card(uint8_t csPin) { return _slots[csPin]; }
+
+  bool begin(uint8_t csPin = 10) {
+    FakeCard* card = _slots[csPin];
+    HostSim::advance(card ? SD_MOUNT_US : SD_TIMEOUT_US);
+    _mounted = card;
+    _pin = csPin;
+    return card != NULL;
+  }
+  bool begin(uint32_t, uint8_t csPin) { return begin(csPin); }
+  void end() { _mounted = NULL; }
+
+  File open(const char* filename, uint8_t mode = FILE_READ) {
+    FakeCard* card = mounted();
+    if (!card) return File();
+    std::string key = FakeCard::key(filename);
+    walk(key);
+    bool exists = card->files.count(key) || card->isDirectory(key);
+    if (!exists) {
+      if (!(mode & O_CREAT) || !card->isDirectory(FakeCard::parent(key))) {
+        return File();
+      }
+      card->files[key];
+      reuse(card, key);
+    } else if (mode & O_EXCL) {
+      return File();
+    }
+    if ((mode & O_TRUNC) && card->files.count(key)) card->files[key].clear();
+    return File(card, key, mode);
+  }
+  File open(const String& filename, uint8_t mode = FILE_READ) {
+    return open(filename.c_str(), mode);
+  }
+  bool exists(const char* filepath) {
+    FakeCard* card = mounted();
+    if (!card) return false;
+    std::string key = FakeCard::key(filepath);
+    walk(key);
+    return card->files.count(key) || card->isDirectory(key);
+  }
+  bool exists(const String& filepath) { return exists(filepath.c_str()); }
+  // creates the directories along the path as well
+  bool mkdir(const char* filepath) {
+    FakeCard* card = mounted();
+    if (!card || card->failing) return false;
+    std::string key = FakeCard::key(filepath);
+    walk(key);
+    for (std::string d = key; !d.empty(); d = FakeCard::parent(d)) {
+      if (card->files.count(d)) return false;
+      if (card->directories.insert(d).second) {
+        reuse(card, d);
+        HostSim::advance(2 * SD_SECTOR_US);
+        card->sectorWrites += 2;
+      }
+    }
+    return true;
+  }
+  bool mkdir(const String& filepath) { return mkdir(filepath.c_str()); }
+  bool remove(const char* filepath) {
+    FakeCard* card = mounted();
+    if (!card || card->failing) return false;
+    walk(FakeCard::key(filepath));
+    HostSim::advance(SD_SECTOR_US);
+    std::string key = FakeCard::key(filepath);
+    if (!card->files.erase(key)) return false;
+    card->removed[FakeCard::parent(key)]++;
+    return true;
+  }
+  bool remove(const String& filepath) { return remove(filepath.c_str()); }
+  bool rmdir(const char* filepath) {
+    FakeCard* card = mounted();
+    std::string key = FakeCard::key(filepath);
+    if (!card || card->failing || !card->directories.count(key)) return false;
+    for (const auto& f : card->files) {
+      if (FakeCard::parent(f.first) == key) return false;
+    }
+    for (const std::string& d : card->directories) {
+      if (FakeCard::parent(d) == key) return false;
+    }
+    card->directories.erase(key);
+    return true;
+  }
+  bool rmdir(const String& filepath) { return rmdir(filepath.c_str()); }
+
+ private:
+  // the card mounted, NULL if none or it was taken out since
+  FakeCard* mounted(void) {
+    return _mounted && _slots[_pin] == _mounted ? _mounted : NULL;
+  }
+  // a new entry takes the slot of a removed one if there is one
+  static void reuse(FakeCard* card, const std::string& key) {
+    uint32_t& slots = card->removed[FakeCard::parent(key)];
+    if (slots) slots--;
+  }
+  // time to read the directories along a path
+  void walk(const std::string& key) {
+    uint32_t depth = 1 + std::count(key.begin(), key.end(), '/');
+    HostSim::advance(depth * SD_SECTOR_US);
+    _mounted->sectorReads += depth;
+  }
+
+  std::map<uint8_t, FakeCard*> _slots;
+  FakeCard* _mounted;       ///< card of the last successful begin()
+  uint8_t _pin;             ///< its slot
+};
+
+// each file of the host has its own, the firmware only uses the default
+// argument of bmpReader and takes the one given to it
+static SDClass SD __attribute__((unused));
+
+}  // namespace SDLib
+
+using namespace SDLib;
+
+#endif  // _HOSTSIM_SD__H_
@@ -0,0 +1,19 @@
+/******************************************************************************
+ * 
+ * SPI bus of the host simulation, see HostSim.h. The fake display and the
+ * fake SD cards account for the time of their transfers themselves.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_SPI__H_
+#define _HOSTSIM_SPI__H_
+
+#include <Arduino.h>
+
+#endif  // _HOSTSIM_SPI__H_
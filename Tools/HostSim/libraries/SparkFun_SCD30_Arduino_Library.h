@@ -0,0 +1,88 @@
+/******************************************************************************
+ * 
+ * SCD30 CO2 sensor of the host simulation, see HostSim.h.
+ * 
+ * Measures every interval seconds like the sensor, the first measurement
+ * is ready one interval after begin(). The values are those of the public
+ * members when the measurement is taken; a check sets them, or gives a
+ * function measure() setting them at each measurement. Each request costs
+ * an I2C transfer.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_SCD30__H_
+#define _HOSTSIM_SCD30__H_
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/* SCD30 measuring on the virtual time */
+class SCD30 {
+ public:
+  SCD30()
+      : co2(420), temperature(21), humidity(45), interval(2),
+        measurements(0), calibrations(0), calibration(0), _next(0),
+        _started(false), _co2(0), _temperature(0), _humidity(0) {}
+  bool begin(bool autoCalibrate) { return begin(Wire, autoCalibrate); }
+  bool begin(TwoWire& = Wire, bool = false, bool = true) {
+    HostSim::advance(I2C_TRANSFER_US);
+    _next = HostSim::now() + interval * 1000000ULL;
+    _started = true;
+    return true;
+  }
+  bool dataAvailable() {
+    HostSim::advance(I2C_TRANSFER_US);
+    return _started && HostSim::now() >= _next;
+  }
+  bool readMeasurement() {
+    if (!dataAvailable()) return false;
+    HostSim::advance(I2C_TRANSFER_US);
+    if (measure) measure(*this);
+    _co2 = co2;
+    _temperature = temperature;
+    _humidity = humidity;
+    measurements++;
+    // the next one is due at the next multiple of the interval
+    uint64_t period = interval * 1000000ULL;
+    while (_next <= HostSim::now()) _next += period;
+    return true;
+  }
+  uint16_t getCO2(void) { readMeasurement(); return lroundf(_co2); }
+  float getHumidity(void) { return _humidity; }
+  float getTemperature(void) { return _temperature; }
+  bool setAutoSelfCalibration(bool) { return command(); }
+  bool setAltitudeCompensation(uint16_t) { return command(); }
+  bool setTemperatureOffset(float) { return command(); }
+  bool setForcedRecalibrationFactor(uint16_t concentration) {
+    calibrations++;
+    calibration = concentration;
+    return command();
+  }
+  bool setMeasurementInterval(uint16_t seconds) {
+    interval = seconds;
+    return command();
+  }
+
+  /* Simulation */
+  float co2, temperature, humidity;   ///< values of the next measurement
+  std::function<void(SCD30&)> measure; ///< sets them, called at each one
+  uint16_t interval;          ///< s between two measurements
+  uint32_t measurements;      ///< measurements read so far
+  uint16_t calibrations;      ///< forced recalibrations so far
+  uint16_t calibration;       ///< concentration of the last one
+
+ private:
+  bool command(void) { HostSim::advance(I2C_TRANSFER_US); return true; }
+
+  uint64_t _next;             ///< µs the next measurement is ready
+  bool _started;              ///< begin() was called
+  float _co2, _temperature, _humidity;  ///< values read last
+};
+
+#endif  // _HOSTSIM_SCD30__H_
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * 
+ * I2C bus of the host simulation, see HostSim.h.
+ * 
+ * The fake peripherals on the bus answer directly, a transfer only costs
+ * the virtual time given by I2C_TRANSFER_US.
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#ifndef _HOSTSIM_WIRE__H_
+#define _HOSTSIM_WIRE__H_
+
+#include <Arduino.h>
+
+#define I2C_TRANSFER_US 400   ///< µs of a read of a few bytes at 100 kHz
+
+/* I2C bus */
+class TwoWire {
+ public:
+  void begin(void) {}
+  void setClock(uint32_t) {}
+};
+static TwoWire Wire __attribute__((unused));
+
+#endif  // _HOSTSIM_WIRE__H_
@@ -0,0 +1,511 @@
+/******************************************************************************
+ * 
+ * Convert images to the native RGB565 raw format of the firmware.
+ * 
+ * Host program that reads a BMP (1, 4, 8, 24 or 32 bit, uncompressed) or a
+ * PNG (non-interlaced, any color type, 8 bit per channel or palettized) and
+ * writes it as RGB565 raw image, which bmpReader streams to the display
+ * without any conversion. Transparent pixels are blended onto a background
+ * color, white by default.
+ * 
+ * Format (all values little endian, see also bmpDraw.h):
+ *  char     magic[4]     "R565"
+ *  uint16_t width
+ *  uint16_t height
+ *  uint8_t  flags        bit 0: rows are run length encoded
+ *  uint8_t  reserved[3]
+ *  followed by the rows from top to bottom, each pixel as RGB565 in big
+ *  endian byte order, i.e. in the order the display expects. Run length
+ *  encoded rows consist of packets starting with a control byte c: if bit 7
+ *  is set, the next pixel is repeated (c & 0x7F) + 1 times, otherwise
+ *  c + 1 pixels follow literally. Packets never span two rows.
+ * 
+ * Usage:
+ *  ImageConv [-r] [-b RRGGBB] input.bmp|input.png output.565
+ *    -r          run length encode the rows
+ *    -b RRGGBB   background color for transparent pixels in hex
+ * 
+ * Build from the repository root:
+ *  g++ -O2 -o imageconv Tools/ImageConv/ImageConv.cpp
+ * 
+ * created        16.10.2026
+ * last modified  16.10.2026
+ * for            Laboratory for Sensors,
+ *                IMTEK - Department of Microsystems Engineering,
+ *                University of Freiburg
+ * 
+******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/* Image in memory, 8 bit per channel */
+struct Image {
+  int width = 0, height = 0;
+  std::vector<uint8_t> rgba;    ///< 4 bytes per pixel, rows top to bottom
+};
+
+// ____________________________________________________________________________
+static bool readFile(const char* filename, std::vector<uint8_t>* data) {
+  FILE* f = fopen(filename, "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data->insert(data->end(), buf, buf + n);
+  }
+  fclose(f);
+  return true;
+}
+
+// ____________________________________________________________________________
+static uint32_t le32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+static uint16_t le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static uint32_t be32(const uint8_t* p) {
+  return ((uint32_t) p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+/******************************************************************************
+    BMP
+******************************************************************************/
+
+// ____________________________________________________________________________
+static bool loadBmp(const std::vector<uint8_t>& d, Image* img) {
+  if (d.size() < 54 || d[0] != 'B' || d[1] != 'M') return false;
+  uint32_t offset = le32(&d[10]);
+  uint32_t headerSize = le32(&d[14]);
+  int32_t w = (int32_t) le32(&d[18]);
+  int32_t h = (int32_t) le32(&d[22]);
+  uint16_t depth = le16(&d[28]);
+  uint32_t compression = le32(&d[30]);
+  uint32_t colors = le32(&d[46]);
+  if (compression != 0) {
+    fprintf(stderr, "compressed BMP files are not supported\n");
+    return false;
+  }
+  if (depth != 1 && depth != 4 && depth != 8 && depth != 24 && depth != 32) {
+    fprintf(stderr, "BMP depth %d is not supported\n", depth);
+    return false;
+  }
+  bool flip = h > 0;    // stored bottom to top
+  if (h < 0) h = -h;
+  if (depth <= 8 && colors == 0) colors = 1 << depth;
+  const uint8_t* palette = &d[14 + headerSize];
+  uint32_t rowSize = ((w * depth + 31) / 32) * 4;
+  if (offset + rowSize * h > d.size()) return false;
+
+  img->width = w;
+  img->height = h;
+  img->rgba.resize(w * h * 4);
+  for (int y = 0; y < h; y++) {
+    const uint8_t* row = &d[offset + rowSize * (flip ? h - 1 - y : y)];
+    for (int x = 0; x < w; x++) {
+      uint8_t* p = &img->rgba[(y*w + x) * 4];
+      if (depth <= 8) {
+        int bit = x * depth;
+        uint8_t index = (row[bit / 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1);
+        if (index >= colors) index = 0;
+        p[0] = palette[index*4 + 2];
+        p[1] = palette[index*4 + 1];
+        p[2] = palette[index*4 + 0];
+      } else {
+        const uint8_t* s = row + x * depth / 8;
+        p[0] = s[2];
+        p[1] = s[1];
+        p[2] = s[0];
+      }
+      p[3] = 255;
+    }
+  }
+  return true;
+}
+
+/******************************************************************************
+    PNG - with a small inflate implementation
+******************************************************************************/
+
+/* Bit reader for deflate streams, LSB first */
+struct BitReader {
+  const uint8_t* data;
+  size_t size, pos = 0;
+  uint32_t bitBuf = 0;
+  int bitCount = 0;
+  bool error = false;
+
+  int bits(int n) {
+    while (bitCount < n) {
+      if (pos >= size) { error = true; return 0; }
+      bitBuf |= (uint32_t) data[pos++] << bitCount;
+      bitCount += 8;
+    }
+    int v = bitBuf & ((1u << n) - 1);
+    bitBuf >>= n;
+    bitCount -= n;
+    return v;
+  }
+};
+
+/* Canonical Huffman code */
+struct Huffman {
+  uint16_t counts[16];
+  uint16_t symbols[288];
+
+  void build(const uint8_t* lengths, int n) {
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < n; i++) counts[lengths[i]]++;
+    counts[0] = 0;
+    uint16_t offs[16];
+    offs[1] = 0;
+    for (int i = 1; i < 15; i++) offs[i+1] = offs[i] + counts[i];
+    for (int i = 0; i < n; i++) {
+      if (lengths[i]) symbols[offs[lengths[i]]++] = i;
+    }
+  }
+
+  int decode(BitReader& br) const {
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len < 16; len++) {
+      code |= br.bits(1);
+      int count = counts[len];
+      if (code - first < count) return symbols[index + code - first];
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+      if (br.error) return -1;
+    }
+    return -1;
+  }
+};
+
+static const uint16_t LEN_BASE[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17,
+  19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LEN_EXTRA[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2,
+  2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49,
+  65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+  8193, 12289, 16385, 24577};
+static const uint8_t DIST_EXTRA[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5,
+  6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// ____________________________________________________________________________
+static bool inflateBlock(BitReader& br, const Huffman& lit, const Huffman& dist,
+                         std::vector<uint8_t>* out) {
+  for (;;) {
+    int sym = lit.decode(br);
+    if (sym < 0) return false;
+    if (sym < 256) {
+      out->push_back(sym);
+    } else if (sym == 256) {
+      return true;
+    } else {
+      sym -= 257;
+      if (sym >= 29) return false;
+      int len = LEN_BASE[sym] + br.bits(LEN_EXTRA[sym]);
+      int ds = dist.decode(br);
+      if (ds < 0 || ds >= 30) return false;
+      size_t d = DIST_BASE[ds] + br.bits(DIST_EXTRA[ds]);
+      if (d > out->size()) return false;
+      for (int i = 0; i < len; i++) out->push_back((*out)[out->size() - d]);
+    }
+    if (br.error) return false;
+  }
+}
+
+// ____________________________________________________________________________
+// inflate a zlib stream
+static bool inflate(const std::vector<uint8_t>& in, std::vector<uint8_t>* out) {
+  if (in.size() < 2 || (in[0] & 0x0F) != 8) return false;
+  BitReader br;
+  br.data = in.data() + 2;    // skip zlib header
+  br.size = in.size() - 2;
+  int last;
+  do {
+    last = br.bits(1);
+    int type = br.bits(2);
+    if (type == 0) {
+      // stored block, starts at byte boundary
+      br.bitBuf = 0;
+      br.bitCount = 0;
+      if (br.pos + 4 > br.size) return false;
+      uint16_t len = le16(br.data + br.pos);
+      br.pos += 4;
+      if (br.pos + len > br.size) return false;
+      out->insert(out->end(), br.data + br.pos, br.data + br.pos + len);
+      br.pos += len;
+    } else if (type == 1) {
+      // fixed Huffman codes
+      uint8_t lengths[288];
+      for (int i = 0; i < 144; i++) lengths[i] = 8;
+      for (int i = 144; i < 256; i++) lengths[i] = 9;
+      for (int i = 256; i < 280; i++) lengths[i] = 7;
+      for (int i = 280; i < 288; i++) lengths[i] = 8;
+      Huffman lit, dist;
+      lit.build(lengths, 288);
+      for (int i = 0; i < 30; i++) lengths[i] = 5;
+      dist.build(lengths, 30);
+      if (!inflateBlock(br, lit, dist, out)) return false;
+    } else if (type == 2) {
+      // dynamic Huffman codes
+      static const uint8_t ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11,
+                                        4, 12, 3, 13, 2, 14, 1, 15};
+      int hlit = br.bits(5) + 257, hdist = br.bits(5) + 1;
+      int hclen = br.bits(4) + 4;
+      uint8_t lengths[320] = {0};
+      for (int i = 0; i < hclen; i++) lengths[ORDER[i]] = br.bits(3);
+      Huffman code;
+      code.build(lengths, 19);
+      memset(lengths, 0, sizeof(lengths));
+      int n = 0;
+      while (n < hlit + hdist) {
+        int sym = code.decode(br);
+        if (sym < 0) return false;
+        if (sym < 16) {
+          lengths[n++] = sym;
+        } else {
+          int repeat, value = 0;
+          if (sym == 16) {
+            if (n == 0) return false;
+            value = lengths[n-1];
+            repeat = 3 + br.bits(2);
+          } else if (sym == 17) {
+            repeat = 3 + br.bits(3);
+          } else {
+            repeat = 11 + br.bits(7);
+          }
+          if (n + repeat > hlit + hdist) return false;
+          while (repeat--) lengths[n++] = value;
+        }
+      }
+      Huffman lit, dist;
+      lit.build(lengths, hlit);
+      dist.build(lengths + hlit, hdist);
+      if (!inflateBlock(br, lit, dist, out)) return false;
+    } else {
+      return false;
+    }
+    if (br.error) return false;
+  } while (!last);
+  return true;
+}
+
+// ____________________________________________________________________________
+static int paeth(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return a;
+  if (pb <= pc) return b;
+  return c;
+}
+
+// ____________________________________________________________________________
+static bool loadPng(const std::vector<uint8_t>& d, Image* img) {
+  static const uint8_t SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+  if (d.size() < 8 || memcmp(d.data(), SIGNATURE, 8) != 0) return false;
+  int w = 0, h = 0, depth = 0, type = 0, interlace = 0;
+  std::vector<uint8_t> idat, palette, alpha;
+  size_t pos = 8;
+  while (pos + 8 <= d.size()) {
+    uint32_t len = be32(&d[pos]);
+    const uint8_t* tag = &d[pos + 4];
+    const uint8_t* data = &d[pos + 8];
+    if (pos + 12 + len > d.size()) return false;
+    if (!memcmp(tag, "IHDR", 4)) {
+      w = be32(data);
+      h = be32(data + 4);
+      depth = data[8];
+      type = data[9];
+      interlace = data[12];
+    } else if (!memcmp(tag, "PLTE", 4)) {
+      palette.assign(data, data + len);
+    } else if (!memcmp(tag, "tRNS", 4)) {
+      alpha.assign(data, data + len);
+    } else if (!memcmp(tag, "IDAT", 4)) {
+      idat.insert(idat.end(), data, data + len);
+    } else if (!memcmp(tag, "IEND", 4)) {
+      break;
+    }
+    pos += 12 + len;
+  }
+  if (interlace) {
+    fprintf(stderr, "interlaced PNG files are not supported\n");
+    return false;
+  }
+  static const int CHANNELS[7] = {1, 0, 3, 1, 2, 0, 4};
+  if (type > 6 || CHANNELS[type] == 0
+      || (type == 3 ? depth > 8 : depth != 8)) {
+    fprintf(stderr, "PNG color type %d with depth %d is not supported\n",
+            type, depth);
+    return false;
+  }
+  std::vector<uint8_t> raw;
+  if (!inflate(idat, &raw)) {
+    fprintf(stderr, "corrupt PNG image data\n");
+    return false;
+  }
+  int bpp = (CHANNELS[type] * depth + 7) / 8;   // bytes per pixel for filters
+  size_t stride = (w * CHANNELS[type] * depth + 7) / 8;
+  if (raw.size() < (stride + 1) * h) return false;
+
+  // undo the filters row by row
+  std::vector<uint8_t> prev(stride, 0), cur(stride);
+  img->width = w;
+  img->height = h;
+  img->rgba.resize(w * h * 4);
+  for (int y = 0; y < h; y++) {
+    const uint8_t* src = &raw[y * (stride + 1)];
+    int filter = src[0];
+    for (size_t i = 0; i < stride; i++) {
+      int a = i >= (size_t) bpp ? cur[i - bpp] : 0;
+      int b = prev[i];
+      int c = i >= (size_t) bpp ? prev[i - bpp] : 0;
+      int x = src[i + 1];
+      switch (filter) {
+        case 1: x += a; break;
+        case 2: x += b; break;
+        case 3: x += (a + b) / 2; break;
+        case 4: x += paeth(a, b, c); break;
+      }
+      cur[i] = x;
+    }
+    for (int x = 0; x < w; x++) {
+      uint8_t* p = &img->rgba[(y*w + x) * 4];
+      const uint8_t* s = &cur[x * CHANNELS[type]];
+      switch (type) {
+        case 0: p[0] = p[1] = p[2] = s[0]; p[3] = 255; break;
+        case 2: p[0] = s[0]; p[1] = s[1]; p[2] = s[2]; p[3] = 255; break;
+        case 4: p[0] = p[1] = p[2] = s[0]; p[3] = s[1]; break;
+        case 6: memcpy(p, s, 4); break;
+        case 3: {
+          int bit = x * depth;
+          int index = (cur[bit / 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1);
+          if ((size_t) index * 3 + 2 >= palette.size()) index = 0;
+          p[0] = palette[index*3];
+          p[1] = palette[index*3 + 1];
+          p[2] = palette[index*3 + 2];
+          p[3] = (size_t) index < alpha.size() ? alpha[index] : 255;
+          break;
+        }
+      }
+    }
+    prev.swap(cur);
+  }
+  return true;
+}
+
+/******************************************************************************
+    Output
+******************************************************************************/
+
+// ____________________________________________________________________________
+// convert 8 bit components to RGB565 the same way as color565() does
+static uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+// ____________________________________________________________________________
+static void putPixel(std::vector<uint8_t>* out, uint16_t c) {
+  out->push_back(c >> 8);     // big endian, as sent to the display
+  out->push_back(c & 0xFF);
+}
+
+// ____________________________________________________________________________
+// run length encode one row into packets of at most 128 pixels
+static void encodeRow(const uint16_t* row, int w, std::vector<uint8_t>* out) {
+  int x = 0;
+  while (x < w) {
+    int run = 1;
+    while (x + run < w && run < 128 && row[x + run] == row[x]) run++;
+    if (run >= 2) {
+      out->push_back(0x80 | (run - 1));
+      putPixel(out, row[x]);
+      x += run;
+    } else {
+      // collect literals until the next run of at least 2 pixels
+      int n = 1;
+      while (x + n < w && n < 128
+             && !(x + n + 1 < w && row[x + n] == row[x + n + 1])) {
+        n++;
+      }
+      out->push_back(n - 1);
+      for (int i = 0; i < n; i++) putPixel(out, row[x + i]);
+      x += n;
+    }
+  }
+}
+
+// ____________________________________________________________________________
+int main(int argc, char** argv) {
+  bool rle = false;
+  uint32_t background = 0xFFFFFF;
+  int arg = 1;
+  for (; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (!strcmp(argv[arg], "-r")) {
+      rle = true;
+    } else if (!strcmp(argv[arg], "-b") && arg + 1 < argc) {
+      background = strtoul(argv[++arg], NULL, 16);
+    } else {
+      arg = argc;   // force usage message
+    }
+  }
+  if (argc - arg != 2) {
+    fprintf(stderr, "usage: %s [-r] [-b RRGGBB] input.bmp|input.png "
+                    "output.565\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<uint8_t> data;
+  Image img;
+  if (!readFile(argv[arg], &data)) {
+    fprintf(stderr, "cannot read %s\n", argv[arg]);
+    return 1;
+  }
+  if (!loadBmp(data, &img) && !loadPng(data, &img)) {
+    fprintf(stderr, "%s is no supported BMP or PNG file\n", argv[arg]);
+    return 1;
+  }
+  if (img.width > 0xFFFF || img.height > 0xFFFF) {
+    fprintf(stderr, "image too large\n");
+    return 1;
+  }
+
+  // header
+  std::vector<uint8_t> out = {'R', '5', '6', '5',
+    (uint8_t) img.width, (uint8_t) (img.width >> 8),
+    (uint8_t) img.height, (uint8_t) (img.height >> 8),
+    (uint8_t) (rle ? 1 : 0), 0, 0, 0};
+
+  // rows, blended onto the background color
+  std::vector<uint16_t> row(img.width);
+  for (int y = 0; y < img.height; y++) {
+    for (int x = 0; x < img.width; x++) {
+      const uint8_t* p = &img.rgba[(y*img.width + x) * 4];
+      uint8_t c[3];
+      for (int i = 0; i < 3; i++) {
+        int bg = (background >> (16 - 8*i)) & 0xFF;
+        c[i] = (p[i] * p[3] + bg * (255 - p[3]) + 127) / 255;
+      }
+      row[x] = rgb565(c[0], c[1], c[2]);
+    }
+    if (rle) {
+      encodeRow(row.data(), img.width, &out);
+    } else {
+      for (int x = 0; x < img.width; x++) putPixel(&out, row[x]);
+    }
+  }
+
+  FILE* f = fopen(argv[arg + 1], "wb");
+  if (!f || fwrite(out.data(), 1, out.size(), f) != out.size()) {
+    fprintf(stderr, "cannot write %s\n", argv[arg + 1]);
+    return 1;
+  }
+  fclose(f);
+  printf("%s: %dx%d, %zu bytes (%zu bytes input)\n", argv[arg + 1],
+         img.width, img.height, out.size(), data.size());
+  return 0;
+}